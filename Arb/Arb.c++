@@ -6,7 +6,11 @@
 
 // STL includes.
   #include <string>
+  #include <vector>
   #include <algorithm>
+  #include <atomic>
+  #include <mutex>
+  #include <cstdint>
 
 // System includes.
   #include <rppower.h++>
@@ -14,6 +18,7 @@
   #include <reduce.h++>
   #include <CaseConvert.h++>
   #include <NumInfo.h++>
+  #include <OpCounters.h++>
 
 // Class include.
   #include "Arb.h++"
@@ -42,6 +47,11 @@ namespace DAC {
   template <> unsigned int const Arb::_FloatInfo<long double>::exponentbits =    15;
   template <> unsigned int const Arb::_FloatInfo<long double>::bias         = 16383;
   
+  /***************************************************************************/
+  // Data members.
+  
+  size_t Arb::reduce_threshold = 256;
+  
   /***************************************************************************/
   // Function members.
   
@@ -68,6 +78,37 @@ namespace DAC {
     
   }
   
+  /*
+   * Move constructor.
+   */
+  Arb::Arb (Arb&& number) {
+    
+    // Call common init.
+    _init();
+    
+    // Take the number, leave 0 behind.
+    _p.swap(number._p);
+    _q.swap(number._q);
+    
+    // Copy the rest.
+    _fixq             = number._fixq     ;
+    _unreduced        = number._unreduced.load();
+    _pointpos         = number._pointpos ;
+    _fix              = number._fix      ;
+    _fixtype          = number._fixtype  ;
+    _base             = number._base     ;
+    _maxradix         = number._maxradix ;
+    _format           = number._format   ;
+    _round            = number._round    ;
+    number._unreduced = false            ;
+    
+    // A fixed number's 0 is still over its denominator.
+    if (number._fix) {
+      number._reduce();
+    }
+    
+  }
+  
   /*
    * Conversion constructor.
    */
@@ -106,7 +147,7 @@ namespace DAC {
     if (base != _base) {
       _base = base;
       if (_fix && _fixtype == FIX_RADIX) {
-        _fixq = UArbInt(_base).pow(_pointpos);
+        _fixq = UArbInt().setBasePow(_base, _pointpos);
         _reduce();
       }
     }
@@ -116,7 +157,7 @@ namespace DAC {
     if (pointpos != _pointpos) {
       _pointpos = pointpos;
       if (_fix && _fixtype == FIX_RADIX) {
-        _fixq = UArbInt(_base).pow(_pointpos);
+        _fixq = UArbInt().setBasePow(_base, _pointpos);
         _reduce();
       }
     }
@@ -126,7 +167,7 @@ namespace DAC {
     if (fixed != _fix) {
       _fix = fixed;
       if (_fix && _fixtype == FIX_RADIX) {
-        _fixq = UArbInt(_base).pow(_pointpos);
+        _fixq = UArbInt().setBasePow(_base, _pointpos);
       }
       _reduce();
     }
@@ -174,13 +215,14 @@ namespace DAC {
     _p   .swap(new_p   );
     _q   .swap(new_q   );
     _fixq.swap(new_fixq);
-    _pointpos =          0;
-    _fix      = false     ;
-    _fixtype  = FIX_RADIX ;
-    _base     =         10;
-    _maxradix =         10;
-    _format   = FMT_RADIX ;
-    _round    = ROUND_EVEN;
+    _unreduced = false     ;
+    _pointpos  =          0;
+    _fix       = false     ;
+    _fixtype   = FIX_RADIX ;
+    _base      =         10;
+    _maxradix  =         10;
+    _format    = FMT_RADIX ;
+    _round     = ROUND_EVEN;
     
   }
   
@@ -189,22 +231,25 @@ namespace DAC {
    */
   void Arb::copy (Arb const& number) {
     
-    // Operations that may throw, but do not change the number.
-    ArbInt  new_p   (number._p   );
-    UArbInt new_q   (number._q   );
-    UArbInt new_fixq(number._fixq);
+    // Operations that may throw, but do not change the number. A reduction
+    // that is owed comes along with the fraction.
+    ArbInt     new_p        ;
+    UArbInt    new_q        ;
+    UArbInt    new_fixq     (number._fixq);
+    bool const new_unreduced = number._getFraction(new_p, new_q);
     
     // Operations that never throw.
     _p   .swap(new_p   );
     _q   .swap(new_q   );
     _fixq.swap(new_fixq);
-    _pointpos = number._pointpos;
-    _fix      = number._fix     ;
-    _fixtype  = number._fixtype ;
-    _base     = number._base    ;
-    _maxradix = number._maxradix;
-    _format   = number._format  ;
-    _round    = number._round   ;
+    _unreduced.store(new_unreduced, std::memory_order_relaxed);
+    _pointpos  = number._pointpos ;
+    _fix       = number._fix      ;
+    _fixtype   = number._fixtype  ;
+    _base      = number._base     ;
+    _maxradix  = number._maxradix ;
+    _format    = number._format   ;
+    _round     = number._round    ;
     
   }
   
@@ -216,6 +261,9 @@ namespace DAC {
     // This is the string we will be returning.
     string retval;
     
+    // Output is always in lowest terms.
+    _settle();
+    
     // Determine the output format.
     OutputFormat fmt = (format == FMT_DEFAULT) ? _format : format;
     
@@ -246,33 +294,40 @@ namespace DAC {
         UArbInt remainder(_p.abs_UArbInt() % _q);
         if ((_fix && _fixq != 1) || (!_fix && remainder)) {
           
-          // Get the radix digits, one by one. Output digits until the entire
-          // fraction is output or the maximum requested significant radix digits
-          // are output.
-          std::string::size_type sigdigs  = 0;
-          bool                   sigstart = (numeric != 0);
-          UArbInt                digit;
-          while ((sigdigs < _maxradix) && (remainder != 0)) {
-            
-            // Push one base digit to a whole number.
-            remainder *= _base;
-            digit      = remainder / _q;
-            
-            // Push that digit onto the end of the number we are constructing
-            // and increment the number of radix positions.
-            numeric.push_back(digit);
-            ++radixpos;
+          // Get the radix digits in one division. Output digits until the
+          // entire fraction is output or the maximum requested significant
+          // radix digits are output. Leading 0s are not significant, so if
+          // there is no whole number part, scale far enough past them.
+          if (_maxradix && remainder != 0) {
             
-            // Remove that digit from the remainder.
-            remainder %= _q;
+            // Find how many digits to scale the remainder up by.
+            std::string::size_type           places = _maxradix;
+            UArbInt                          digits;
+            UArbInt                          scaled;
+            std::vector<UArbInt::value_type> sigdigs;
+            while (true) {
+              (remainder * UArbInt().setBasePow(_base, places)).divmod(_q, digits, scaled);
+              if (numeric != 0 || digits.getDigits(sigdigs, _base).size() == _maxradix) {
+                break;
+              }
+              places = sigdigs.empty() ? places << 1 : places - sigdigs.size() + _maxradix;
+            }
             
-            // Start incrementing significant digits when we actually hit one,
-            // do not count 0s.
-            if (sigstart || (digit != 0)) {
-              ++sigdigs;
-              sigstart = true;
+            // A fraction that comes out exactly stops at its last nonzero
+            // digit.
+            if (scaled == 0) {
+              std::string::size_type zeros = 0;
+              for (digits.getDigits(sigdigs, _base); sigdigs[zeros] == 0; ++zeros) {}
+              digits /= UArbInt().setBasePow(_base, zeros);
+              places -= zeros;
             }
             
+            // Push the digits onto the end of the number we are constructing.
+            numeric   *= UArbInt().setBasePow(_base, places);
+            numeric   += digits;
+            radixpos   = places;
+            remainder  = scaled;
+            
           }
           
           // Round.
@@ -316,7 +371,7 @@ namespace DAC {
           
             // Pad with zeros.
             if (radixpos < _pointpos) {
-              numeric  *= UArbInt(_base).pow(_pointpos - radixpos);
+              numeric  *= UArbInt().setBasePow(_base, _pointpos - radixpos);
               radixpos  = _pointpos;
             }
             
@@ -360,7 +415,7 @@ namespace DAC {
       
       // Output in fractional format.
       case FMT_FRACTION: {
-        retval = _p.to_string(_base) + "/" + _q.to_string(_base);
+        retval = _p.abs_UArbInt().to_string(_base) + "/" + _q.to_string(_base);
       } break;
       
     }
@@ -562,7 +617,7 @@ namespace DAC {
         // This calculation will be needed whether exponent is positive or
         // negative. If positive, multiply p by it and clear, thus bringing p
         // down to 1s. If negative, leave as it is, it is already accurate.
-        _q = UArbInt(num_base).pow(expn);
+        _q.setBasePow(num_base, expn.Value<size_t>());
         if (p_exp) {
           _p   *= _q;
           _q    = 1;
@@ -585,18 +640,18 @@ namespace DAC {
           // If the exponent is positive, it is a simple case of increasing the
           // number of radix digits, this is a number represented by 1s by now.
           if (p_exp) {
-            _q  = UArbInt(_base).pow(UArbInt(_pointpos));
+            _q.setBasePow(_base, _pointpos);
             _p *= _q;
           
           // If the exponent is negative, we must add or subtract the difference
           // in digits.
           } else {
             if (UArbInt(_pointpos) >= expn) {
-              UArbInt mod(UArbInt(_base).pow(UArbInt(_pointpos) - expn));
+              UArbInt mod(UArbInt().setBasePow(_base, (UArbInt(_pointpos) - expn).Value<size_t>()));
               _p *= mod;
               _q *= mod;
             } else {
-              UArbInt mod(UArbInt(_base).pow(expn - UArbInt(_pointpos)));
+              UArbInt mod(UArbInt().setBasePow(_base, (expn - UArbInt(_pointpos)).Value<size_t>()));
               _p /= mod;
               _q /= mod;
             }
@@ -626,9 +681,13 @@ namespace DAC {
    */
   void Arb::set (Arb const& number) {
     
-    // Set the new number.
-    _p = number._p;
-    _q = number._q;
+    // Set the new number, reduced or not as in copy().
+    ArbInt     new_p;
+    UArbInt    new_q;
+    bool const new_unreduced = number._getFraction(new_p, new_q);
+    _p.swap(new_p);
+    _q.swap(new_q);
+    _unreduced.store(new_unreduced, std::memory_order_relaxed);
     
     // Reduce the fraction if setting from a fixed number or if this is a
     // fixed number, should be no need otherwise.
@@ -639,14 +698,43 @@ namespace DAC {
     
   }
   
+  /*
+   * Take the value of another Arb.
+   */
+  void Arb::set (Arb&& number) {
+    
+    // Only work if necessary.
+    if (this == &number) {
+      return;
+    }
+    
+    // Trade numbers.
+    bool const unreduced = _unreduced;
+    _p.swap(number._p);
+    _q.swap(number._q);
+    _unreduced        = number._unreduced.load();
+    number._unreduced = unreduced;
+    
+    // Same as copying from here, and number must stay a valid fixed
+    // number if it is one.
+    if (_fix || number._fix) {
+      _reduce();
+    }
+    if (number._fix) {
+      number._reduce();
+    }
+    
+  }
+  
   /*
    * Set from an ArbInt.
    */
   void Arb::set (ArbInt const& number) {
     
     // Set the number.
-    _p = number;
-    _q = 1;
+    _p         = number;
+    _q         = 1     ;
+    _unreduced = false ;
     
     // Reduce if this is a fixed number, otherwise no need.
     if (_fix) {
@@ -661,8 +749,9 @@ namespace DAC {
   void Arb::set (UArbInt const& number) {
     
     // Set the number.
-    _p = number;
-    _q = 1;
+    _p         = number;
+    _q         = 1     ;
+    _unreduced = false ;
     
     // Reduce if this is a fixed number, otherwise no need.
     if (_fix) {
@@ -677,11 +766,12 @@ namespace DAC {
   Arb& Arb::op_mul (Arb const& number) {
     
     // Multiply the numbers.
+    number._settle();
     _p *= number._p;
     _q *= number._q;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // Done.
     return *this;
@@ -693,7 +783,7 @@ namespace DAC {
     _p *= number;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // Done.
     return *this;
@@ -705,7 +795,7 @@ namespace DAC {
     _p *= number;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // Done.
     return *this;
@@ -722,12 +812,13 @@ namespace DAC {
       throw Errors::DivByZero();
     }
     
-    // Divide the numbers, multiply by the inverse.
+    // Divide the numbers, multiply by the inverse. The comparison above
+    // settled number.
     _p *= number._q;
     _q *= number._p;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // Done.
     return *this;
@@ -747,7 +838,7 @@ namespace DAC {
     }
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // Done.
     return *this;
@@ -764,7 +855,7 @@ namespace DAC {
     _q *= number;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // Done.
     return *this;
@@ -847,7 +938,7 @@ namespace DAC {
     _p += tmp_r._p;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // We done.
     return *this;
@@ -865,7 +956,7 @@ namespace DAC {
     _p += tmp;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // We done.
     return *this;
@@ -883,7 +974,7 @@ namespace DAC {
     _p += tmp;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // We done.
     return *this;
@@ -905,7 +996,7 @@ namespace DAC {
     _p -= tmp_r._p;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // We done.
     return *this;
@@ -923,7 +1014,7 @@ namespace DAC {
     _p -= tmp;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // We done.
     return *this;
@@ -941,7 +1032,7 @@ namespace DAC {
     _p -= tmp;
     
     // Reduce the fraction.
-    _reduce();
+    _lazyreduce();
     
     // We done.
     return *this;
@@ -953,6 +1044,10 @@ namespace DAC {
    */
   int Arb::op_compare (Arb const& number) const {
     
+    // Compare in lowest terms.
+    _settle();
+    number._settle();
+    
     // If one or both numbers are zero, compare is easy.
     if (_p == 0) {
       if (number._p == 0) {
@@ -976,11 +1071,14 @@ namespace DAC {
     Arb tmp_l(*this );
     Arb tmp_r(number);
     tmp_l._normalize(tmp_r);
-    return _p.op_compare(number._p);
+    return tmp_l._p.op_compare(tmp_r._p);
     
   }
   int Arb::op_compare (ArbInt const& number) const {
     
+    // Compare in lowest terms.
+    _settle();
+    
     // If one or both numbers are zero, compare is easy.
     if (_p == 0) {
       if (number == 0) {
@@ -1006,6 +1104,9 @@ namespace DAC {
   }
   int Arb::op_compare (UArbInt const& number) const {
     
+    // Compare in lowest terms.
+    _settle();
+    
     // If one or both numbers are zero, compare is easy.
     if (_p == 0) {
       return (number == 0) ? 0 : -1;
@@ -1143,13 +1244,14 @@ namespace DAC {
         } else {
           
           // x^(y/z): find the raise to the yth power and find the zth root.
-          Arb x;
           Arb y;
           Arb z;
           
-          // Raise to the yth power.
-          y._p = exp._p;
-          x = pow(y);
+          // Raise to the yth power, the sign of exp is handled below. The
+          // power is copied rather than assigned so that it keeps this
+          // number's base and precision, the root is found to these.
+          y._p = exp._p.abs();
+          Arb const x(pow(y));
           
           // Get the zth root.
           z._p = exp._q;
@@ -1187,49 +1289,43 @@ namespace DAC {
     }
     
     // This is a rational number class, not complex.
-    if (!isPositive() && n.isEven()) {
+    if (isNegative() && n.isEven()) {
       throw Arb::Errors::Complex();
     }
     
     // Common work area.
-    Arb retval(1);
+    Arb retval;
     
     // Only find integer roots.
     if (n.isInteger()) {
       
+      // A negative root is the reciprocal of the positive root.
+      if (n < 0) {
+        return 1 / root(-n);
+      }
+      
       // Work area.
-      Arb lastguess;
-      Arb accuracy(Arb(_base).pow(-Arb(_maxradix)));
+      UArbInt const rootn(n._p.abs_UArbInt());
+      UArbInt const absp (_p.abs_UArbInt());
       
-      // Create an initial guess, will be within at least one ^2, so Newton's
-      // algorithm should begin converging by doubling correct # of bits each
-      // iteration.
-      if (abs() > 1) {
-        retval = 2;
-        while (retval.pow(n) < *this) {
-          retval *= 2;
-        }
+      // Find the root to _maxradix digits past the radix point, and if this
+      // number is less than 1, past the leading zeros of the root as well.
+      // In lowest terms the radix digits of q/p give the leading zeros.
+      size_t places = _maxradix;
+      if (absp != 0 && absp < _q) {
+        std::vector<UArbInt::value_type> zeros;
+        places += (_q / absp).getDigits(zeros, _base).size() / rootn.Value<size_t>() + 1;
       }
       
-      Arb precision = retval;
-      
-      // Newton's algorithm. 
-      Arb nmo(n - 1);
-      do {
-        
-        // Save the last guess for comparison and make a new one.
-        lastguess = retval;
-        retval    = (*this / retval.pow(nmo) + nmo * retval) / n;
-        
-        // Restrict to the specified precision for performance. Since we know
-        // that the number of valid bits doubles each time we iterate, this
-        // should be possible to do far more intelligently.
-        if (retval._q > accuracy._q) {
-          retval._forcereduce(accuracy._q);
-        }
-        
-      // Loop until we are within our specified accuracy.
-      } while ((retval - lastguess).abs() >= accuracy);
+      // root(p/q) * B^places == iroot(p * B^(places * n) / q), exactly. Take
+      // one more bit and round it off. All of the precision scheduling
+      // happens in iroot, which only carries the bits each Newton step needs.
+      UArbInt scale(UArbInt().setBasePow(_base, places));
+      retval._p = ((absp * (scale << 1).pow(rootn) / _q).iroot(rootn) + 1) >> 1;
+      retval._q = scale;
+      if (isNegative()) {
+        retval._p *= -1;
+      }
       
       // Always reduce.
       retval._reduce();
@@ -1265,16 +1361,60 @@ namespace DAC {
     // Fixed-point numbers are forced to their dividend.
     if (_fix) {
       _forcereduce(_fixq);
+      _unreduced = false;
       
     // Floating-point numbers are simply reduced.
     } else {
-      UArbInt tmp(_p.abs_UArbInt());
-      reduce(tmp, _q);
-      if (_p < 0) {
-        _p  = tmp;
-        _p *= -1;
-      } else {
-        _p = tmp;
+      _unreduced = true;
+      _settle();
+    }
+    
+    // We done.
+    return *this;
+    
+  }
+  
+  /*
+   * Put off reducing until the number is used or gets too big.
+   */
+  Arb& Arb::_lazyreduce () {
+    
+    // Fixed-point numbers must always be on their dividend, and anything
+    // over the threshold is reduced now.
+    if (_fix || _p.numDigits() >= reduce_threshold || _q.numDigits() >= reduce_threshold) {
+      return _reduce();
+    }
+    
+    // Otherwise just note that the work is owed. Nothing else can be
+    // looking at a number being changed, so no ordering is needed.
+    _unreduced.store(true, std::memory_order_relaxed);
+    
+    // We done.
+    return *this;
+    
+  }
+  
+  /*
+   * Reduce a floating-point number to lowest terms if it has been put off.
+   */
+  Arb const& Arb::_settle () const {
+    
+    // Only work if necessary. Other threads may be reading this number, so
+    // the first to get here settles it under a lock, and the rest see the
+    // result once the flag is clear.
+    if (_unreduced.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(s_settleLock(this));
+      if (_unreduced.load(std::memory_order_relaxed)) {
+        OpCounters::add(OpCounters::REDUCTIONS);
+        UArbInt tmp(_p.abs_UArbInt());
+        reduce(tmp, _q);
+        if (_p < 0) {
+          _p  = tmp;
+          _p *= -1;
+        } else {
+          _p = tmp;
+        }
+        _unreduced.store(false, std::memory_order_release);
       }
     }
     
@@ -1283,6 +1423,35 @@ namespace DAC {
     
   }
   
+  /*
+   * Get the fraction as it is. Another thread may be settling this number,
+   * so one that is owed a reduction is read under its lock.
+   */
+  bool Arb::_getFraction (ArbInt& p, UArbInt& q) const {
+    
+    // Settled numbers are never written again by readers.
+    if (!_unreduced.load(std::memory_order_acquire)) {
+      p = _p;
+      q = _q;
+      return false;
+    }
+    
+    // Copy whatever state the lock finds it in.
+    std::lock_guard<std::mutex> lock(s_settleLock(this));
+    p = _p;
+    q = _q;
+    return _unreduced.load(std::memory_order_relaxed);
+    
+  }
+  
+  /*
+   * The lock that settles a number, one of a fixed set picked by address.
+   */
+  std::mutex& Arb::s_settleLock (Arb const* const number) {
+    static std::mutex locks[64];
+    return locks[(reinterpret_cast<std::uintptr_t>(number) / sizeof(Arb)) % 64];
+  }
+  
   /*
    * Bitwise shift this number.
    */
@@ -1363,6 +1532,7 @@ namespace DAC {
     
     // Only work if we have to.
     if (_q != q) {
+      OpCounters::add(OpCounters::REDUCTIONS);
       
       //  p       x
       // --- == ------
@@ -1436,6 +1606,17 @@ namespace DAC {
     // Only work if necessary.
     if (_q != number._q) {
       
+      // If either number is waiting to be reduced anyway, skip the GCD and
+      // just cross-multiply, the result will be reduced later.
+      if (_unreduced || number._unreduced) {
+        UArbInt tmp_q(_q);
+        _p        *= number._q;
+        number._p *= tmp_q;
+        _q        *= number._q;
+        number._q  = _q;
+        return *this;
+      }
+      
       // Raise each number's q to their LCM, bring p along.
       UArbInt qgcd(gcd(_q, number._q));
       UArbInt qlcm((_q / qgcd) * number._q);
@@ -13,6 +13,8 @@
   #include <sstream>
   #include <string>
   #include <limits>
+  #include <atomic>
+  #include <mutex>
 
 // System includes.
   #include <SafeInt.h++>
@@ -27,7 +29,13 @@ namespace DAC {
   /*************************************************************************
    * Arb
    *************************************************************************
-   * This is an arbitrary precision number class.
+   * This is an arbitrary precision number class. Like the standard
+   * containers, a number may be read from any number of threads at once,
+   * but not read while it is being changed. Reading may bring a number to
+   * lowest terms, which is done under a lock and only once, and copying
+   * takes the fraction as it is under the same lock. The exception
+   * is to_string() without a buffer, which writes the number's own buffer,
+   * threads should pass their own.
    *************************************************************************/
   class Arb {
     
@@ -74,6 +82,16 @@ namespace DAC {
         FIX_DENOM
       };
       
+      /***********************************************************************/
+      // Tuning.
+      
+      // Arithmetic leaves a fraction out of lowest terms until it is
+      // compared or output, or until its numerator or denominator reaches
+      // this many digits, so that a run of operations pays for one
+      // reduction instead of one each. Fixed-point numbers are always
+      // reduced. 0 reduces after every operation.
+      static size_t reduce_threshold;
+      
       /***********************************************************************/
       // Errors.
       class Errors {
@@ -143,8 +161,10 @@ namespace DAC {
       // Default constructor.
       Arb ();
       
-      // Copy constructor.
+      // Copy and move constructors. A moved-from number is 0 with its
+      // properties intact.
       Arb (Arb const& number);
+      Arb (Arb&&      number);
       
       // Conversion constructor.
                          explicit Arb (std::string const& number);
@@ -180,6 +200,7 @@ namespace DAC {
       
       // Assignment operator.
                          Arb& operator = (Arb         const& number);
+                         Arb& operator = (Arb&&              number);
                          Arb& operator = (std::string const& number);
                          Arb& operator = (ArbInt      const& number);
                          Arb& operator = (UArbInt     const& number);
@@ -214,6 +235,7 @@ namespace DAC {
       // Set the number.
                          void set (std::string const& number, bool const autobase = true);
                          void set (Arb         const& number                            );
+                         void set (Arb&&              number                            );
                          void set (ArbInt      const& number                            );
                          void set (UArbInt     const& number                            );
       template <class T> void set (SafeInt<T>  const  number                            );
@@ -488,9 +510,13 @@ namespace DAC {
       /*********************************************************************/
       // Data members.
       
-      // The number itself.
-      ArbInt  _p; // Numerator.
-      UArbInt _q; // Denominator.
+      // The number itself. Reducing to lowest terms does not change the
+      // value, so it is allowed on a const number. Const readers settle the
+      // number before looking at p or q, and once _unreduced is clear they
+      // are not written again.
+      mutable ArbInt            _p        ; // Numerator.
+      mutable UArbInt           _q        ; // Denominator.
+      mutable std::atomic<bool> _unreduced; // If true, p/q may not be in lowest terms.
       
       // Number properties.
       UArbInt                _fixq    ; // Fixed denominator.
@@ -518,9 +544,20 @@ namespace DAC {
       template <class T> Arb& _shift (SafeInt<T> const  bits, _Dir const dir);
       template <class T> Arb& _shift (T          const  bits, _Dir const dir);
       
-      // Reduce the number to its most compact representation.
-      Arb& _reduce      ();
-      Arb& _forcereduce (UArbInt const& q);
+      // Reduce the number to its most compact representation, now, when it
+      // gets too big, or if it was put off.
+      Arb&       _reduce      ();
+      Arb&       _lazyreduce  ();
+      Arb const& _settle      () const;
+      
+      // Get the fraction as it is, reduced or not, and return whether it is
+      // still owed a reduction.
+      bool _getFraction (ArbInt& p, UArbInt& q) const;
+      
+      // The lock that settles a number. Locks are shared by numbers, so a
+      // lock is only held while settling.
+      static std::mutex& s_settleLock (Arb const* const number);
+      Arb&       _forcereduce (UArbInt const& q);
       
       // Normalize this number to another number.
       Arb& _normalize (Arb& number);
@@ -545,69 +582,118 @@ namespace DAC {
   
   // Arithmetic operators.
                      Arb operator * (Arb        const& l, Arb        const& r);
+                     Arb operator * (Arb&&             l, Arb        const& r);
                      Arb operator * (Arb        const& l, ArbInt     const& r);
+                     Arb operator * (Arb&&             l, ArbInt     const& r);
                      Arb operator * (Arb        const& l, UArbInt    const& r);
+                     Arb operator * (Arb&&             l, UArbInt    const& r);
                      Arb operator * (ArbInt     const& l, Arb        const& r);
+                     Arb operator * (ArbInt&&          l, Arb        const& r);
                      Arb operator * (UArbInt    const& l, Arb        const& r);
+                     Arb operator * (UArbInt&&         l, Arb        const& r);
   template <class T> Arb operator * (Arb        const& l, SafeInt<T> const  r);
+  template <class T> Arb operator * (Arb&&             l, SafeInt<T> const  r);
   template <class T> Arb operator * (SafeInt<T> const  l, Arb        const& r);
   template <class T> Arb operator * (Arb        const& l, T          const  r);
+  template <class T> Arb operator * (Arb&&             l, T          const  r);
   template <class T> Arb operator * (T          const  l, Arb        const& r);
                      Arb operator / (Arb        const& l, Arb        const& r);
+                     Arb operator / (Arb&&             l, Arb        const& r);
                      Arb operator / (Arb        const& l, ArbInt     const& r);
+                     Arb operator / (Arb&&             l, ArbInt     const& r);
                      Arb operator / (Arb        const& l, UArbInt    const& r);
+                     Arb operator / (Arb&&             l, UArbInt    const& r);
                      Arb operator / (ArbInt     const& l, Arb        const& r);
+                     Arb operator / (ArbInt&&          l, Arb        const& r);
                      Arb operator / (UArbInt    const& l, Arb        const& r);
+                     Arb operator / (UArbInt&&         l, Arb        const& r);
   template <class T> Arb operator / (Arb        const& l, SafeInt<T> const  r);
+  template <class T> Arb operator / (Arb&&             l, SafeInt<T> const  r);
   template <class T> Arb operator / (SafeInt<T> const  l, Arb        const& r);
   template <class T> Arb operator / (Arb        const& l, T          const  r);
+  template <class T> Arb operator / (Arb&&             l, T          const  r);
   template <class T> Arb operator / (T          const  l, Arb        const& r);
                      Arb operator % (Arb        const& l, Arb        const& r);
+                     Arb operator % (Arb&&             l, Arb        const& r);
                      Arb operator % (Arb        const& l, ArbInt     const& r);
+                     Arb operator % (Arb&&             l, ArbInt     const& r);
                      Arb operator % (Arb        const& l, UArbInt    const& r);
+                     Arb operator % (Arb&&             l, UArbInt    const& r);
                      Arb operator % (ArbInt     const& l, Arb        const& r);
+                     Arb operator % (ArbInt&&          l, Arb        const& r);
                      Arb operator % (UArbInt    const& l, Arb        const& r);
+                     Arb operator % (UArbInt&&         l, Arb        const& r);
   template <class T> Arb operator % (Arb        const& l, SafeInt<T> const  r);
+  template <class T> Arb operator % (Arb&&             l, SafeInt<T> const  r);
   template <class T> Arb operator % (SafeInt<T> const  l, Arb        const& r);
   template <class T> Arb operator % (Arb        const& l, T          const  r);
+  template <class T> Arb operator % (Arb&&             l, T          const  r);
   template <class T> Arb operator % (T          const  l, Arb        const& r);
                      Arb operator + (Arb        const& l, Arb        const& r);
+                     Arb operator + (Arb&&             l, Arb        const& r);
                      Arb operator + (Arb        const& l, ArbInt     const& r);
+                     Arb operator + (Arb&&             l, ArbInt     const& r);
                      Arb operator + (Arb        const& l, UArbInt    const& r);
+                     Arb operator + (Arb&&             l, UArbInt    const& r);
                      Arb operator + (ArbInt     const& l, Arb        const& r);
+                     Arb operator + (ArbInt&&          l, Arb        const& r);
                      Arb operator + (UArbInt    const& l, Arb        const& r);
+                     Arb operator + (UArbInt&&         l, Arb        const& r);
   template <class T> Arb operator + (Arb        const& l, SafeInt<T> const  r);
+  template <class T> Arb operator + (Arb&&             l, SafeInt<T> const  r);
   template <class T> Arb operator + (SafeInt<T> const  l, Arb        const& r);
   template <class T> Arb operator + (Arb        const& l, T          const  r);
+  template <class T> Arb operator + (Arb&&             l, T          const  r);
   template <class T> Arb operator + (T          const  l, Arb        const& r);
                      Arb operator - (Arb        const& l, Arb        const& r);
+                     Arb operator - (Arb&&             l, Arb        const& r);
                      Arb operator - (Arb        const& l, ArbInt     const& r);
+                     Arb operator - (Arb&&             l, ArbInt     const& r);
                      Arb operator - (Arb        const& l, UArbInt    const& r);
+                     Arb operator - (Arb&&             l, UArbInt    const& r);
                      Arb operator - (ArbInt     const& l, Arb        const& r);
+                     Arb operator - (ArbInt&&          l, Arb        const& r);
                      Arb operator - (UArbInt    const& l, Arb        const& r);
+                     Arb operator - (UArbInt&&         l, Arb        const& r);
   template <class T> Arb operator - (Arb        const& l, SafeInt<T> const  r);
+  template <class T> Arb operator - (Arb&&             l, SafeInt<T> const  r);
   template <class T> Arb operator - (SafeInt<T> const  l, Arb        const& r);
   template <class T> Arb operator - (Arb        const& l, T          const  r);
+  template <class T> Arb operator - (Arb&&             l, T          const  r);
   template <class T> Arb operator - (T          const  l, Arb        const& r);
   
   // Bit shift operators.
                      Arb operator << (Arb        const& l, Arb        const& r);
+                     Arb operator << (Arb&&             l, Arb        const& r);
                      Arb operator << (Arb        const& l, ArbInt     const& r);
+                     Arb operator << (Arb&&             l, ArbInt     const& r);
                      Arb operator << (Arb        const& l, UArbInt    const& r);
+                     Arb operator << (Arb&&             l, UArbInt    const& r);
                      Arb operator << (ArbInt     const& l, Arb        const& r);
+                     Arb operator << (ArbInt&&          l, Arb        const& r);
                      Arb operator << (UArbInt    const& l, Arb        const& r);
+                     Arb operator << (UArbInt&&         l, Arb        const& r);
   template <class T> Arb operator << (Arb        const& l, SafeInt<T> const  r);
+  template <class T> Arb operator << (Arb&&             l, SafeInt<T> const  r);
   template <class T> Arb operator << (SafeInt<T> const  l, Arb        const& r);
   template <class T> Arb operator << (Arb        const& l, T          const  r);
+  template <class T> Arb operator << (Arb&&             l, T          const  r);
   template <class T> Arb operator << (T          const  l, Arb        const& r);
                      Arb operator >> (Arb        const& l, Arb        const& r);
+                     Arb operator >> (Arb&&             l, Arb        const& r);
                      Arb operator >> (Arb        const& l, ArbInt     const& r);
+                     Arb operator >> (Arb&&             l, ArbInt     const& r);
                      Arb operator >> (Arb        const& l, UArbInt    const& r);
+                     Arb operator >> (Arb&&             l, UArbInt    const& r);
                      Arb operator >> (ArbInt     const& l, Arb        const& r);
+                     Arb operator >> (ArbInt&&          l, Arb        const& r);
                      Arb operator >> (UArbInt    const& l, Arb        const& r);
+                     Arb operator >> (UArbInt&&         l, Arb        const& r);
   template <class T> Arb operator >> (Arb        const& l, SafeInt<T> const  r);
+  template <class T> Arb operator >> (Arb&&             l, SafeInt<T> const  r);
   template <class T> Arb operator >> (SafeInt<T> const  l, Arb        const& r);
   template <class T> Arb operator >> (Arb        const& l, T          const  r);
+  template <class T> Arb operator >> (Arb&&             l, T          const  r);
   template <class T> Arb operator >> (T          const  l, Arb        const& r);
   
   // Comparison operators.
@@ -796,11 +882,12 @@ namespace DAC {
   /*
    * Assignment operator.
    */
-                     inline Arb& Arb::operator = (Arb         const& number) { set(number); return *this; }
-                     inline Arb& Arb::operator = (std::string const& number) { set(number); return *this; }
-                     inline Arb& Arb::operator = (ArbInt      const& number) { set(number); return *this; }
-                     inline Arb& Arb::operator = (UArbInt     const& number) { set(number); return *this; }
-  template <class T> inline Arb& Arb::operator = (T           const  number) { set(number); return *this; }
+                     inline Arb& Arb::operator = (Arb         const& number) { set(number);            return *this; }
+                     inline Arb& Arb::operator = (Arb&&              number) { set(std::move(number)); return *this; }
+                     inline Arb& Arb::operator = (std::string const& number) { set(number);            return *this; }
+                     inline Arb& Arb::operator = (ArbInt      const& number) { set(number);            return *this; }
+                     inline Arb& Arb::operator = (UArbInt     const& number) { set(number);            return *this; }
+  template <class T> inline Arb& Arb::operator = (T           const  number) { set(number);            return *this; }
   
   /*
    * The base of this number.
@@ -933,18 +1020,18 @@ namespace DAC {
   /*
    * Return whether this number is an integer.
    */
-  inline bool Arb::isInteger () const { return (_q == 1); }
+  inline bool Arb::isInteger () const { _settle(); return (_q == 1); }
   
   /*
    * Return whether this number is positive.
    */
-  inline bool Arb::isPositive () const { return _p.isPositive() == 0; }
-  inline bool Arb::isNegative () const { return !isPositive();        }
+  inline bool Arb::isPositive () const { _settle(); return _p.isPositive(); }
+  inline bool Arb::isNegative () const { return !isPositive();  }
   
   /*
    * Return whether this number is equal to zero.
    */
-  inline bool Arb::isZero () const { return _p.isZero(); }
+  inline bool Arb::isZero () const { _settle(); return _p.isZero(); }
   
   /*
    * Return whether this number is even or odd.
@@ -995,6 +1082,8 @@ namespace DAC {
     
     // Set tmpnum to *this here to avoid carrying over rounding or fixed-point
     // properties, all we are interested in here is the value. Also, only abs.
+    // The bit counts below need lowest terms.
+    _settle();
     tmpnum.set(abs());
     
     // Convert tmpnum to the range of 1 <= tmpnum < 2, save changes in
@@ -1136,7 +1225,7 @@ namespace DAC {
     l._p *= r;
     
     // Reduce.
-    l._reduce();
+    l._lazyreduce();
     
   }
   template <class T> inline void Arb::_Mul<T, NumTypes::UINT>::op (Arb& l, T          const r) { _Mul<T, NumTypes::UINT>::op(l, SafeInt<T>(r)); }
@@ -1172,7 +1261,7 @@ namespace DAC {
     l._q *= r;
     
     // Reduce.
-    l._reduce();
+    l._lazyreduce();
     
   }
   template <class T> inline void Arb::_Div<T, NumTypes::UINT>::op (Arb& l, T          const r) { _Div<T, NumTypes::UINT>::op(l, SafeInt<T>(r)); }
@@ -1234,11 +1323,11 @@ namespace DAC {
     }
     
     // Add the easy way if l is an integer, otherwise scale.
-    if (l.isInteger()) {
+    if (l._q == 1) {
       l._p += r;
     } else {
       l._p += r * l._q;
-      l._reduce();
+      l._lazyreduce();
     }
     
   }
@@ -1261,18 +1350,20 @@ namespace DAC {
       return;
     }
     
-    // Subtracting from 0 is also easy.
+    // Subtracting from 0 is also easy. Negate after setting, r may be
+    // unsigned.
     if (l == 0) {
-      l = -r;
+      l    = r;
+      l._p = -l._p;
       return;
     }
     
     // Subtract the easy way if l is an integer, otherwise scale.
-    if (l.isInteger()) {
+    if (l._q == 1) {
       l._p -= r;
     } else {
       l._p -= r * l._q;
-      l._reduce();
+      l._lazyreduce();
     }
     
   }
@@ -1307,7 +1398,16 @@ namespace DAC {
     
   }
   template <class T> inline void Arb::_Shift<T, NumTypes::UINT>::op (Arb& l, T          const r, _Dir const dir) { _Shift<T, NumTypes::UINT>::op(l, SafeInt<T>(r), dir); }
-  template <class T> inline void Arb::_Shift<T, NumTypes::SINT>::op (Arb& l, SafeInt<T> const r, _Dir const dir) { _Shift<T, NumTypes::UINT>::op(l, r            , dir); }
+  template <class T> void Arb::_Shift<T, NumTypes::SINT>::op (Arb& l, SafeInt<T> const r, _Dir const dir) {
+    
+    // A negative shift is a shift the other way.
+    if (r < 0) {
+      _Shift<T, NumTypes::UINT>::op(l, -r, (dir == _DIR_L) ? _DIR_R : _DIR_L);
+    } else {
+      _Shift<T, NumTypes::UINT>::op(l, r, dir);
+    }
+    
+  }
   template <class T> inline void Arb::_Shift<T, NumTypes::SINT>::op (Arb& l, T          const r, _Dir const dir) { _Shift<T, NumTypes::SINT>::op(l, SafeInt<T>(r), dir); }
   
   /*
@@ -1339,7 +1439,8 @@ namespace DAC {
   template <class T> int Arb::_Compare<T, NumTypes::UINT>::op (Arb const& l, SafeInt<T> const r) {
     
     // Compare the easy way if possible, otherwise scale.
-    if (l.isInteger()) {
+    l._settle();
+    if (l._q == 1) {
       return l._p.op_compare(r);
     } else {
       return l._p.op_compare(r * l._q);
@@ -1447,73 +1548,122 @@ namespace DAC {
   /*
    * Arithmetic operators.
    */
-                     inline Arb operator * (Arb        const& l, Arb        const& r) { return Arb(l).op_mul(r);    }
-                     inline Arb operator * (Arb        const& l, ArbInt     const& r) { return Arb(l).op_mul(r);    }
-                     inline Arb operator * (Arb        const& l, UArbInt    const& r) { return Arb(l).op_mul(r);    }
-                     inline Arb operator * (ArbInt     const& l, Arb        const& r) { return Arb(r).op_mul(l);    }
-                     inline Arb operator * (UArbInt    const& l, Arb        const& r) { return Arb(r).op_mul(l);    }
-  template <class T> inline Arb operator * (Arb        const& l, SafeInt<T> const  r) { return Arb(l).op_mul(r);    }
-  template <class T> inline Arb operator * (SafeInt<T> const  l, Arb        const& r) { return Arb(r).op_mul(l);    }
-  template <class T> inline Arb operator * (Arb        const& l, T          const  r) { return Arb(l).op_mul(r);    }
-  template <class T> inline Arb operator * (T          const  l, Arb        const& r) { return Arb(r).op_mul(l);    }
-                     inline Arb operator / (Arb        const& l, Arb        const& r) { return Arb(l).op_div(r);    }
-                     inline Arb operator / (Arb        const& l, ArbInt     const& r) { return Arb(l).op_div(r);    }
-                     inline Arb operator / (Arb        const& l, UArbInt    const& r) { return Arb(l).op_div(r);    }
-                     inline Arb operator / (ArbInt     const& l, Arb        const& r) { return Arb(l).op_div(r);    }
-                     inline Arb operator / (UArbInt    const& l, Arb        const& r) { return Arb(l).op_div(r);    }
-  template <class T> inline Arb operator / (Arb        const& l, SafeInt<T> const  r) { return Arb(l).op_div(r);    }
-  template <class T> inline Arb operator / (SafeInt<T> const  l, Arb        const& r) { return Arb(l).op_div(r);    }
-  template <class T> inline Arb operator / (Arb        const& l, T          const  r) { return Arb(l).op_div(r);    }
-  template <class T> inline Arb operator / (T          const  l, Arb        const& r) { return Arb(l).op_div(r);    }
-                     inline Arb operator % (Arb        const& l, Arb        const& r) { return Arb(l).op_mod(r);    }
-                     inline Arb operator % (Arb        const& l, ArbInt     const& r) { return Arb(l).op_mod(r);    }
-                     inline Arb operator % (Arb        const& l, UArbInt    const& r) { return Arb(l).op_mod(r);    }
-                     inline Arb operator % (ArbInt     const& l, Arb        const& r) { return Arb(l).op_mod(r);    }
-                     inline Arb operator % (UArbInt    const& l, Arb        const& r) { return Arb(l).op_mod(r);    }
-  template <class T> inline Arb operator % (Arb        const& l, SafeInt<T> const  r) { return Arb(l).op_mod(r);    }
-  template <class T> inline Arb operator % (SafeInt<T> const  l, Arb        const& r) { return Arb(l).op_mod(r);    }
-  template <class T> inline Arb operator % (Arb        const& l, T          const  r) { return Arb(l).op_mod(r);    }
-  template <class T> inline Arb operator % (T          const  l, Arb        const& r) { return Arb(l).op_mod(r);    }
-                     inline Arb operator + (Arb        const& l, Arb        const& r) { return Arb(l).op_add(r);    }
-                     inline Arb operator + (Arb        const& l, ArbInt     const& r) { return Arb(l).op_add(r);    }
-                     inline Arb operator + (Arb        const& l, UArbInt    const& r) { return Arb(l).op_add(r);    }
-                     inline Arb operator + (ArbInt     const& l, Arb        const& r) { return Arb(r).op_add(l);    }
-                     inline Arb operator + (UArbInt    const& l, Arb        const& r) { return Arb(r).op_add(l);    }
-  template <class T> inline Arb operator + (Arb        const& l, SafeInt<T> const  r) { return Arb(l).op_add(r);    }
-  template <class T> inline Arb operator + (SafeInt<T> const  l, Arb        const& r) { return Arb(r).op_add(l);    }
-  template <class T> inline Arb operator + (Arb        const& l, T          const  r) { return Arb(l).op_add(r);    }
-  template <class T> inline Arb operator + (T          const  l, Arb        const& r) { return Arb(r).op_add(l);    }
-                     inline Arb operator - (Arb        const& l, Arb        const& r) { return Arb(l).op_sub(r);    }
-                     inline Arb operator - (Arb        const& l, ArbInt     const& r) { return Arb(l).op_sub(r);    }
-                     inline Arb operator - (Arb        const& l, UArbInt    const& r) { return Arb(l).op_sub(r);    }
+                     inline Arb operator * (Arb        const& l, Arb        const& r) { return std::move(Arb(l).op_mul(r));    }
+                     inline Arb operator * (Arb&&             l, Arb        const& r) { return std::move(l.op_mul(r));         }
+                     inline Arb operator * (Arb        const& l, ArbInt     const& r) { return std::move(Arb(l).op_mul(r));    }
+                     inline Arb operator * (Arb&&             l, ArbInt     const& r) { return std::move(l.op_mul(r));         }
+                     inline Arb operator * (Arb        const& l, UArbInt    const& r) { return std::move(Arb(l).op_mul(r));    }
+                     inline Arb operator * (Arb&&             l, UArbInt    const& r) { return std::move(l.op_mul(r));         }
+                     inline Arb operator * (ArbInt     const& l, Arb        const& r) { return std::move(Arb(r).op_mul(l));    }
+                     inline Arb operator * (ArbInt&&          l, Arb        const& r) { return std::move(Arb(r).op_mul(l));    }
+                     inline Arb operator * (UArbInt    const& l, Arb        const& r) { return std::move(Arb(r).op_mul(l));    }
+                     inline Arb operator * (UArbInt&&         l, Arb        const& r) { return std::move(Arb(r).op_mul(l));    }
+  template <class T> inline Arb operator * (Arb        const& l, SafeInt<T> const  r) { return std::move(Arb(l).op_mul(r));    }
+  template <class T> inline Arb operator * (Arb&&             l, SafeInt<T> const  r) { return std::move(l.op_mul(r));         }
+  template <class T> inline Arb operator * (SafeInt<T> const  l, Arb        const& r) { return std::move(Arb(r).op_mul(l));    }
+  template <class T> inline Arb operator * (Arb        const& l, T          const  r) { return std::move(Arb(l).op_mul(r));    }
+  template <class T> inline Arb operator * (Arb&&             l, T          const  r) { return std::move(l.op_mul(r));         }
+  template <class T> inline Arb operator * (T          const  l, Arb        const& r) { return std::move(Arb(r).op_mul(l));    }
+                     inline Arb operator / (Arb        const& l, Arb        const& r) { return std::move(Arb(l).op_div(r));    }
+                     inline Arb operator / (Arb&&             l, Arb        const& r) { return std::move(l.op_div(r));         }
+                     inline Arb operator / (Arb        const& l, ArbInt     const& r) { return std::move(Arb(l).op_div(r));    }
+                     inline Arb operator / (Arb&&             l, ArbInt     const& r) { return std::move(l.op_div(r));         }
+                     inline Arb operator / (Arb        const& l, UArbInt    const& r) { return std::move(Arb(l).op_div(r));    }
+                     inline Arb operator / (Arb&&             l, UArbInt    const& r) { return std::move(l.op_div(r));         }
+                     inline Arb operator / (ArbInt     const& l, Arb        const& r) { return std::move(Arb(l).op_div(r));    }
+                     inline Arb operator / (ArbInt&&          l, Arb        const& r) { return std::move(Arb(l).op_div(r));    }
+                     inline Arb operator / (UArbInt    const& l, Arb        const& r) { return std::move(Arb(l).op_div(r));    }
+                     inline Arb operator / (UArbInt&&         l, Arb        const& r) { return std::move(Arb(l).op_div(r));    }
+  template <class T> inline Arb operator / (Arb        const& l, SafeInt<T> const  r) { return std::move(Arb(l).op_div(r));    }
+  template <class T> inline Arb operator / (Arb&&             l, SafeInt<T> const  r) { return std::move(l.op_div(r));         }
+  template <class T> inline Arb operator / (SafeInt<T> const  l, Arb        const& r) { return std::move(Arb(l).op_div(r));    }
+  template <class T> inline Arb operator / (Arb        const& l, T          const  r) { return std::move(Arb(l).op_div(r));    }
+  template <class T> inline Arb operator / (Arb&&             l, T          const  r) { return std::move(l.op_div(r));         }
+  template <class T> inline Arb operator / (T          const  l, Arb        const& r) { return std::move(Arb(l).op_div(r));    }
+                     inline Arb operator % (Arb        const& l, Arb        const& r) { return std::move(Arb(l).op_mod(r));    }
+                     inline Arb operator % (Arb&&             l, Arb        const& r) { return std::move(l.op_mod(r));         }
+                     inline Arb operator % (Arb        const& l, ArbInt     const& r) { return std::move(Arb(l).op_mod(r));    }
+                     inline Arb operator % (Arb&&             l, ArbInt     const& r) { return std::move(l.op_mod(r));         }
+                     inline Arb operator % (Arb        const& l, UArbInt    const& r) { return std::move(Arb(l).op_mod(r));    }
+                     inline Arb operator % (Arb&&             l, UArbInt    const& r) { return std::move(l.op_mod(r));         }
+                     inline Arb operator % (ArbInt     const& l, Arb        const& r) { return std::move(Arb(l).op_mod(r));    }
+                     inline Arb operator % (ArbInt&&          l, Arb        const& r) { return std::move(Arb(l).op_mod(r));    }
+                     inline Arb operator % (UArbInt    const& l, Arb        const& r) { return std::move(Arb(l).op_mod(r));    }
+                     inline Arb operator % (UArbInt&&         l, Arb        const& r) { return std::move(Arb(l).op_mod(r));    }
+  template <class T> inline Arb operator % (Arb        const& l, SafeInt<T> const  r) { return std::move(Arb(l).op_mod(r));    }
+  template <class T> inline Arb operator % (Arb&&             l, SafeInt<T> const  r) { return std::move(l.op_mod(r));         }
+  template <class T> inline Arb operator % (SafeInt<T> const  l, Arb        const& r) { return std::move(Arb(l).op_mod(r));    }
+  template <class T> inline Arb operator % (Arb        const& l, T          const  r) { return std::move(Arb(l).op_mod(r));    }
+  template <class T> inline Arb operator % (Arb&&             l, T          const  r) { return std::move(l.op_mod(r));         }
+  template <class T> inline Arb operator % (T          const  l, Arb        const& r) { return std::move(Arb(l).op_mod(r));    }
+                     inline Arb operator + (Arb        const& l, Arb        const& r) { return std::move(Arb(l).op_add(r));    }
+                     inline Arb operator + (Arb&&             l, Arb        const& r) { return std::move(l.op_add(r));         }
+                     inline Arb operator + (Arb        const& l, ArbInt     const& r) { return std::move(Arb(l).op_add(r));    }
+                     inline Arb operator + (Arb&&             l, ArbInt     const& r) { return std::move(l.op_add(r));         }
+                     inline Arb operator + (Arb        const& l, UArbInt    const& r) { return std::move(Arb(l).op_add(r));    }
+                     inline Arb operator + (Arb&&             l, UArbInt    const& r) { return std::move(l.op_add(r));         }
+                     inline Arb operator + (ArbInt     const& l, Arb        const& r) { return std::move(Arb(r).op_add(l));    }
+                     inline Arb operator + (ArbInt&&          l, Arb        const& r) { return std::move(Arb(r).op_add(l));    }
+                     inline Arb operator + (UArbInt    const& l, Arb        const& r) { return std::move(Arb(r).op_add(l));    }
+                     inline Arb operator + (UArbInt&&         l, Arb        const& r) { return std::move(Arb(r).op_add(l));    }
+  template <class T> inline Arb operator + (Arb        const& l, SafeInt<T> const  r) { return std::move(Arb(l).op_add(r));    }
+  template <class T> inline Arb operator + (Arb&&             l, SafeInt<T> const  r) { return std::move(l.op_add(r));         }
+  template <class T> inline Arb operator + (SafeInt<T> const  l, Arb        const& r) { return std::move(Arb(r).op_add(l));    }
+  template <class T> inline Arb operator + (Arb        const& l, T          const  r) { return std::move(Arb(l).op_add(r));    }
+  template <class T> inline Arb operator + (Arb&&             l, T          const  r) { return std::move(l.op_add(r));         }
+  template <class T> inline Arb operator + (T          const  l, Arb        const& r) { return std::move(Arb(r).op_add(l));    }
+                     inline Arb operator - (Arb        const& l, Arb        const& r) { return std::move(Arb(l).op_sub(r));    }
+                     inline Arb operator - (Arb&&             l, Arb        const& r) { return std::move(l.op_sub(r));         }
+                     inline Arb operator - (Arb        const& l, ArbInt     const& r) { return std::move(Arb(l).op_sub(r));    }
+                     inline Arb operator - (Arb&&             l, ArbInt     const& r) { return std::move(l.op_sub(r));         }
+                     inline Arb operator - (Arb        const& l, UArbInt    const& r) { return std::move(Arb(l).op_sub(r));    }
+                     inline Arb operator - (Arb&&             l, UArbInt    const& r) { return std::move(l.op_sub(r));         }
                      inline Arb operator - (ArbInt     const& l, Arb        const& r) { return -(Arb(r).op_sub(l)); }
+                     inline Arb operator - (ArbInt&&          l, Arb        const& r) { return -(Arb(r).op_sub(l)); }
                      inline Arb operator - (UArbInt    const& l, Arb        const& r) { return -(Arb(r).op_sub(l)); }
-  template <class T> inline Arb operator - (Arb        const& l, SafeInt<T> const  r) { return Arb(l).op_sub(r);    }
+                     inline Arb operator - (UArbInt&&         l, Arb        const& r) { return -(Arb(r).op_sub(l)); }
+  template <class T> inline Arb operator - (Arb        const& l, SafeInt<T> const  r) { return std::move(Arb(l).op_sub(r));    }
+  template <class T> inline Arb operator - (Arb&&             l, SafeInt<T> const  r) { return std::move(l.op_sub(r));         }
   template <class T> inline Arb operator - (SafeInt<T> const  l, Arb        const& r) { return -(Arb(r).op_sub(l)); }
-  template <class T> inline Arb operator - (Arb        const& l, T          const  r) { return Arb(l).op_sub(r);    }
+  template <class T> inline Arb operator - (Arb        const& l, T          const  r) { return std::move(Arb(l).op_sub(r));    }
+  template <class T> inline Arb operator - (Arb&&             l, T          const  r) { return std::move(l.op_sub(r));         }
   template <class T> inline Arb operator - (T          const  l, Arb        const& r) { return -(Arb(r).op_sub(l)); }
   
   /*
    * Bit shift operators.
    */
-                     inline Arb operator << (Arb        const& l, Arb        const& r) { return Arb(l).op_shl(r); }
-                     inline Arb operator << (Arb        const& l, ArbInt     const& r) { return Arb(l).op_shl(r); }
-                     inline Arb operator << (Arb        const& l, UArbInt    const& r) { return Arb(l).op_shl(r); }
-                     inline Arb operator << (ArbInt     const& l, Arb        const& r) { return Arb(l).op_shl(r); }
-                     inline Arb operator << (UArbInt    const& l, Arb        const& r) { return Arb(l).op_shl(r); }
-  template <class T> inline Arb operator << (Arb        const& l, SafeInt<T> const  r) { return Arb(l).op_shl(r); }
-  template <class T> inline Arb operator << (SafeInt<T> const  l, Arb        const& r) { return Arb(l).op_shl(r); }
-  template <class T> inline Arb operator << (Arb        const& l, T          const  r) { return Arb(l).op_shl(r); }
-  template <class T> inline Arb operator << (T          const  l, Arb        const& r) { return Arb(l).op_shl(r); }
-                     inline Arb operator >> (Arb        const& l, Arb        const& r) { return Arb(l).op_shr(r); }
-                     inline Arb operator >> (Arb        const& l, ArbInt     const& r) { return Arb(l).op_shr(r); }
-                     inline Arb operator >> (Arb        const& l, UArbInt    const& r) { return Arb(l).op_shr(r); }
-                     inline Arb operator >> (ArbInt     const& l, Arb        const& r) { return Arb(l).op_shr(r); }
-                     inline Arb operator >> (UArbInt    const& l, Arb        const& r) { return Arb(l).op_shr(r); }
-  template <class T> inline Arb operator >> (Arb        const& l, SafeInt<T> const  r) { return Arb(l).op_shr(r); }
-  template <class T> inline Arb operator >> (SafeInt<T> const  l, Arb        const& r) { return Arb(l).op_shr(r); }
-  template <class T> inline Arb operator >> (Arb        const& l, T          const  r) { return Arb(l).op_shr(r); }
-  template <class T> inline Arb operator >> (T          const  l, Arb        const& r) { return Arb(l).op_shr(r); }
+                     inline Arb operator << (Arb        const& l, Arb        const& r) { return std::move(Arb(l).op_shl(r)); }
+                     inline Arb operator << (Arb&&             l, Arb        const& r) { return std::move(l.op_shl(r));      }
+                     inline Arb operator << (Arb        const& l, ArbInt     const& r) { return std::move(Arb(l).op_shl(r)); }
+                     inline Arb operator << (Arb&&             l, ArbInt     const& r) { return std::move(l.op_shl(r));      }
+                     inline Arb operator << (Arb        const& l, UArbInt    const& r) { return std::move(Arb(l).op_shl(r)); }
+                     inline Arb operator << (Arb&&             l, UArbInt    const& r) { return std::move(l.op_shl(r));      }
+                     inline Arb operator << (ArbInt     const& l, Arb        const& r) { return std::move(Arb(l).op_shl(r)); }
+                     inline Arb operator << (ArbInt&&          l, Arb        const& r) { return std::move(Arb(l).op_shl(r)); }
+                     inline Arb operator << (UArbInt    const& l, Arb        const& r) { return std::move(Arb(l).op_shl(r)); }
+                     inline Arb operator << (UArbInt&&         l, Arb        const& r) { return std::move(Arb(l).op_shl(r)); }
+  template <class T> inline Arb operator << (Arb        const& l, SafeInt<T> const  r) { return std::move(Arb(l).op_shl(r)); }
+  template <class T> inline Arb operator << (Arb&&             l, SafeInt<T> const  r) { return std::move(l.op_shl(r));      }
+  template <class T> inline Arb operator << (SafeInt<T> const  l, Arb        const& r) { return std::move(Arb(l).op_shl(r)); }
+  template <class T> inline Arb operator << (Arb        const& l, T          const  r) { return std::move(Arb(l).op_shl(r)); }
+  template <class T> inline Arb operator << (Arb&&             l, T          const  r) { return std::move(l.op_shl(r));      }
+  template <class T> inline Arb operator << (T          const  l, Arb        const& r) { return std::move(Arb(l).op_shl(r)); }
+                     inline Arb operator >> (Arb        const& l, Arb        const& r) { return std::move(Arb(l).op_shr(r)); }
+                     inline Arb operator >> (Arb&&             l, Arb        const& r) { return std::move(l.op_shr(r));      }
+                     inline Arb operator >> (Arb        const& l, ArbInt     const& r) { return std::move(Arb(l).op_shr(r)); }
+                     inline Arb operator >> (Arb&&             l, ArbInt     const& r) { return std::move(l.op_shr(r));      }
+                     inline Arb operator >> (Arb        const& l, UArbInt    const& r) { return std::move(Arb(l).op_shr(r)); }
+                     inline Arb operator >> (Arb&&             l, UArbInt    const& r) { return std::move(l.op_shr(r));      }
+                     inline Arb operator >> (ArbInt     const& l, Arb        const& r) { return std::move(Arb(l).op_shr(r)); }
+                     inline Arb operator >> (ArbInt&&          l, Arb        const& r) { return std::move(Arb(l).op_shr(r)); }
+                     inline Arb operator >> (UArbInt    const& l, Arb        const& r) { return std::move(Arb(l).op_shr(r)); }
+                     inline Arb operator >> (UArbInt&&         l, Arb        const& r) { return std::move(Arb(l).op_shr(r)); }
+  template <class T> inline Arb operator >> (Arb        const& l, SafeInt<T> const  r) { return std::move(Arb(l).op_shr(r)); }
+  template <class T> inline Arb operator >> (Arb&&             l, SafeInt<T> const  r) { return std::move(l.op_shr(r));      }
+  template <class T> inline Arb operator >> (SafeInt<T> const  l, Arb        const& r) { return std::move(Arb(l).op_shr(r)); }
+  template <class T> inline Arb operator >> (Arb        const& l, T          const  r) { return std::move(Arb(l).op_shr(r)); }
+  template <class T> inline Arb operator >> (Arb&&             l, T          const  r) { return std::move(l.op_shr(r));      }
+  template <class T> inline Arb operator >> (T          const  l, Arb        const& r) { return std::move(Arb(l).op_shr(r)); }
   
   /*
    * Comparison operators.
@@ -9,12 +9,16 @@
 #include <string>
 #include <limits>
 #include <algorithm>
+#include <deque>
+#include <map>
+#include <mutex>
 
 // System includes.
 #include <SafeInt.h++>
 #include <to_string.h++>
 #include <rppower.h++>
 #include <CaseConvert.h++>
+#include <OpCounters.h++>
 
 // Class include.
 #include "ArbInt.h++"
@@ -35,6 +39,13 @@ namespace DAC {
   unsigned int   const UArbInt::s_digitbits = numeric_limits<_DigT>::digits >> 1;
   UArbInt::_DigT const UArbInt::s_digitbase = 1 << (numeric_limits<_DigT>::digits >> 1);
   UArbInt::_DigT const UArbInt::s_bitmask   = (1 << (numeric_limits<_DigT>::digits >> 1)) - 1;
+  unsigned int   const UArbInt::s_limbbits  = numeric_limits<_DigT>::digits;
+  
+  size_t UArbInt::karatsuba_threshold =  48;
+  size_t UArbInt::toom3_threshold     = 256;
+  size_t UArbInt::newton_threshold    = 750;
+  size_t UArbInt::baseconv_threshold  =  32;
+  size_t UArbInt::scratch_limit       = 1 << 16;
   
   UArbInt::_NumChrT const UArbInt::s_numodigits = 36;
   UArbInt::_StrChrT const UArbInt::s_odigits[]  = {
@@ -120,6 +131,83 @@ namespace DAC {
   };
   UArbInt::value_type const UArbInt::max_input_base = 36;
   
+  /***************************************************************************/
+  // Types.
+  
+  /*
+   * A limb string borrowed from the scratch arena for the life of this
+   * object. Only spilled storage is worth keeping, and only a few are kept
+   * per thread, enough for the temporaries of one operation and its
+   * recursion.
+   */
+  class UArbInt::_Scratch {
+    
+    public:
+      
+      // Borrow and return.
+       _Scratch ();
+      ~_Scratch ();
+      
+      // The limb string.
+      _DigsT& operator *  ();
+      _DigsT* operator -> ();
+      
+    private:
+      
+      // Not copyable.
+      _Scratch (_Scratch const&);
+      _Scratch& operator = (_Scratch const&);
+      
+      // The limb string.
+      _DigsT _digs;
+      
+      // This thread's pool.
+      static vector<_DigsT>& s_pool ();
+      
+      // Most limb strings kept per thread.
+      static size_t const s_depth = 8;
+    
+  };
+  
+  /*
+   * Borrow the most recently returned limb string, if there is one.
+   */
+  UArbInt::_Scratch::_Scratch () {
+    vector<_DigsT>& pool = s_pool();
+    if (!pool.empty()) {
+      _digs = std::move(pool.back());
+      pool.pop_back();
+    }
+  }
+  
+  /*
+   * Give the storage back if it is worth keeping.
+   */
+  UArbInt::_Scratch::~_Scratch () {
+    vector<_DigsT>& pool = s_pool();
+    if (!_digs.isInline() && _digs.capacity() <= scratch_limit && pool.size() < s_depth) {
+      _digs.clear();
+      pool.push_back(std::move(_digs));
+    }
+  }
+  
+  /*
+   * Get the limb string.
+   */
+  inline UArbInt::_DigsT& UArbInt::_Scratch::operator *  () { return  _digs; }
+  inline UArbInt::_DigsT* UArbInt::_Scratch::operator -> () { return &_digs; }
+  
+  /*
+   * Get this thread's pool.
+   */
+  vector<UArbInt::_DigsT>& UArbInt::_Scratch::s_pool () {
+    static thread_local vector<_DigsT> pool;
+    if (pool.capacity() < s_depth) {
+      pool.reserve(s_depth);
+    }
+    return pool;
+  }
+  
   /***************************************************************************/
   // Function members.
   
@@ -174,10 +262,10 @@ namespace DAC {
     }
     
     // Load the number into this for exception safety.
-    _DigsT new_digits;
+    _SharedDigsT new_digits;
     
-    // Parser will load data into here.
-    _DigStrT num;
+    // Parser will load data into here, little-endian.
+    _DigsT num;
     
     // Determine the number base.
     string::size_type num_start =     0;
@@ -198,6 +286,7 @@ namespace DAC {
     }
     
     // Parse the number.
+    num.resize(number.length() - num_start);
     for (string::size_type i = num_start; i != number.length(); ++i) {
       
       // Get the value of this digit.
@@ -209,7 +298,7 @@ namespace DAC {
       }
       
       // Add the digit to the digit string.
-      num.insert(num.begin(), digval);
+      num[number.length() - 1 - i] = digval;
       
     }
     
@@ -217,7 +306,9 @@ namespace DAC {
     s_trimZerosE(num);
     
     // Convert to the native number base.
-    s_baseConv(num, num_base, new_digits, s_digitbase);
+    _DigsT limbs;
+    s_fromRadix(limbs, num, num_base);
+    s_fromLimbs(limbs, new_digits);
     
     // The new number has been loaded successfully. Swap it in.
     _digits = new_digits;
@@ -227,6 +318,29 @@ namespace DAC {
     
   }
   
+  /*
+   * Set this number to a power of a number base.
+   */
+  UArbInt& UArbInt::setBasePow (value_type const base, size_t const exponent) {
+    
+    // Check the base.
+    if (base < 2) {
+      throw Errors::BaseOutOfRangeMin();
+    }
+    if (base > s_digitbase) {
+      throw Errors::BaseOutOfRangeMax();
+    }
+    
+    // Nothing to it.
+    _DigsT limbs;
+    s_radixPow(limbs, base, exponent);
+    s_fromLimbs(limbs, _digits);
+    
+    // Done.
+    return *this;
+    
+  }
+  
   /*
    * Push a string onto the back of this number.
    */
@@ -236,10 +350,10 @@ namespace DAC {
     UArbInt newnum;
     
     // Convert the new number.
-    newnum.Base(_base).set(number);
+    newnum.Base(_base).set(number, false);
     
     // Move digits up to accomidate the new digits.
-    op_mul(UArbInt(_base).pow(number.length()));
+    op_mul(UArbInt().setBasePow(_base, number.length()));
     
     // Add the new number to this.
     op_add(newnum);
@@ -263,10 +377,18 @@ namespace DAC {
       
       // Get the base we will be converting to.
       _DigT tobase(base ? base : _base);
+      if (tobase < 2) {
+        throw Errors::BaseOutOfRangeMin();
+      }
+      if (tobase > s_digitbase) {
+        throw Errors::BaseOutOfRangeMax();
+      }
       
       // Convert to the output base.
+      _DigsT limbs;
       _DigsT num;
-      s_baseConv(_digits, s_digitbase, num, tobase);
+      s_toLimbs(_digits, limbs);
+      s_toRadix(num, limbs, tobase);
       
       // Load this into the string. If the base is greater than the number
       // of digits defined, output the raw numbers of each digit.
@@ -296,44 +418,24 @@ namespace DAC {
    */
   UArbInt& UArbInt::op_mul (UArbInt const& number) {
     
-    // Work area.
-    UArbInt retval;
-    
     // If either number is zero, no multiplying to be done.
-    if (!isZero() && !number.isZero()) {
-      
-      // Create a digit product and make a reference its digits to reduce
-      // typing.
-      UArbInt digproduct;
-      
-      // Multiply like 3rd grade.
-      for (_DigsT::size_type i = 0; i != number._digits.size(); ++i) {
-        
-        // Get the product for a single digit.
-        for (_DigsT::size_type j = 0; j != _digits.size(); ++j) {
-          
-          // Create a new digit in the digit product if necessary.
-          if (digproduct._digits.size() == j) {
-            digproduct._digits.push_back(0);
-          }
-          
-          // Multiply into the digit product and carry.
-          digproduct._digits[j] += SafeInt<_DigT>(number._digits[i]) * _digits[j];
-          digproduct._carry(j);
-          
-        }
-        
-        // Offset this digit product and add it to the final product.
-        digproduct._digits.insert(digproduct._digits.begin(), i, 0);
-        retval.op_add(digproduct);
-        digproduct.clear();
-        
-      }
-      
+    if (isZero() || number.isZero()) {
+      _digits.clear();
+      return *this;
     }
     
-    // Swap in the result and return.
-    _digits.swap(retval._digits);
+    // Pack both numbers into full-width limbs, multiply, then unpack the
+    // product back into native digits. Packing both before writing anything
+    // makes squaring in place safe.
+    _Scratch l;
+    _Scratch r;
+    _Scratch product;
+    s_toLimbs(_digits, *l);
+    s_toLimbs(number._digits, *r);
+    s_mulLimbs(*product, *l, *r);
+    s_fromLimbs(*product, _digits);
+    
+    // Done.
     return *this;
     
   }
@@ -343,138 +445,12 @@ namespace DAC {
    */
   UArbInt& UArbInt::op_div (UArbInt const& number, UArbInt* const remainder) {
     
-    // If number is zero, throw error.
-    if (number.isZero()) {
-      throw Errors::DivByZero();
-    }
-    
-    // Work area.
-    UArbInt retval;
-    
-    // If number > this, result is zero, remainder is this.
-    if (number > *this) {
-      
-      // Set the remainder.
-      if (remainder != 0) {
-        *remainder = *this;
-      }
-      
-    // Otherwise we have work to do.
-    } else {
-      
-      // Cache a copy of the high-order digit of the dividend.
-      SafeInt<_DigT> roughdivnd(number._digits.back());
-      
-      // Seed the group of digits we will be dividing, then iterate through
-      // the divisor. diggroup is set to *this's last number._digits's size
-      // digits. Since *this is at least as big as number, this will always
-      // succeed. The loop iterates backwards from the least significant
-      // digit added to diggroup to the end of _digits, although the
-      // iterator is only ever referenced to add one to it.
-      UArbInt diggroup;
-      diggroup._digits = _DigsT(_digits.end() - number._digits.size(), _digits.end());
-      for (_DigsT::reverse_iterator i = _digits.rbegin() + (number._digits.size() - 1); i != _digits.rend(); ++i) {
-        
-        // Guess and test. Guess is a single native digit so we can use the
-        // computer to do some of our division for us. These need to be set
-        // to zero at each iteration, possible cause of bug if they are not.
-        SafeInt<_DigT> guess;
-        UArbInt        test;
-        
-        // Make sure that the digit group is greater than or equal to the
-        // dividend. If not, the quotient for this digit is zero, move on.
-        if (diggroup >= number) {
-          
-          // Make a guess at the quotient of this digit by dividing the
-          // high-order digits. Initially the rough divisor is the high-
-          // order digit of the digit group, but our guess needs to be based
-          // on the number of digits the digit group has over our dividend.
-          // The high-order digits of diggroup are added one at a time, and
-          // moved up 1/2 of the native type's precision. Since the rough
-          // dividend will never be over 1/2 of the native type's precision,
-          // roughdivor can never overflow, since it will always spend at
-          // least one iteration greater than roughdivnd but cannot be
-          // greater than the type maximum.
-          SafeInt<_DigT> roughdivor(diggroup._digits.back());
-          _DigsT::size_type j;
-          for (j = 0; j != (diggroup._digits.size() - number._digits.size()); ++j) {
-            roughdivor *= s_digitbase;
-            roughdivor += diggroup._digits[diggroup._digits.size() - 1 - (j + 1)];
-          }
-          guess = roughdivor / roughdivnd;
-            
-          // Correct the guess. First create a test. Also create a floor
-          // and ceiling for future guesses. Error in guesses is based on
-          // the fact that we are only dividing the high order digits of
-          // each number, so the worst-case scenario is that the low-order
-          // digits are all at maximum or minimum. For the floor divisor,
-          // assume that all untested digits are at the minimum by lowering
-          // the divisor by s_digitbase^addl digits (necessary because carry
-          // would cause high-order digit to change), and raise the dividend
-          // by 1. For the ceiling divisor, raise it by s_digitbase^addl
-          // and lower the dividend by 1.
-          // *** CORRECTION ***
-          // Now starting floor at 1 (guess must be at least 1 or we
-          // wouldn't be here) and ceil at max(). The performance penalty
-          // will be negligable since the first time we go over or under the
-          // floor and ceil are corrected, those two possible missed guesses
-          // should not take significantly more time than it would take to
-          // ensure that floor and ceil do not overflow, and even with those
-          // guarantees the better guesses may not even help significantly
-          // since they will still almost always be wrong.
-          test = number * guess;
-          //SafeInteger<_DigT> guessfloor = (roughdivor - rppower(SafeInteger<_DigT>(s_digitbase), j)) / (roughdivnd + 1);
-          //SafeInteger<_DigT> guessceil  = (roughdivor + rppower(SafeInteger<_DigT>(s_digitbase), j)) / ((roughdivnd == 1) ? 1 : (roughdivnd - 1));
-          SafeInt<_DigT> guessfloor(1);
-          SafeInt<_DigT> guessceil(numeric_limits<_DigT>::max());
-          
-          // Loop until the test is within the correct range.
-          while ((test > diggroup) || ((test + number) <= diggroup)) {
-            
-            // If the test is greater than the digit group, we need to lower
-            // our guess. Lower it by moving halfway toward the floor. Also,
-            // update the ceiling. We know that we are already over it, so
-            // make the ceiling one less than the current guess.
-            if (test > diggroup) {
-              guessceil = guess - 1;
-              guess     = guess - (((guess - guessfloor) >> 1) + 1);
-              test      = number * guess;
-            
-            // If there is room for more dividends, we need to raise our
-            // guess. Raise it halfway toward the ceiling. Update the floor,
-            // it is at least one higher than our current guess.
-            } else if ((test + number) <= diggroup) {
-              guessfloor = guess + 1;
-              guess      = guess + (((guessceil - guess) >> 1) + 1);
-              test       = number * guess;
-            }
-            
-          }
-          
-        }
-        
-        // The guess must be correct by this point. Add it to the quotient
-        // and prepare for the next iteration by removing the current digit
-        // from the digit group, shift the digit group up one digit, and add
-        // the next digit of the divisor.
-        retval._digits.insert(retval._digits.begin(), guess);
-        diggroup -= test;
-        if (i != (_digits.rend() - 1)) {
-          diggroup._digits.insert(diggroup._digits.begin(), *(i + 1));
-        }
-        
-      }
-      
-      // Set the remainder if a container was given.
-      if (remainder != 0) {
-        *remainder = diggroup;
-      }
-      
-    }
+    // Remainder goes to a scratch number if not wanted. If remainder is
+    // this, the remainder is what is left, same as always.
+    UArbInt scratch;
+    divmod(number, *this, remainder ? *remainder : scratch);
     
-    // Clean up, move the result into place and return.
-    retval._trimZeros();
-    _digits.swap(retval._digits);
+    // Done.
     return *this;
     
   }
@@ -484,20 +460,37 @@ namespace DAC {
    */
   UArbInt& UArbInt::op_mod (UArbInt const& number) {
     
-    // Cannot divide by zero. check is redundant, but needed for exception to
-    // report proper operator.
+    // Do division and keep the remainder.
+    UArbInt quotient;
+    divmod(number, quotient, *this);
+    return *this;
+    
+  }
+  
+  /*
+   * Divide, getting both the quotient and remainder.
+   */
+  void UArbInt::divmod (UArbInt const& number, UArbInt& quotient, UArbInt& remainder) const {
+    
+    // If number is zero, throw error.
     if (number.isZero()) {
-      throw UArbInt::Errors::DivByZero();
+      throw Errors::DivByZero();
     }
     
-    // Work area.
-    UArbInt retval;
-    UArbInt quotient(*this);
-    
-    // Do division and return the remainder.
-    quotient.op_div(number, &retval);
-    _digits.swap(retval._digits);
-    return *this;
+    // Do the work in full-width limbs. Both operands are packed before
+    // either result is written, so any of them may alias this or number.
+    _Scratch l;
+    _Scratch r;
+    _Scratch q;
+    _Scratch rem;
+    s_toLimbs(_digits, *l);
+    s_toLimbs(number._digits, *r);
+    s_divModLimbs(*q, *rem, *l, *r);
+    
+    // Set the results. Remainder last, so it wins if both are the same
+    // number.
+    s_fromLimbs(*q, quotient._digits);
+    s_fromLimbs(*rem, remainder._digits);
     
   }
   
@@ -507,6 +500,7 @@ namespace DAC {
   UArbInt& UArbInt::op_add (UArbInt const& number) {
     
     // Add like kindergarten.
+    OpCounters::add(OpCounters::DIGIT_OPS, number._digits.size());
     for (_DigsT::size_type i = 0; i != number._digits.size(); ++i) {
       
       // Create a new digit if necessary.
@@ -536,6 +530,7 @@ namespace DAC {
     }
     
     // Subtract like kindergarten.
+    OpCounters::add(OpCounters::DIGIT_OPS, number._digits.size());
     for (_DigsT::size_type i = 0; i != number._digits.size(); ++i) {
       
       // Borrow if necessary and subtract.
@@ -704,6 +699,30 @@ namespace DAC {
     
   }
   
+  /*
+   * Find the integer part of the nth root of this number.
+   */
+  UArbInt UArbInt::iroot (UArbInt const& n) const {
+    
+    // There is no 0th root.
+    if (n.isZero()) {
+      throw Errors::DivByZero();
+    }
+    
+    // 0, 1, and first roots are themselves. Past the number of bits, the
+    // root is less than 2.
+    if (n == 1 || *this <= 1) {
+      return *this;
+    }
+    if (n >= bitsInNumber()) {
+      return UArbInt(1);
+    }
+    
+    // Nothing to it.
+    return s_iroot(*this, n.Value<size_t>());
+    
+  }
+  
   /*
    * Perform carry.
    */
@@ -886,18 +905,18 @@ namespace DAC {
       
       // Pull out any whole digits and shift them.
       SafeInt<_DigsT::size_type> tmp_digits = bits / s_digitbits;
-      SafeInt<size_t>            tmp_bits   = bits - tmp_digits;
+      SafeInt<size_t>            tmp_bits   = bits - tmp_digits * s_digitbits;
       if (tmp_digits) {
         _shiftDigits(tmp_digits, dir);
       }
       
       // Shift any remaining bits.
-      if (bits) {
+      if (tmp_bits) {
         
         // Work area
         _DigT        carry    = 0;
         _DigT        oldcarry = 0;
-        _DigT        bitmask  = rppower(SafeInt<_DigT>(2), tmp_bits) - 1;
+        _DigT        bitmask  = (static_cast<_DigT>(1) << tmp_bits) - 1;
         unsigned int bitdiff  = s_digitbits - tmp_bits;
         
         // Select shift direction.
@@ -931,6 +950,1099 @@ namespace DAC {
     
   }
   
+  /*
+   * Pack native digits into full-width limbs.
+   */
+  void UArbInt::s_toLimbs (_SharedDigsT const& digits, _DigsT& limbs) {
+    
+    // Two native digits to a limb, low-order digit in the low half.
+    limbs.assign((digits.size() + 1) >> 1, 0);
+    for (_DigsT::size_type i = 0; i != digits.size(); ++i) {
+      limbs[i >> 1] |= digits[i] << ((i & 1) * s_digitbits);
+    }
+    
+  }
+  
+  /*
+   * Unpack full-width limbs into native digits.
+   */
+  void UArbInt::s_fromLimbs (_DigsT const& limbs, _SharedDigsT& digits) {
+    
+    // Split each limb, then drop the high-order zero the last limb may have
+    // left behind. Digits are written through a pointer so that sharing is
+    // only checked once.
+    digits.resize(limbs.size() << 1);
+    _DigT* const out = digits.data();
+    for (_DigsT::size_type i = 0; i != limbs.size(); ++i) {
+      out[ i << 1     ] = limbs[i] & s_bitmask;
+      out[(i << 1) + 1] = limbs[i] >> s_digitbits;
+    }
+    s_trimZerosE(digits);
+    
+  }
+  
+  /*
+   * Compare two limb strings.
+   */
+  int UArbInt::s_cmpLimbs (_DigsT const& l, _DigsT const& r) {
+    
+    // Limb strings are trimmed, so the longer one is larger.
+    if (l.size() != r.size()) {
+      return (l.size() > r.size()) ? 1 : -1;
+    }
+    
+    // Same length, first differing limb from the top decides.
+    for (_DigsT::size_type i = l.size(); i != 0; --i) {
+      if (l[i - 1] != r[i - 1]) {
+        return (l[i - 1] > r[i - 1]) ? 1 : -1;
+      }
+    }
+    
+    // Equal.
+    return 0;
+    
+  }
+  
+  /*
+   * Add r, shifted up offset limbs, to l.
+   */
+  void UArbInt::s_addLimbs (_DigsT& l, _DigsT const& r, _DigsT::size_type const offset) {
+    
+    // Nothing to add.
+    if (r.empty()) {
+      return;
+    }
+    
+    // Make room for the addend.
+    if (l.size() < r.size() + offset) {
+      l.resize(r.size() + offset, 0);
+    }
+    
+    // Add, then run the carry out as far as it goes.
+    OpCounters::add(OpCounters::DIGIT_OPS, r.size());
+    _DLimbT           carry = 0;
+    _DigsT::size_type i     = offset;
+    for (_DigsT::size_type j = 0; j != r.size(); ++i, ++j) {
+      carry += static_cast<_DLimbT>(l[i]) + r[j];
+      l[i]   = static_cast<_DigT>(carry);
+      carry >>= s_limbbits;
+    }
+    for (; carry && i != l.size(); ++i) {
+      carry += l[i];
+      l[i]   = static_cast<_DigT>(carry);
+      carry >>= s_limbbits;
+    }
+    if (carry) {
+      l.push_back(static_cast<_DigT>(carry));
+    }
+    
+  }
+  
+  /*
+   * Subtract r from l. l must be at least as large as r.
+   */
+  void UArbInt::s_subLimbs (_DigsT& l, _DigsT const& r) {
+    
+    // Subtract, a wrapped result in the high half of the accumulator is a
+    // borrow.
+    OpCounters::add(OpCounters::DIGIT_OPS, r.size());
+    _DLimbT           borrow = 0;
+    _DigsT::size_type i      = 0;
+    for (; i != r.size(); ++i) {
+      _DLimbT diff = static_cast<_DLimbT>(l[i]) - r[i] - borrow;
+      l[i]   = static_cast<_DigT>(diff);
+      borrow = (diff >> s_limbbits) ? 1 : 0;
+    }
+    for (; borrow && i != l.size(); ++i) {
+      borrow = (l[i] == 0) ? 1 : 0;
+      --l[i];
+    }
+    
+    // A borrow out the top means the caller broke the contract.
+    if (borrow) {
+      throw Errors::Overrun();
+    }
+    
+    // Clean up.
+    s_trimZerosE(l);
+    
+  }
+  
+  /*
+   * Add signed limb strings. Signs are carried separately as negative
+   * flags, zero is never negative.
+   */
+  void UArbInt::s_addSigned (_DigsT& l, bool& lneg, _DigsT const& r, bool const rneg) {
+    
+    // Same sign adds magnitudes, otherwise subtract the smaller magnitude
+    // from the larger and take the larger's sign.
+    if (lneg == rneg) {
+      s_addLimbs(l, r);
+    } else if (s_cmpLimbs(l, r) >= 0) {
+      s_subLimbs(l, r);
+    } else {
+      _DigsT tmp(r);
+      s_subLimbs(tmp, l);
+      l.swap(tmp);
+      lneg = rneg;
+    }
+    
+    // No negative zero.
+    if (l.empty()) {
+      lneg = false;
+    }
+    
+  }
+  
+  /*
+   * Shift a limb string left by less than a limb.
+   */
+  void UArbInt::s_shlLimbs (_DigsT& l, unsigned int const bits) {
+    
+    // Nothing to do.
+    if (l.empty() || !bits) {
+      return;
+    }
+    
+    // Shift up, carrying the high bits of each limb into the next.
+    _DigT carry = 0;
+    for (_DigsT::iterator i = l.begin(); i != l.end(); ++i) {
+      _DigT next = *i >> (s_limbbits - bits);
+      *i    = (*i << bits) | carry;
+      carry = next;
+    }
+    if (carry) {
+      l.push_back(carry);
+    }
+    
+  }
+  
+  /*
+   * Shift a limb string right by less than a limb.
+   */
+  void UArbInt::s_shrLimbs (_DigsT& l, unsigned int const bits) {
+    
+    // Nothing to do.
+    if (l.empty() || !bits) {
+      return;
+    }
+    
+    // Shift down, carrying the low bits of each limb into the one below.
+    _DigT carry = 0;
+    for (_DigsT::reverse_iterator i = l.rbegin(); i != l.rend(); ++i) {
+      _DigT next = *i << (s_limbbits - bits);
+      *i    = (*i >> bits) | carry;
+      carry = next;
+    }
+    s_trimZerosE(l);
+    
+  }
+  
+  /*
+   * Divide a limb string by a single limb in place. Returns the remainder.
+   */
+  UArbInt::_DigT UArbInt::s_divLimbs (_DigsT& l, _DigT const r) {
+    
+    // Long division, one limb at a time from the top.
+    OpCounters::add(OpCounters::DIGIT_OPS, l.size());
+    _DLimbT rem = 0;
+    for (_DigsT::reverse_iterator i = l.rbegin(); i != l.rend(); ++i) {
+      rem = (rem << s_limbbits) | *i;
+      *i  = static_cast<_DigT>(rem / r);
+      rem = rem % r;
+    }
+    s_trimZerosE(l);
+    
+    // Done.
+    return static_cast<_DigT>(rem);
+    
+  }
+  
+  /*
+   * Multiply limb strings, picking an algorithm by operand size.
+   */
+  void UArbInt::s_mulLimbs (_DigsT& product, _DigsT const& l, _DigsT const& r) {
+    
+    // Work with the longer operand on the left.
+    if (l.size() < r.size()) {
+      s_mulLimbs(product, r, l);
+      return;
+    }
+    
+    // Zero.
+    if (r.empty()) {
+      product.clear();
+      return;
+    }
+    
+    // Small operands go schoolbook.
+    if (r.size() < karatsuba_threshold) {
+      s_mulSchool(product, l, r);
+      return;
+    }
+    
+    // Badly unbalanced operands are sliced into r-sized pieces of l so that
+    // every sub-multiply is balanced.
+    if (l.size() >= (r.size() << 1)) {
+      _DigsT piece;
+      _DigsT piecepro;
+      product.clear();
+      for (_DigsT::size_type i = 0; i < l.size(); i += r.size()) {
+        piece.assign(l.begin() + i, l.begin() + min(i + r.size(), l.size()));
+        s_trimZerosE(piece);
+        s_mulLimbs(piecepro, piece, r);
+        s_addLimbs(product, piecepro, i);
+      }
+      return;
+    }
+    
+    // Balanced operands. Toom-3 needs r to reach into l's top third.
+    if (r.size() < toom3_threshold || r.size() <= (((l.size() + 2) / 3) << 1)) {
+      s_mulKaratsuba(product, l, r);
+    } else {
+      s_mulToom3(product, l, r);
+    }
+    
+  }
+  
+  /*
+   * Schoolbook multiplication.
+   */
+  void UArbInt::s_mulSchool (_DigsT& product, _DigsT const& l, _DigsT const& r) {
+    
+    // Each row is accumulated with a double-width carry, which can hold
+    // limb * limb + limb + carry without overflowing, so carries are only
+    // resolved once per limb instead of digit by digit.
+    OpCounters::add(OpCounters::DIGIT_OPS, l.size() * r.size());
+    product.assign(l.size() + r.size(), 0);
+    for (_DigsT::size_type i = 0; i != l.size(); ++i) {
+      _DLimbT li    = l[i];
+      _DLimbT carry = 0;
+      if (!li) {
+        continue;
+      }
+      for (_DigsT::size_type j = 0; j != r.size(); ++j) {
+        carry          += li * r[j] + product[i + j];
+        product[i + j]  = static_cast<_DigT>(carry);
+        carry         >>= s_limbbits;
+      }
+      product[i + r.size()] = static_cast<_DigT>(carry);
+    }
+    s_trimZerosE(product);
+    
+  }
+  
+  /*
+   * Karatsuba multiplication. l is at least as long as r.
+   */
+  void UArbInt::s_mulKaratsuba (_DigsT& product, _DigsT const& l, _DigsT const& r) {
+    
+    // Split both operands at half of l.
+    _DigsT::size_type half = (l.size() + 1) >> 1;
+    _DigsT l0(l.begin(), l.begin() + half);
+    _DigsT l1(l.begin() + half, l.end());
+    _DigsT r0(r.begin(), r.begin() + min(half, r.size()));
+    _DigsT r1(r.begin() + min(half, r.size()), r.end());
+    s_trimZerosE(l0);
+    s_trimZerosE(r0);
+    
+    // z0 = l0 * r0, z2 = l1 * r1, z1 = (l0 + l1) * (r0 + r1) - z0 - z2.
+    _DigsT z0;
+    _DigsT z1;
+    _DigsT z2;
+    s_mulLimbs(z0, l0, r0);
+    s_mulLimbs(z2, l1, r1);
+    s_addLimbs(l0, l1);
+    s_addLimbs(r0, r1);
+    s_mulLimbs(z1, l0, r0);
+    s_subLimbs(z1, z0);
+    s_subLimbs(z1, z2);
+    
+    // Recombine.
+    product.swap(z0);
+    s_addLimbs(product, z2, half << 1);
+    s_addLimbs(product, z1, half     );
+    
+  }
+  
+  /*
+   * Toom-3 multiplication. l is at least as long as r, and r is longer than
+   * two thirds of l.
+   */
+  void UArbInt::s_mulToom3 (_DigsT& product, _DigsT const& l, _DigsT const& r) {
+    
+    // Split both operands into thirds of l.
+    _DigsT::size_type third = (l.size() + 2) / 3;
+    _DigsT l0(l.begin()            , l.begin() + third     );
+    _DigsT l1(l.begin() + third    , l.begin() + third * 2 );
+    _DigsT l2(l.begin() + third * 2, l.end()               );
+    _DigsT r0(r.begin()            , r.begin() + third     );
+    _DigsT r1(r.begin() + third    , r.begin() + third * 2 );
+    _DigsT r2(r.begin() + third * 2, r.end()               );
+    s_trimZerosE(l0);
+    s_trimZerosE(l1);
+    s_trimZerosE(r0);
+    s_trimZerosE(r1);
+    
+    // Evaluate both polynomials at 0, 1, -1, -2 and infinity.
+    _DigsT lp1, lm1, lm2;
+    _DigsT rp1, rm1, rm2;
+    bool   lm1neg, lm2neg;
+    bool   rm1neg, rm2neg;
+    s_toom3Eval(l0, l1, l2, lp1, lm1, lm1neg, lm2, lm2neg);
+    s_toom3Eval(r0, r1, r2, rp1, rm1, rm1neg, rm2, rm2neg);
+    
+    // Pointwise products.
+    _DigsT v0, v1, vm1, vm2, vinf;
+    s_mulLimbs(v0  , l0 , r0 );
+    s_mulLimbs(v1  , lp1, rp1);
+    s_mulLimbs(vm1 , lm1, rm1);
+    s_mulLimbs(vm2 , lm2, rm2);
+    s_mulLimbs(vinf, l2 , r2 );
+    bool vm1neg = (lm1neg != rm1neg) && !vm1.empty();
+    bool vm2neg = (lm2neg != rm2neg) && !vm2.empty();
+    
+    // Interpolate, Bodrato's sequence. All divisions are exact.
+    //   c3 = (v(-2) - v(1)) / 3
+    //   c1 = (v(1) - v(-1)) / 2
+    //   c2 = v(-1) - v(0)
+    //   c3 = (c2 - c3) / 2 + 2 * v(inf)
+    //   c2 = c2 + c1 - v(inf)
+    //   c1 = c1 - c3
+    _DigsT c1(v1);
+    _DigsT c2(vm1);
+    _DigsT c3(vm2);
+    bool   c1neg = false;
+    bool   c2neg = vm1neg;
+    bool   c3neg = vm2neg;
+    s_addSigned(c3, c3neg, v1, true);
+    s_divLimbs(c3, 3);
+    s_addSigned(c1, c1neg, vm1, !vm1neg);
+    s_shrLimbs(c1, 1);
+    s_addSigned(c2, c2neg, v0, true);
+    {
+      _DigsT tmp(c2);
+      bool   tmpneg = c2neg;
+      _DigsT twoinf(vinf);
+      s_addSigned(tmp, tmpneg, c3, !c3neg);
+      s_shrLimbs(tmp, 1);
+      s_shlLimbs(twoinf, 1);
+      s_addSigned(tmp, tmpneg, twoinf, false);
+      c3.swap(tmp);
+      c3neg = tmpneg;
+    }
+    s_addSigned(c2, c2neg, c1, c1neg);
+    s_addSigned(c2, c2neg, vinf, true);
+    s_addSigned(c1, c1neg, c3, !c3neg);
+    
+    // The coefficients of a product of non-negative polynomials cannot be
+    // negative. If one is, something above is broken.
+    if (c1neg || c2neg || c3neg) {
+      throw Errors::Overrun();
+    }
+    
+    // Recombine.
+    product.swap(v0);
+    s_addLimbs(product, c1  , third    );
+    s_addLimbs(product, c2  , third * 2);
+    s_addLimbs(product, c3  , third * 3);
+    s_addLimbs(product, vinf, third * 4);
+    
+  }
+  
+  /*
+   * Evaluate a three-part Toom polynomial at 1, -1 and -2.
+   */
+  void UArbInt::s_toom3Eval (_DigsT const& x0, _DigsT const& x1, _DigsT const& x2, _DigsT& p1, _DigsT& m1, bool& m1neg, _DigsT& m2, bool& m2neg) {
+    
+    // x(1) = x0 + x2 + x1, x(-1) = x0 + x2 - x1.
+    _DigsT even(x0);
+    s_addLimbs(even, x2);
+    p1 = even;
+    s_addLimbs(p1, x1);
+    m1    = even;
+    m1neg = false;
+    s_addSigned(m1, m1neg, x1, true);
+    
+    // x(-2) = (x(-1) + x2) * 2 - x0.
+    m2    = m1;
+    m2neg = m1neg;
+    s_addSigned(m2, m2neg, x2, false);
+    s_shlLimbs(m2, 1);
+    s_addSigned(m2, m2neg, x0, true);
+    
+  }
+  
+  /*
+   * Divide limb strings, picking an algorithm by operand size.
+   */
+  void UArbInt::s_divModLimbs (_DigsT& quotient, _DigsT& remainder, _DigsT const& l, _DigsT const& r) {
+    
+    // Cannot divide by zero.
+    if (r.empty()) {
+      throw Errors::DivByZero();
+    }
+    
+    // Divisor larger than dividend, quotient is zero.
+    if (s_cmpLimbs(l, r) < 0) {
+      quotient.clear();
+      remainder = l;
+      return;
+    }
+    
+    // Single-limb divisor, the machine does all the work.
+    if (r.size() == 1) {
+      quotient = l;
+      _DigT rem = s_divLimbs(quotient, r[0]);
+      remainder.clear();
+      if (rem) {
+        remainder.push_back(rem);
+      }
+      return;
+    }
+    
+    // Large divisor and large quotient, multiply by the reciprocal.
+    // Otherwise long division.
+    if (r.size() >= newton_threshold && (l.size() - r.size()) >= newton_threshold) {
+      s_divNewton(quotient, remainder, l, r);
+    } else {
+      s_divKnuth(quotient, remainder, l, r);
+    }
+    
+  }
+  
+  /*
+   * Knuth's Algorithm D, TAOCP 4.3.1. r is at least two limbs, l is at
+   * least as long as r.
+   */
+  void UArbInt::s_divKnuth (_DigsT& quotient, _DigsT& remainder, _DigsT const& l, _DigsT const& r) {
+    
+    // Work area.
+    _DigsT::size_type const n    = r.size();
+    _DigsT::size_type const m    = l.size() - n;
+    _DLimbT           const base = static_cast<_DLimbT>(1) << s_limbbits;
+    
+    // D1. Normalize so that the divisor's high bit is set. This keeps every
+    // quotient guess within two of the real quotient limb. The dividend
+    // gets an extra high-order limb to catch the shift.
+    unsigned int shift = 0;
+    for (_DigT top = r.back(); !(top >> (s_limbbits - 1)); top <<= 1) {
+      ++shift;
+    }
+    _DigsT v(r);
+    _DigsT u(l);
+    s_shlLimbs(v, shift);
+    s_shlLimbs(u, shift);
+    u.resize(l.size() + 1, 0);
+    _DLimbT const vtop  = v[n - 1];
+    _DLimbT const vnext = v[n - 2];
+    
+    // D2 - D7. Produce one quotient limb per iteration, high-order first,
+    // working in place on the dividend.
+    OpCounters::add(OpCounters::DIGIT_OPS, (m + 1) * n);
+    _DigsT q(m + 1, 0);
+    for (_DigsT::size_type j = m + 1; j-- != 0;) {
+      
+      // D3. Guess the quotient limb from the top two limbs of the dividend
+      // and top limb of the divisor, then correct it with the divisor's
+      // second limb. After this the guess is at most one too large.
+      _DLimbT num  = (static_cast<_DLimbT>(u[j + n]) << s_limbbits) | u[j + n - 1];
+      _DLimbT qhat = num / vtop;
+      _DLimbT rhat = num % vtop;
+      while (qhat >= base || qhat * vnext > ((rhat << s_limbbits) | u[j + n - 2])) {
+        --qhat;
+        rhat += vtop;
+        if (rhat >= base) {
+          break;
+        }
+      }
+      
+      // D4. Multiply and subtract. A wrapped result in the high half of the
+      // accumulator is a borrow.
+      _DLimbT carry  = 0;
+      _DLimbT borrow = 0;
+      for (_DigsT::size_type i = 0; i != n; ++i) {
+        _DLimbT prod = qhat * v[i] + carry;
+        carry = prod >> s_limbbits;
+        _DLimbT diff = static_cast<_DLimbT>(u[i + j]) - static_cast<_DigT>(prod) - borrow;
+        u[i + j] = static_cast<_DigT>(diff);
+        borrow   = (diff >> s_limbbits) ? 1 : 0;
+      }
+      _DLimbT diff = static_cast<_DLimbT>(u[j + n]) - carry - borrow;
+      u[j + n] = static_cast<_DigT>(diff);
+      
+      // D5, D6. If that went negative the guess was one too large, add one
+      // divisor back. The carry out of the top cancels the earlier borrow.
+      if (diff >> s_limbbits) {
+        --qhat;
+        carry = 0;
+        for (_DigsT::size_type i = 0; i != n; ++i) {
+          carry    += static_cast<_DLimbT>(u[i + j]) + v[i];
+          u[i + j]  = static_cast<_DigT>(carry);
+          carry   >>= s_limbbits;
+        }
+        u[j + n] += static_cast<_DigT>(carry);
+      }
+      
+      q[j] = static_cast<_DigT>(qhat);
+      
+    }
+    
+    // D8. What is left of the dividend is the normalized remainder.
+    u.resize(n);
+    s_trimZerosE(u);
+    s_shrLimbs(u, shift);
+    s_trimZerosE(q);
+    quotient.swap(q);
+    remainder.swap(u);
+    
+  }
+  
+  /*
+   * Divide by multiplying by a Newton reciprocal.
+   */
+  void UArbInt::s_divNewton (_DigsT& quotient, _DigsT& remainder, _DigsT const& l, _DigsT const& r) {
+    
+    // Work area.
+    _DigsT const one(1, 1);
+    _DigsT       recip;
+    _DigsT       prod;
+    _DigsT       q;
+    _DigsT       rem(l);
+    
+    // Estimate the quotient as l * (B^k / r) / B^k, with k the length of the
+    // dividend. Limbs of l below the quotient's precision change the
+    // estimate by less than one, so only the top of l is multiplied. The
+    // reciprocal is only approximate, so this is only within a few units of
+    // the real quotient.
+    _DigsT::size_type const k    = l.size();
+    _DigsT::size_type const prec = k - r.size() + 1;
+    _DigsT::size_type const drop = (k > prec + 2) ? k - (prec + 2) : 0;
+    s_recipLimbs(recip, r, k);
+    s_mulLimbs(prod, _DigsT(l.begin() + drop, l.end()), recip);
+    if (prod.size() > k - drop) {
+      q.assign(prod.begin() + (k - drop), prod.end());
+    }
+    
+    // Correct the estimate.
+    s_mulLimbs(prod, q, r);
+    while (s_cmpLimbs(prod, l) > 0) {
+      s_subLimbs(q, one);
+      s_subLimbs(prod, r);
+    }
+    s_subLimbs(rem, prod);
+    while (s_cmpLimbs(rem, r) >= 0) {
+      s_addLimbs(q, one);
+      s_subLimbs(rem, r);
+    }
+    
+    // Done.
+    quotient.swap(q);
+    remainder.swap(rem);
+    
+  }
+  
+  /*
+   * Approximate B^exp / r by Newton iteration. Each level works out a
+   * reciprocal at half the precision from the top half of r, then one
+   * Newton step, x + x * (B^exp - r * x) / B^exp, doubles the precision.
+   * The result is within a few units of the real value.
+   */
+  void UArbInt::s_recipLimbs (_DigsT& recip, _DigsT const& r, _DigsT::size_type const exp) {
+    
+    // Limbs of precision wanted in the result.
+    _DigsT::size_type const n    = r.size();
+    _DigsT::size_type const prec = exp - n + 1;
+    
+    // Low limbs of r beyond the precision wanted do not affect the result
+    // enough to matter, drop them.
+    if (n > prec + 2) {
+      _DigsT::size_type const drop = n - (prec + 2);
+      s_recipLimbs(recip, _DigsT(r.begin() + drop, r.end()), exp - drop);
+      return;
+    }
+    
+    // Short enough to divide directly.
+    if (prec < newton_threshold || prec < 4) {
+      _DigsT power(exp + 1, 0);
+      _DigsT rem;
+      power.back() = 1;
+      if (n == 1) {
+        recip.swap(power);
+        s_divLimbs(recip, r[0]);
+      } else {
+        s_divKnuth(recip, rem, power, r);
+      }
+      return;
+    }
+    
+    // Half-precision reciprocal from the top of r.
+    _DigsT::size_type const half = (prec >> 1) + 1;
+    _DigsT::size_type const drop = (n > half + 1) ? n - (half + 1) : 0;
+    _DigsT::size_type const up   = prec - half;
+    _DigsT                  y;
+    s_recipLimbs(y, _DigsT(r.begin() + drop, r.end()), (n - drop) + half - 1);
+    
+    // The estimate at full scale is y * B^up. Error is B^exp - r * y * B^up,
+    // and may be negative.
+    _DigsT err(exp + 1, 0);
+    _DigsT ry;
+    bool   errneg = false;
+    err.back() = 1;
+    s_mulLimbs(ry, r, y);
+    ry.insert(ry.begin(), up, 0);
+    s_addSigned(err, errneg, ry, true);
+    
+    // Correction is y * B^up * err / B^exp.
+    _DigsT corr;
+    s_mulLimbs(corr, y, err);
+    corr.erase(corr.begin(), corr.begin() + min(exp - up, corr.size()));
+    
+    // Apply it.
+    bool recipneg = false;
+    recip.swap(y);
+    recip.insert(recip.begin(), up, 0);
+    s_addSigned(recip, recipneg, corr, errneg);
+    
+  }
+  
+  /*
+   * Powers of a number base. Level 0 is the largest power of the base that
+   * fits in a limb, and each level after that is the square of the one
+   * below it. Levels are built on demand and never change once built, so
+   * one set is kept per base for the life of the process and shared between
+   * threads.
+   */
+  class UArbInt::_RadixPowers {
+    
+    public:
+      
+      // Get the powers of a base.
+      static _RadixPowers& get (_DigT const base);
+      
+      // Constructor.
+      _RadixPowers () : base(0), chunk(0), chunkdigits(0) {}
+      
+      // Get base^(chunkdigits * 2^level).
+      _DigsT const& power (_DigsT::size_type const level);
+      
+      // The base, and base^chunkdigits.
+      _DigT             base       ;
+      _DigT             chunk      ;
+      _DigsT::size_type chunkdigits;
+      
+    private:
+      
+      // Levels built so far. Elements of a deque stay put as it grows.
+      deque<_DigsT> _powers;
+      
+      // Guards _powers.
+      mutex _lock;
+    
+  };
+  
+  /*
+   * Get the powers of a base, creating them if this is the first use.
+   */
+  UArbInt::_RadixPowers& UArbInt::_RadixPowers::get (_DigT const base) {
+    
+    // Every base ever used.
+    static map<_DigT, _RadixPowers> cache;
+    static mutex                    lock ;
+    
+    // Find this base, setting it up if it is new.
+    lock_guard<mutex> guard(lock);
+    _RadixPowers& retval = cache[base];
+    if (!retval.chunkdigits) {
+      retval.base        = base;
+      retval.chunk       = base;
+      retval.chunkdigits = 1;
+      while (retval.chunk <= numeric_limits<_DigT>::max() / base) {
+        retval.chunk *= base;
+        ++retval.chunkdigits;
+      }
+      retval._powers.push_back(_DigsT(1, retval.chunk));
+    }
+    
+    // Done.
+    return retval;
+    
+  }
+  
+  /*
+   * Get base^(chunkdigits * 2^level), squaring up to it if needed.
+   */
+  UArbInt::_DigsT const& UArbInt::_RadixPowers::power (_DigsT::size_type const level) {
+    
+    lock_guard<mutex> guard(_lock);
+    while (_powers.size() <= level) {
+      _DigsT square;
+      s_mulLimbs(square, _powers.back(), _powers.back());
+      _powers.push_back(_DigsT());
+      _powers.back().swap(square);
+    }
+    return _powers[level];
+    
+  }
+  
+  /*
+   * Convert limbs to little-endian digits in the given base.
+   */
+  void UArbInt::s_toRadix (_DigsT& digits, _DigsT const& limbs, _DigT const base) {
+    
+    // Zero has no digits.
+    digits.clear();
+    if (limbs.empty()) {
+      return;
+    }
+    
+    // Start from the power closest to half the length of the number.
+    _RadixPowers&     powers = _RadixPowers::get(base);
+    _DigsT::size_type level  = 0;
+    if (limbs.size() >= baseconv_threshold) {
+      while ((powers.power(level).size() << 1) <= ((limbs.size() + 1) >> 1)) {
+        ++level;
+      }
+    }
+    
+    // Convert, then trim the high-order zeros of the last chunk.
+    s_toRadixSplit(digits, limbs, powers, level, 0);
+    s_trimZerosE(digits);
+    
+  }
+  
+  /*
+   * Convert limbs to digits, splitting by base^(chunkdigits * 2^level).
+   * Digits are appended low-order first, zero-padded to width digits if
+   * width is not 0.
+   */
+  void UArbInt::s_toRadixSplit (_DigsT& digits, _DigsT const& limbs, _RadixPowers& powers, _DigsT::size_type const level, _DigsT::size_type const width) {
+    
+    // Short numbers are divided by the largest power of the base that fits
+    // a limb, which yields a whole chunk of digits per machine division.
+    if (level == 0 || limbs.size() < baseconv_threshold) {
+      _Scratch          work;
+      _DigsT::size_type start(digits.size());
+      *work = limbs;
+      while (!work->empty()) {
+        _DigT chunk = s_divLimbs(*work, powers.chunk);
+        for (_DigsT::size_type i = 0; i != powers.chunkdigits; ++i) {
+          digits.push_back(chunk % powers.base);
+          chunk /= powers.base;
+        }
+      }
+      if (width) {
+        digits.resize(start + width, 0);
+      }
+      return;
+    }
+    
+    // Split. The remainder is exactly the low-order digits, so it is
+    // always padded out to the full width of the divisor. A quotient that
+    // is still not below the divisor is split again at this level.
+    _DigsT const&           divisor = powers.power(level);
+    _DigsT::size_type const step    = powers.chunkdigits << level;
+    _Scratch                quotient;
+    _Scratch                remainder;
+    s_divModLimbs(*quotient, *remainder, limbs, divisor);
+    s_toRadixSplit(digits, *remainder, powers, level - 1, step);
+    s_toRadixSplit(digits, *quotient, powers, (s_cmpLimbs(*quotient, divisor) < 0) ? level - 1 : level, width ? width - step : 0);
+    
+  }
+  
+  /*
+   * Convert little-endian digits in the given base to limbs.
+   */
+  void UArbInt::s_fromRadix (_DigsT& limbs, _DigsT const& digits, _DigT const base) {
+    
+    // Zero has no limbs.
+    limbs.clear();
+    if (digits.empty()) {
+      return;
+    }
+    
+    // Cut the digits into groups of 2^level chunks, with the group as close
+    // to baseconv_threshold limbs as possible without being longer than
+    // the whole number.
+    _RadixPowers&     powers = _RadixPowers::get(base);
+    _DigsT::size_type level  = 0;
+    while ((baseconv_threshold >> (level + 1)) != 0 && (powers.chunkdigits << level) < digits.size()) {
+      ++level;
+    }
+    _DigsT::size_type const groupdigits = powers.chunkdigits << level;
+    vector<_DigsT>          parts((digits.size() + groupdigits - 1) / groupdigits);
+    
+    // Evaluate each group by Horner's rule, one chunk at a time from the
+    // top. Only the highest chunk of the highest group can be short.
+    for (_DigsT::size_type i = 0; i != parts.size(); ++i) {
+      _DigsT::size_type const begin = i * groupdigits;
+      _DigsT::size_type const end   = min(digits.size(), begin + groupdigits);
+      for (_DigsT::size_type j = (end - begin + powers.chunkdigits - 1) / powers.chunkdigits; j != 0; --j) {
+        
+        // Gather the chunk.
+        _DigsT::size_type const cbegin = begin + (j - 1) * powers.chunkdigits;
+        _DigT                   chunk  = 0;
+        for (_DigsT::size_type k = min(end, cbegin + powers.chunkdigits); k != cbegin; --k) {
+          chunk = chunk * powers.base + digits[k - 1];
+        }
+        
+        // Shift the group up a chunk and add this one in.
+        _DLimbT carry = chunk;
+        for (_DigsT::iterator l = parts[i].begin(); l != parts[i].end(); ++l) {
+          carry += static_cast<_DLimbT>(*l) * powers.chunk;
+          *l     = static_cast<_DigT>(carry);
+          carry >>= s_limbbits;
+        }
+        if (carry) {
+          parts[i].push_back(static_cast<_DigT>(carry));
+        }
+        
+      }
+    }
+    
+    // Combine neighboring groups, high * base^(digits in low) + low, until
+    // there is one left.
+    _Scratch combined;
+    while (parts.size() > 1) {
+      _DigsT const& power = powers.power(level);
+      for (_DigsT::size_type i = 0; i + 1 < parts.size(); i += 2) {
+        s_mulLimbs(*combined, parts[i + 1], power);
+        s_addLimbs(*combined, parts[i]);
+        parts[i >> 1].swap(*combined);
+      }
+      if (parts.size() & 1) {
+        parts[parts.size() >> 1].swap(parts.back());
+      }
+      parts.resize((parts.size() + 1) >> 1);
+      ++level;
+    }
+    
+    // Done.
+    limbs.swap(parts.front());
+    
+  }
+  
+  /*
+   * Raise a base to a power, built from cached powers of the base.
+   */
+  void UArbInt::s_radixPow (_DigsT& limbs, _DigT const base, size_t const exponent) {
+    
+    // Digits that do not make up a whole chunk.
+    _RadixPowers& powers = _RadixPowers::get(base);
+    _DigT         tail   = 1;
+    for (size_t i = exponent % powers.chunkdigits; i != 0; --i) {
+      tail *= base;
+    }
+    limbs.assign(1, tail);
+    
+    // Whole chunks, one cached power for each set bit of the count.
+    _DigsT product;
+    _DigsT::size_type level = 0;
+    for (size_t chunks = exponent / powers.chunkdigits; chunks != 0; chunks >>= 1, ++level) {
+      if (chunks & 1) {
+        s_mulLimbs(product, limbs, powers.power(level));
+        limbs.swap(product);
+      }
+    }
+    
+  }
+  
+  /*
+   * Greatest common divisor of two limb strings. Lehmer's algorithm: run
+   * Euclid on the leading 62 bits of both numbers for as long as the
+   * quotients are sure to match the full numbers' quotients, then apply the
+   * whole run of steps to the full numbers at once.
+   */
+  void UArbInt::s_gcdLimbs (_DigsT& gcd, _DigsT const& l, _DigsT const& r) {
+    
+    // Work area, x is always the larger.
+    _DigsT x(l);
+    _DigsT y(r);
+    if (s_cmpLimbs(x, y) < 0) {
+      x.swap(y);
+    }
+    _DigsT quotient;
+    _DigsT remainder;
+    
+    while (!y.empty()) {
+      
+      // Each pass is one step, whether of Lehmer or of Euclid.
+      OpCounters::add(OpCounters::GCD_STEPS);
+      
+      // Finish in machine words once both numbers fit.
+      if (x.size() <= 2) {
+        _DLimbT xw = x[0] | ((x.size() > 1) ? static_cast<_DLimbT>(x[1]) << s_limbbits : 0);
+        _DLimbT yw = y[0] | ((y.size() > 1) ? static_cast<_DLimbT>(y[1]) << s_limbbits : 0);
+        while (yw) {
+          _DLimbT tmp = xw % yw;
+          xw = yw;
+          yw = tmp;
+        }
+        x.assign(1, static_cast<_DigT>(xw));
+        if (xw >> s_limbbits) {
+          x.push_back(static_cast<_DigT>(xw >> s_limbbits));
+        }
+        break;
+      }
+      
+      // Leading 62 bits of x, and the bits of y in the same positions.
+      _DigsT::size_type const shift = x.size() * s_limbbits - (s_limbbits - SafeInt<_DigT>(x.back()).bitsInNumber()) - 62;
+      long long               xh    = static_cast<long long>(s_bitsAt(x, shift) & ((static_cast<_DLimbT>(1) << 62) - 1));
+      long long               yh    = static_cast<long long>(s_bitsAt(y, shift) & ((static_cast<_DLimbT>(1) << 62) - 1));
+      
+      // Euclid on the leading bits. (xh + a) / (yh + c) and
+      // (xh + b) / (yh + d) bracket the true quotient, stop as soon as they
+      // disagree.
+      long long a = 1;
+      long long b = 0;
+      long long c = 0;
+      long long d = 1;
+      while (yh + c > 0 && yh + d > 0) {
+        long long const q = (xh + a) / (yh + c);
+        if (q != (xh + b) / (yh + d)) {
+          break;
+        }
+        long long tmp;
+        tmp = a  - q * c ; a  = c ; c  = tmp;
+        tmp = b  - q * d ; b  = d ; d  = tmp;
+        tmp = xh - q * yh; xh = yh; yh = tmp;
+      }
+      
+      // The leading bits did not pin down even one quotient, so take a full
+      // step of Euclid. Otherwise apply all the steps found at once.
+      if (b == 0) {
+        s_divModLimbs(quotient, remainder, x, y);
+        x.swap(y);
+        y.swap(remainder);
+      } else {
+        s_gcdCofactor(quotient,  x, a, y, b);
+        s_gcdCofactor(remainder, x, c, y, d);
+        x.swap(quotient);
+        y.swap(remainder);
+      }
+      
+    }
+    
+    // Done.
+    gcd.swap(x);
+    
+  }
+  
+  /*
+   * Get the 64 bits of a limb string starting at a given bit.
+   */
+  UArbInt::_DLimbT UArbInt::s_bitsAt (_DigsT const& l, _DigsT::size_type const shift) {
+    
+    // Window of three limbs, anything past the end is 0.
+    _DigsT::size_type const pos    = shift / s_limbbits;
+    unsigned int      const offset = shift % s_limbbits;
+    _DLimbT                 window[3];
+    for (_DigsT::size_type i = 0; i != 3; ++i) {
+      window[i] = (pos + i < l.size()) ? l[pos + i] : 0;
+    }
+    
+    // Shift the window down into place.
+    _DLimbT retval = (window[0] | (window[1] << s_limbbits)) >> offset;
+    if (offset) {
+      retval |= window[2] << ((s_limbbits << 1) - offset);
+    }
+    return retval;
+    
+  }
+  
+  /*
+   * Find a * x + b * y, which must not be negative.
+   */
+  void UArbInt::s_gcdCofactor (_DigsT& result, _DigsT const& x, long long const a, _DigsT const& y, long long const b) {
+    
+    // Split each term by sign, and multiply by the cofactor's magnitude.
+    _DigsT positive;
+    _DigsT negative;
+    _DigsT term;
+    _DigsT cofactor;
+    for (int i = 0; i != 2; ++i) {
+      long long const f = i ? b : a;
+      _DLimbT         m = static_cast<_DLimbT>(f < 0 ? -f : f);
+      cofactor.clear();
+      for (; m; m >>= s_limbbits) {
+        cofactor.push_back(static_cast<_DigT>(m));
+      }
+      s_mulLimbs(term, i ? y : x, cofactor);
+      s_addLimbs((f < 0) ? negative : positive, term);
+    }
+    
+    // Combine.
+    s_subLimbs(positive, negative);
+    result.swap(positive);
+    
+  }
+  
+  /*
+   * Integer nth root by Newton's method, with precision doubling. Dropping
+   * the low n * k bits of x and taking the root gives the high bits of the
+   * root of x, so recursing on half of the root's bits gives a starting point
+   * that is off by no more than 2^k, and Newton's method doubles that to the
+   * full root in one or two steps at each level.
+   */
+  UArbInt UArbInt::s_iroot (UArbInt const& x, size_t const n) {
+    
+    // Work area.
+    UArbInt guess;
+    UArbInt next;
+    UArbInt nmo(n - 1);
+    
+    // Roots of 0 and 1.
+    if (x <= 1) {
+      return x;
+    }
+    
+    // Start from above the root. The root has at most this many bits.
+    size_t const rootbits = (x.bitsInNumber().Value<size_t>() + n - 1) / n;
+    if (rootbits <= s_digitbits) {
+      guess = UArbInt(1) << rootbits;
+    } else {
+      size_t const k = rootbits >> 1;
+      guess   = s_iroot(x >> (k * n), n) + 1;
+      guess <<= k;
+    }
+    
+    // Newton's method falls toward the root from above, and stops falling
+    // once it reaches it.
+    while (true) {
+      next = (guess * nmo + x / guess.pow(nmo)) / n;
+      if (next >= guess) {
+        break;
+      }
+      guess.swap(next);
+    }
+    
+    // Done.
+    return guess;
+    
+  }
+  
+  /*
+   * Greatest common divisor.
+   */
+  template <> UArbInt gcd<UArbInt> (UArbInt const& n1, UArbInt const& n2) {
+    
+    // Work area.
+    UArbInt         retval;
+    UArbInt::_DigsT l;
+    UArbInt::_DigsT r;
+    UArbInt::_DigsT g;
+    
+    // Nothing to it.
+    UArbInt::s_toLimbs(n1._digits, l);
+    UArbInt::s_toLimbs(n2._digits, r);
+    UArbInt::s_gcdLimbs(g, l, r);
+    UArbInt::s_fromLimbs(g, retval._digits);
+    
+    // Done.
+    return retval;
+    
+  }
+  
   /***************************************************************************
    * ArbInt
    ***************************************************************************/
@@ -1049,6 +2161,31 @@ namespace DAC {
     
   }
   
+  /*
+   * Divide, getting both the quotient and remainder. Quotient is truncated
+   * toward zero, remainder takes the sign of the dividend.
+   */
+  void ArbInt::divmod (ArbInt const& number, ArbInt& quotient, ArbInt& remainder) const {
+    
+    // No divide by zero.
+    if (!number) {
+      throw Errors::DivByZero();
+    }
+    
+    // Work out the signs before any results are written, either result may
+    // be this or number.
+    bool qsign = _sign != number._sign;
+    bool rsign = _sign;
+    
+    // Divide.
+    _digits.divmod(number._digits, quotient._digits, remainder._digits);
+    quotient ._sign = qsign;
+    remainder._sign = rsign;
+    quotient ._check_sign();
+    remainder._check_sign();
+    
+  }
+  
   /*
    * Modulo divide.
    */
@@ -1173,14 +2310,8 @@ namespace DAC {
   int ArbInt::op_compare (ArbInt const& number) const {
     
     // Check signs first.
-    if (_sign) {
-      if (number._sign) {
-        return -1;
-      }
-    } else {
-      if (!number._sign) {
-        return 1;
-      }
+    if (_sign != number._sign) {
+      return _sign ? -1 : 1;
     }
     
     // Signs are the same, compare numbers.
@@ -20,6 +20,8 @@
   #include <SafeInt.h++>
   #include <to_string.h++>
   #include <rppower.h++>
+  #include <gcd.h++>
+  #include <SmallVector.h++>
   #include <Exception.h++>
   #include <NumInfo.h++>
 
@@ -62,6 +64,34 @@ namespace DAC {
       // Maximum input base.
       static value_type const max_input_base;
       
+      /***********************************************************************/
+      // Tuning.
+      
+      // Multiplication cutoffs, in full-width limbs. Operands shorter than
+      // karatsuba_threshold are multiplied schoolbook, operands shorter than
+      // toom3_threshold use Karatsuba, and anything longer uses Toom-3.
+      static size_t karatsuba_threshold;
+      static size_t toom3_threshold;
+      
+      // Division cutoff, in full-width limbs. When both the divisor and the
+      // quotient are at least this long, division multiplies by a Newton
+      // reciprocal instead of running Knuth's long division.
+      static size_t newton_threshold;
+      
+      // Base conversion cutoff, in full-width limbs. Numbers at least this
+      // long are split in half by a cached power of the base and each half
+      // converted on its own, anything shorter is converted a limb-sized
+      // chunk of digits at a time.
+      static size_t baseconv_threshold;
+      
+      // Scratch arena limit, in full-width limbs. The temporaries of
+      // multiplication, division and base conversion are taken from and
+      // given back to a small per-thread pool, so large operations in a row
+      // reuse each other's storage instead of allocating their own.
+      // Temporaries longer than this are freed instead of pooled, and 0
+      // turns the pool off.
+      static size_t scratch_limit;
+      
       /***********************************************************************/
       // Errors
       class Errors {
@@ -124,8 +154,9 @@ namespace DAC {
       // Default constructor.
       UArbInt ();
       
-      // Copy constructor.
+      // Copy and move constructors. A moved-from number is 0.
       UArbInt (UArbInt const& number);
+      UArbInt (UArbInt&&      number);
       
       // Conversion constructor.
                          explicit UArbInt (std::string const& number);
@@ -159,6 +190,7 @@ namespace DAC {
       
       // Assignment operator.
                          UArbInt& operator = (UArbInt     const& number);
+                         UArbInt& operator = (UArbInt&&          number);
                          UArbInt& operator = (std::string const& number);
       template <class T> UArbInt& operator = (T           const  number);
       
@@ -187,7 +219,15 @@ namespace DAC {
       template <class T> UArbInt& setBitwise (SafeInt<T> const number);
       template <class T> UArbInt& setBitwise (T          const number);
       
-      // Push digits into this number.
+      // Set this number to a power of a number base.
+      UArbInt& setBasePow (value_type const base, size_t const exponent);
+      
+      // Set from or get as a little-endian sequence of digits in any base.
+      template <class T> UArbInt& setDigits (T const& digits, value_type const base);
+      template <class T> T&       getDigits (T&       digits, value_type const base) const;
+      
+      // Push digits into this number. Strings are digits in this number's
+      // base, a leading 0 or 0x is not read as a base prefix.
                          void push_back (UArbInt     const& number);
                          void push_back (std::string const& number);
       template <class T> void push_back (SafeInt<T>  const  number);
@@ -214,6 +254,9 @@ namespace DAC {
       template <class T> UArbInt& op_sub (SafeInt<T> const  number                              );
       template <class T> UArbInt& op_sub (T          const  number                              );
       
+      // Divide, getting both the quotient and remainder in one pass.
+      void divmod (UArbInt const& number, UArbInt& quotient, UArbInt& remainder) const;
+      
       // Bit shift operator backends.
                          UArbInt& op_shl (UArbInt    const& number);
       template <class T> UArbInt& op_shl (SafeInt<T> const  number);
@@ -270,6 +313,11 @@ namespace DAC {
                          UArbInt pow (UArbInt const& exp) const;
       template <class T> UArbInt pow (T       const  exp) const;
       
+      // Find the integer part of a root of this number.
+                         UArbInt iroot (UArbInt const& n) const;
+      template <class T> UArbInt iroot (T       const  n) const;
+                         UArbInt isqrt ()                 const;
+      
       // Access a specific digit.
       value_type get_digit (size_t const digit) const;
       
@@ -277,6 +325,9 @@ namespace DAC {
       bool get_bit (UArbInt const& bit                  ) const;
       bool get_bit (size_t const digit, size_t const bit) const;
       
+      // Greatest common divisor works on the digits directly.
+      friend UArbInt gcd<UArbInt> (UArbInt const& n1, UArbInt const& n2);
+      
     /*
      * Private members.
      */
@@ -290,8 +341,18 @@ namespace DAC {
       
       typedef std::vector<_NumChrT> _DigStrT; // String of character
                                               // digits.
-      typedef std::vector<_DigT>    _DigsT;   // String of native
-                                              // digits.
+      typedef SmallVector<_DigT, 8>       _DigsT;       // String of native
+                                                        // digits, up to 8 of
+                                                        // them held inline.
+      typedef SmallVector<_DigT, 8, true> _SharedDigsT; // Same, but longer
+                                                        // ones are shared
+                                                        // until written.
+      
+      // Double-width accumulator for full-width limb arithmetic. Limbs are
+      // native digits packed two to a _DigT, so this must be able to hold
+      // the product of two full _DigTs.
+      typedef unsigned long long _DLimbT;
+      static_assert(std::numeric_limits<_DLimbT>::digits >= 2 * std::numeric_limits<_DigT>::digits, "_DLimbT must be at least twice the width of _DigT.");
       
       /***********************************************************************/
       // Data types.
@@ -402,8 +463,11 @@ namespace DAC {
       /***********************************************************************/
       // Data members.
       
-      // The number.
-      _DigsT _digits;
+      // The number. Copies share digits until one of them changes. Digits
+      // are never handed out, and a reference or pointer from non-const
+      // access is only held within one function, never across a copy of
+      // the number it points into.
+      _SharedDigsT _digits;
       
       // The default base of this number.
       _DigT _base;
@@ -415,6 +479,7 @@ namespace DAC {
       // Static data members.
       
       static unsigned int const s_digitbits; // Number of bits in a digit.
+      static unsigned int const s_limbbits ; // Number of bits in a limb.
       static _DigT        const s_digitbase; // Base of native digits.
       static _DigT        const s_bitmask  ; // Bitmask of digits.
       
@@ -450,8 +515,59 @@ namespace DAC {
       // Do long division on a given container. Returns the remainder.
       template <class DivndT, class DivorT> static DivorT s_longDiv (DivndT& divnd, DivorT const divor, value_type const base);
       
-      // Convert a container from one base to another.
-      template <class FT, class TT> static void s_baseConv (FT const& from, value_type const frombase, TT& to, value_type const tobase);
+      // Convert between native digits and full-width limbs.
+      static void s_toLimbs   (_SharedDigsT const& digits, _DigsT&       limbs );
+      static void s_fromLimbs (_DigsT       const& limbs,  _SharedDigsT& digits);
+      
+      // Full-width limb arithmetic. Limb strings are little-endian and kept
+      // free of high-order zeros.
+      static int   s_cmpLimbs   (_DigsT const& l, _DigsT const& r);
+      static void  s_addLimbs   (_DigsT& l, _DigsT const& r, _DigsT::size_type const offset = 0);
+      static void  s_subLimbs   (_DigsT& l, _DigsT const& r);
+      static void  s_addSigned  (_DigsT& l, bool& lneg, _DigsT const& r, bool const rneg);
+      static void  s_shlLimbs   (_DigsT& l, unsigned int const bits);
+      static void  s_shrLimbs   (_DigsT& l, unsigned int const bits);
+      static _DigT s_divLimbs   (_DigsT& l, _DigT const r);
+      
+      // Full-width limb multiplication. Product must not alias either
+      // operand.
+      static void s_mulLimbs     (_DigsT& product, _DigsT const& l, _DigsT const& r);
+      static void s_mulSchool    (_DigsT& product, _DigsT const& l, _DigsT const& r);
+      static void s_mulKaratsuba (_DigsT& product, _DigsT const& l, _DigsT const& r);
+      static void s_mulToom3     (_DigsT& product, _DigsT const& l, _DigsT const& r);
+      static void s_toom3Eval    (_DigsT const& x0, _DigsT const& x1, _DigsT const& x2, _DigsT& p1, _DigsT& m1, bool& m1neg, _DigsT& m2, bool& m2neg);
+      
+      // Full-width limb division. Quotient and remainder must not alias
+      // either operand.
+      static void s_divModLimbs (_DigsT& quotient, _DigsT& remainder, _DigsT const& l, _DigsT const& r);
+      static void s_divKnuth    (_DigsT& quotient, _DigsT& remainder, _DigsT const& l, _DigsT const& r);
+      static void s_divNewton   (_DigsT& quotient, _DigsT& remainder, _DigsT const& l, _DigsT const& r);
+      
+      // Approximate B^exp / r, where B is the limb base, by Newton iteration.
+      static void s_recipLimbs (_DigsT& recip, _DigsT const& r, _DigsT::size_type const exp);
+      
+      // Powers of a number base, shared by every conversion in that base.
+      class _RadixPowers;
+      
+      // A limb string borrowed from the per-thread scratch arena.
+      class _Scratch;
+      
+      // Convert between full-width limbs and little-endian digits in an
+      // arbitrary base. Digits must be trimmed and within the base.
+      static void s_toRadix   (_DigsT& digits, _DigsT const& limbs,  _DigT const base);
+      static void s_fromRadix (_DigsT& limbs,  _DigsT const& digits, _DigT const base);
+      static void s_radixPow  (_DigsT& limbs,  _DigT const base, size_t const exponent);
+      
+      // Recursive step of s_toRadix. Output is padded to width digits.
+      static void s_toRadixSplit (_DigsT& digits, _DigsT const& limbs, _RadixPowers& powers, _DigsT::size_type const level, _DigsT::size_type const width);
+      
+      // Integer nth root, n less than the number of bits in x.
+      static UArbInt s_iroot (UArbInt const& x, size_t const n);
+      
+      // Greatest common divisor of limb strings by Lehmer's algorithm.
+      static void    s_gcdLimbs    (_DigsT& gcd, _DigsT const& l, _DigsT const& r);
+      static void    s_gcdCofactor (_DigsT& result, _DigsT const& x, long long const a, _DigsT const& y, long long const b);
+      static _DLimbT s_bitsAt      (_DigsT const& l, _DigsT::size_type const shift);
       
   };
   
@@ -533,11 +649,13 @@ namespace DAC {
       // Default constructor.
       ArbInt ();
       
-      // Copy constructor.
+      // Copy and move constructors. A moved-from number is 0.
       ArbInt (ArbInt const& number);
+      ArbInt (ArbInt&&      number);
       
       // Conversion constructor.
                          explicit ArbInt (UArbInt     const& number);
+                         explicit ArbInt (UArbInt&&          number);
                          explicit ArbInt (std::string const& number);
       template <class T> explicit ArbInt (T           const  number);
       
@@ -570,6 +688,7 @@ namespace DAC {
       
       // Assignment operator.
                          ArbInt& operator = (ArbInt      const& number);
+                         ArbInt& operator = (ArbInt&&           number);
                          ArbInt& operator = (UArbInt     const& number);
                          ArbInt& operator = (std::string const& number);
       template <class T> ArbInt& operator = (T           const  number);
@@ -600,7 +719,7 @@ namespace DAC {
       template <class T> ArbInt& setBitwise (SafeInt<T> const number);
       template <class T> ArbInt& setBitwise (T          const number);
       
-      // Push digits into this number.
+      // Push digits into this number, same as UArbInt.
                          void push_back (ArbInt      const& number);
                          void push_back (UArbInt     const& number);
                          void push_back (std::string const& number);
@@ -633,6 +752,9 @@ namespace DAC {
       template <class T> ArbInt& op_sub (SafeInt<T> const  number                             );
       template <class T> ArbInt& op_sub (T          const  number                             );
       
+      // Divide, getting both the quotient and remainder in one pass.
+      void divmod (ArbInt const& number, ArbInt& quotient, ArbInt& remainder) const;
+      
       // Bit shift operator backends.
                          ArbInt& op_shl (ArbInt     const& number);
                          ArbInt& op_shl (UArbInt    const& number);
@@ -857,89 +979,145 @@ namespace DAC {
   
   // Arithmetic operators.
                      UArbInt operator * (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator * (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator * (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator * (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator * (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator * (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator * (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator * (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator * (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator * (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator * (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator * (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator * (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator * (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator * (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator * (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator * (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator * (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator * (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator * (T          const  l, ArbInt     const& r);
                      UArbInt operator / (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator / (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator / (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator / (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator / (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator / (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator / (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator / (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator / (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator / (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator / (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator / (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator / (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator / (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator / (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator / (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator / (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator / (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator / (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator / (T          const  l, ArbInt     const& r);
                      UArbInt operator % (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator % (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator % (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator % (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator % (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator % (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator % (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator % (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator % (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator % (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator % (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator % (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator % (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator % (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator % (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator % (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator % (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator % (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator % (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator % (T          const  l, ArbInt     const& r);
                      UArbInt operator + (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator + (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator + (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator + (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator + (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator + (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator + (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator + (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator + (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator + (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator + (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator + (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator + (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator + (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator + (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator + (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator + (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator + (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator + (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator + (T          const  l, ArbInt     const& r);
                      UArbInt operator - (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator - (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator - (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator - (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator - (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator - (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator - (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator - (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator - (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator - (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator - (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator - (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator - (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator - (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator - (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator - (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator - (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator - (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator - (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator - (T          const  l, ArbInt     const& r);
   
   // Bit shift operators.
                      UArbInt operator << (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator << (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator << (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator << (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator << (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator << (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator << (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator << (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator << (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator << (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator << (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator << (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator << (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator << (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator << (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator << (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator << (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator << (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator << (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator << (T          const  l, ArbInt     const& r);
                      UArbInt operator >> (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator >> (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator >> (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator >> (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator >> (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator >> (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator >> (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator >> (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator >> (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator >> (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator >> (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator >> (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator >> (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator >> (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator >> (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator >> (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator >> (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator >> (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator >> (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator >> (T          const  l, ArbInt     const& r);
   
@@ -1019,39 +1197,63 @@ namespace DAC {
   
   // Bitwise operators.
                      UArbInt operator & (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator & (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator & (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator & (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator & (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator & (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator & (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator & (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator & (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator & (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator & (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator & (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator & (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator & (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator & (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator & (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator & (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator & (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator & (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator & (T          const  l, ArbInt     const& r);
                      UArbInt operator | (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator | (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator | (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator | (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator | (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator | (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator | (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator | (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator | (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator | (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator | (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator | (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator | (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator | (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator | (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator | (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator | (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator | (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator | (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator | (T          const  l, ArbInt     const& r);
                      UArbInt operator ^ (UArbInt    const& l, UArbInt    const& r);
+                     UArbInt operator ^ (UArbInt&&         l, UArbInt    const& r);
                      ArbInt  operator ^ (ArbInt     const& l, ArbInt     const& r);
+                     ArbInt  operator ^ (ArbInt&&          l, ArbInt     const& r);
                      ArbInt  operator ^ (UArbInt    const& l, ArbInt     const& r);
+                     ArbInt  operator ^ (UArbInt&&         l, ArbInt     const& r);
                      ArbInt  operator ^ (ArbInt     const& l, UArbInt    const& r);
+                     ArbInt  operator ^ (ArbInt&&          l, UArbInt    const& r);
   template <class T> UArbInt operator ^ (UArbInt    const& l, SafeInt<T> const  r);
+  template <class T> UArbInt operator ^ (UArbInt&&         l, SafeInt<T> const  r);
   template <class T> ArbInt  operator ^ (ArbInt     const& l, SafeInt<T> const  r);
+  template <class T> ArbInt  operator ^ (ArbInt&&          l, SafeInt<T> const  r);
   template <class T> UArbInt operator ^ (SafeInt<T> const  l, UArbInt    const& r);
   template <class T> ArbInt  operator ^ (SafeInt<T> const  l, ArbInt     const& r);
   template <class T> UArbInt operator ^ (UArbInt    const& l, T          const  r);
+  template <class T> UArbInt operator ^ (UArbInt&&         l, T          const  r);
   template <class T> ArbInt  operator ^ (ArbInt     const& l, T          const  r);
+  template <class T> ArbInt  operator ^ (ArbInt&&          l, T          const  r);
   template <class T> UArbInt operator ^ (T          const  l, UArbInt    const& r);
   template <class T> ArbInt  operator ^ (T          const  l, ArbInt     const& r);
   
@@ -1202,6 +1404,11 @@ namespace DAC {
    */
   inline UArbInt::UArbInt (UArbInt const& number) : _digits(number._digits), _base(number._base) {}
   
+  /*
+   * Move constructor.
+   */
+  inline UArbInt::UArbInt (UArbInt&& number) : _digits(std::move(number._digits)), _base(number._base) {}
+  
   /*
    * String conversion constructor.
    */
@@ -1249,7 +1456,8 @@ namespace DAC {
   /*
    * Assignment operator.
    */
-                     inline UArbInt& UArbInt::operator = (UArbInt     const& number) { set(number); return *this; }
+                     inline UArbInt& UArbInt::operator = (UArbInt     const& number) { set(number);                        return *this; }
+                     inline UArbInt& UArbInt::operator = (UArbInt&&          number) { _digits = std::move(number._digits); return *this; }
                      inline UArbInt& UArbInt::operator = (std::string const& number) { set(number); return *this; }
   template <class T> inline UArbInt& UArbInt::operator = (T           const  number) { set(number); return *this; }
   
@@ -1266,7 +1474,7 @@ namespace DAC {
     SafeInt<T> mag   (1);
     for (typename _DigsT::const_iterator i = _digits.begin(); i != _digits.end(); ++i) {
       try {
-        retval += *i * mag;
+        retval += mag * *i;
         if (i != _digits.end() - 1) {
           mag *= s_digitbase;
         }
@@ -1313,6 +1521,73 @@ namespace DAC {
   template <class T> UArbInt& UArbInt::setBitwise (SafeInt<T> const number) { _SetBitwise<T, NumType<T>::type>::op(*this, number); return *this; }
   template <class T> UArbInt& UArbInt::setBitwise (T          const number) { _SetBitwise<T, NumType<T>::type>::op(*this, number); return *this; }
   
+  /*
+   * Set from a little-endian sequence of digits in any base.
+   */
+  template <class T> UArbInt& UArbInt::setDigits (T const& digits, value_type const base) {
+    
+    // Check the base.
+    if (base < 2) {
+      throw Errors::BaseOutOfRangeMin();
+    }
+    if (base > s_digitbase) {
+      throw Errors::BaseOutOfRangeMax();
+    }
+    
+    // Copy the digits out, making sure each is within the base.
+    _DigsT num;
+    num.reserve(digits.size());
+    for (typename T::const_iterator i = digits.begin(); i != digits.end(); ++i) {
+      SafeInt<typename T::value_type> digit(*i);
+      if (digit < 0 || digit >= base) {
+        throw Errors::BadFormat().Problem("Digit overflows base").Position(i - digits.begin());
+      }
+      num.push_back(static_cast<_DigT>(*i));
+    }
+    s_trimZerosE(num);
+    
+    // Convert, then swap in.
+    _DigsT limbs;
+    s_fromRadix(limbs, num, base);
+    s_fromLimbs(limbs, _digits);
+    
+    // Done.
+    return *this;
+    
+  }
+  
+  /*
+   * Get as a little-endian sequence of digits in any base. Zero is an empty
+   * sequence.
+   */
+  template <class T> T& UArbInt::getDigits (T& digits, value_type const base) const {
+    
+    // Check the base.
+    if (base < 2) {
+      throw Errors::BaseOutOfRangeMin();
+    }
+    if (base > s_digitbase) {
+      throw Errors::BaseOutOfRangeMax();
+    }
+    
+    // Convert.
+    _DigsT limbs;
+    _DigsT num;
+    s_toLimbs(_digits, limbs);
+    s_toRadix(num, limbs, base);
+    
+    // Copy into the requested container.
+    T retval;
+    for (_DigsT::const_iterator i = num.begin(); i != num.end(); ++i) {
+      retval.push_back(static_cast<typename T::value_type>(*i));
+    }
+    
+    // Done.
+    digits.swap(retval);
+    return digits;
+    
+  }
+  
   /*
    * Push a string onto the back of this number.
    */
@@ -1413,6 +1688,12 @@ namespace DAC {
    */
   template <class T> inline UArbInt UArbInt::pow (T const exp) const { return pow(UArbInt(exp)); }
   
+  /*
+   * Placeholder for automatic iroot conversion, and the square root.
+   */
+  template <class T> inline UArbInt UArbInt::iroot (T const n) const { return iroot(UArbInt(n)); }
+                     inline UArbInt UArbInt::isqrt ()          const { return iroot(2);          }
+  
   // Access a specific digit.
   inline UArbInt::value_type UArbInt::get_digit (size_t const digit) const {
     if (digit >= _digits.size()) {
@@ -1524,35 +1805,13 @@ namespace DAC {
     
   }
   
-  /*
-   * Convert a container from one base to another. Frombase must be
-   * 2^(bits/2) of from or smaller, tobase must be 2^(bits/2) of to or
-   * smaller.
-   */
-  template <class FT, class TT> void UArbInt::s_baseConv (FT const& from, value_type const frombase, TT& to, value_type const tobase) {
-    
-    // Empty out target container.
-    to.clear();
-    
-    // Temporary, since work will be done in place.
-    FT tmp_from(from);
-    
-    // Convert base by storing the remainder of repeated division by the
-    // base that we will be converting to, in the base that we are
-    // converting from. Least significant digits come out first.
-    while (tmp_from.size() > 0) {
-      to.push_back(s_longDiv(tmp_from, tobase, frombase));
-    }
-    
-  }
-  
   /*
    * Set from an unsigned integer type.
    */
   template <class T> void UArbInt::_Set<T, NumTypes::UINT>::op (UArbInt& l, SafeInt<T> const r) {
     
     // Work area.
-    UArbInt::_DigsT new_digits;
+    UArbInt::_SharedDigsT new_digits;
     
     // Only something to set if the number is not zero.
     if (r != 0) {
@@ -1615,7 +1874,7 @@ namespace DAC {
     }
     
     // Work area.
-    UArbInt::_DigsT new_digits;
+    UArbInt::_SharedDigsT new_digits;
     
     // Move bits into place. If we have more bits than can be held in a digit,
     // iterate through, otherwise do it the easy way.
@@ -2215,10 +2474,16 @@ namespace DAC {
    */
   inline ArbInt::ArbInt (ArbInt const& number) : _sign(number._sign), _digits(number._digits) {}
   
+  /*
+   * Move constructor.
+   */
+  inline ArbInt::ArbInt (ArbInt&& number) : _sign(number._sign), _digits(std::move(number._digits)) { number._sign = false; }
+  
   /*
    * UArbInt conversion constructor.
    */
   inline ArbInt::ArbInt (UArbInt const& number) : _sign(false), _digits(number) {}
+  inline ArbInt::ArbInt (UArbInt&&      number) : _sign(false), _digits(std::move(number)) {}
   
   /*
    * String conversion constructor.
@@ -2228,7 +2493,7 @@ namespace DAC {
   /*
    * Native type conversion constructor.
    */
-  template <class T> inline ArbInt::ArbInt (T const number) : _sign(number < 0), _digits(abs(number)) {}
+  template <class T> inline ArbInt::ArbInt (T const number) : _sign(false) { set(number); }
   
   /*
    * Increment / decrement operators.
@@ -2275,6 +2540,7 @@ namespace DAC {
    * Assignment operator.
    */
                      inline ArbInt& ArbInt::operator = (ArbInt      const& number) { set(number); return *this; }
+                     inline ArbInt& ArbInt::operator = (ArbInt&&           number) { if (this != &number) { _digits = std::move(number._digits); _sign = number._sign; number._sign = false; } return *this; }
                      inline ArbInt& ArbInt::operator = (UArbInt     const& number) { set(number); return *this; }
                      inline ArbInt& ArbInt::operator = (std::string const& number) { set(number); return *this; }
   template <class T> inline ArbInt& ArbInt::operator = (T           const  number) { set(number); return *this; }
@@ -2682,6 +2948,12 @@ namespace DAC {
       }
     }
     
+    // Both negative, compare as ArbInt so magnitudes are compared the right
+    // way around.
+    if (l._sign) {
+      return l.op_compare(ArbInt(r));
+    }
+    
     // Now compare digits.
     return l._digits.op_compare(r);
     
@@ -2798,94 +3070,150 @@ namespace DAC {
   /*
    * Arithmetic operators.
    */
-                     inline UArbInt operator * (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_mul(r); }
-                     inline ArbInt  operator * (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_mul(r); }
-                     inline ArbInt  operator * (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_mul(r); }
-                     inline ArbInt  operator * (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_mul(r); }
-  template <class T> inline UArbInt operator * (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_mul(r); }
-  template <class T> inline ArbInt  operator * (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_mul(r); }
-  template <class T> inline UArbInt operator * (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(r).op_mul(l); }
-  template <class T> inline ArbInt  operator * (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (r).op_mul(l); }
-  template <class T> inline UArbInt operator * (UArbInt    const& l, T          const  r) { return UArbInt(l).op_mul(r); }
-  template <class T> inline ArbInt  operator * (ArbInt     const& l, T          const  r) { return ArbInt (l).op_mul(r); }
-  template <class T> inline UArbInt operator * (T          const  l, UArbInt    const& r) { return UArbInt(r).op_mul(l); }
-  template <class T> inline ArbInt  operator * (T          const  l, ArbInt     const& r) { return ArbInt (r).op_mul(l); }
-                     inline UArbInt operator / (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_div(r); }
-                     inline ArbInt  operator / (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_div(r); }
-                     inline ArbInt  operator / (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_div(r); }
-                     inline ArbInt  operator / (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_div(r); }
-  template <class T> inline UArbInt operator / (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_div(r); }
-  template <class T> inline ArbInt  operator / (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_div(r); }
-  template <class T> inline UArbInt operator / (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(l).op_div(r); }
-  template <class T> inline ArbInt  operator / (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (l).op_div(r); }
-  template <class T> inline UArbInt operator / (UArbInt    const& l, T          const  r) { return UArbInt(l).op_div(r); }
-  template <class T> inline ArbInt  operator / (ArbInt     const& l, T          const  r) { return ArbInt (l).op_div(r); }
-  template <class T> inline UArbInt operator / (T          const  l, UArbInt    const& r) { return UArbInt(l).op_div(r); }
-  template <class T> inline ArbInt  operator / (T          const  l, ArbInt     const& r) { return ArbInt (l).op_div(r); }
-                     inline UArbInt operator % (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_mod(r); }
-                     inline ArbInt  operator % (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_mod(r); }
-                     inline ArbInt  operator % (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_mod(r); }
-                     inline ArbInt  operator % (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_mod(r); }
-  template <class T> inline UArbInt operator % (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_mod(r); }
-  template <class T> inline ArbInt  operator % (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_mod(r); }
-  template <class T> inline UArbInt operator % (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(l).op_mod(r); }
-  template <class T> inline ArbInt  operator % (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (l).op_mod(r); }
-  template <class T> inline UArbInt operator % (UArbInt    const& l, T          const  r) { return UArbInt(l).op_mod(r); }
-  template <class T> inline ArbInt  operator % (ArbInt     const& l, T          const  r) { return ArbInt (l).op_mod(r); }
-  template <class T> inline UArbInt operator % (T          const  l, UArbInt    const& r) { return UArbInt(l).op_mod(r); }
-  template <class T> inline ArbInt  operator % (T          const  l, ArbInt     const& r) { return ArbInt (l).op_mod(r); }
-                     inline UArbInt operator + (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_add(r); }
-                     inline ArbInt  operator + (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_add(r); }
-                     inline ArbInt  operator + (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_add(r); }
-                     inline ArbInt  operator + (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_add(r); }
-  template <class T> inline UArbInt operator + (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_add(r); }
-  template <class T> inline ArbInt  operator + (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_add(r); }
-  template <class T> inline UArbInt operator + (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(r).op_add(l); }
-  template <class T> inline ArbInt  operator + (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (r).op_add(l); }
-  template <class T> inline UArbInt operator + (UArbInt    const& l, T          const  r) { return UArbInt(l).op_add(r); }
-  template <class T> inline ArbInt  operator + (ArbInt     const& l, T          const  r) { return ArbInt (l).op_add(r); }
-  template <class T> inline UArbInt operator + (T          const  l, UArbInt    const& r) { return UArbInt(r).op_add(l); }
-  template <class T> inline ArbInt  operator + (T          const  l, ArbInt     const& r) { return ArbInt (r).op_add(l); }
-                     inline UArbInt operator - (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_sub(r); }
-                     inline ArbInt  operator - (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_sub(r); }
-                     inline ArbInt  operator - (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_sub(r); }
-                     inline ArbInt  operator - (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_sub(r); }
-  template <class T> inline UArbInt operator - (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_sub(r); }
-  template <class T> inline ArbInt  operator - (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_sub(r); }
-  template <class T> inline UArbInt operator - (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(l).op_sub(r); }
-  template <class T> inline ArbInt  operator - (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (l).op_sub(r); }
-  template <class T> inline UArbInt operator - (UArbInt    const& l, T          const  r) { return UArbInt(l).op_sub(r); }
-  template <class T> inline ArbInt  operator - (ArbInt     const& l, T          const  r) { return ArbInt (l).op_sub(r); }
-  template <class T> inline UArbInt operator - (T          const  l, UArbInt    const& r) { return UArbInt(l).op_sub(r); }
-  template <class T> inline ArbInt  operator - (T          const  l, ArbInt     const& r) { return ArbInt (l).op_sub(r); }
+                     inline UArbInt operator * (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_mul(r)); }
+                     inline UArbInt operator * (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_mul(r));          }
+                     inline ArbInt  operator * (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_mul(r)); }
+                     inline ArbInt  operator * (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_mul(r));          }
+                     inline ArbInt  operator * (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_mul(r)); }
+                     inline ArbInt  operator * (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_mul(r)); }
+                     inline ArbInt  operator * (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_mul(r)); }
+                     inline ArbInt  operator * (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_mul(r));          }
+  template <class T> inline UArbInt operator * (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_mul(r)); }
+  template <class T> inline UArbInt operator * (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_mul(r));          }
+  template <class T> inline ArbInt  operator * (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_mul(r)); }
+  template <class T> inline ArbInt  operator * (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_mul(r));          }
+  template <class T> inline UArbInt operator * (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_mul(l)); }
+  template <class T> inline ArbInt  operator * (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_mul(l)); }
+  template <class T> inline UArbInt operator * (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_mul(r)); }
+  template <class T> inline UArbInt operator * (UArbInt&&         l, T          const  r) { return std::move(l.op_mul(r));          }
+  template <class T> inline ArbInt  operator * (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_mul(r)); }
+  template <class T> inline ArbInt  operator * (ArbInt&&          l, T          const  r) { return std::move(l.op_mul(r));          }
+  template <class T> inline UArbInt operator * (T          const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_mul(l)); }
+  template <class T> inline ArbInt  operator * (T          const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_mul(l)); }
+                     inline UArbInt operator / (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_div(r)); }
+                     inline UArbInt operator / (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_div(r));          }
+                     inline ArbInt  operator / (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_div(r)); }
+                     inline ArbInt  operator / (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_div(r));          }
+                     inline ArbInt  operator / (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_div(r)); }
+                     inline ArbInt  operator / (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_div(r)); }
+                     inline ArbInt  operator / (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_div(r)); }
+                     inline ArbInt  operator / (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_div(r));          }
+  template <class T> inline UArbInt operator / (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_div(r)); }
+  template <class T> inline UArbInt operator / (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_div(r));          }
+  template <class T> inline ArbInt  operator / (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_div(r)); }
+  template <class T> inline ArbInt  operator / (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_div(r));          }
+  template <class T> inline UArbInt operator / (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_div(r)); }
+  template <class T> inline ArbInt  operator / (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_div(r)); }
+  template <class T> inline UArbInt operator / (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_div(r)); }
+  template <class T> inline UArbInt operator / (UArbInt&&         l, T          const  r) { return std::move(l.op_div(r));          }
+  template <class T> inline ArbInt  operator / (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_div(r)); }
+  template <class T> inline ArbInt  operator / (ArbInt&&          l, T          const  r) { return std::move(l.op_div(r));          }
+  template <class T> inline UArbInt operator / (T          const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_div(r)); }
+  template <class T> inline ArbInt  operator / (T          const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_div(r)); }
+                     inline UArbInt operator % (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_mod(r)); }
+                     inline UArbInt operator % (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_mod(r));          }
+                     inline ArbInt  operator % (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_mod(r)); }
+                     inline ArbInt  operator % (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_mod(r));          }
+                     inline ArbInt  operator % (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_mod(r)); }
+                     inline ArbInt  operator % (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_mod(r)); }
+                     inline ArbInt  operator % (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_mod(r)); }
+                     inline ArbInt  operator % (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_mod(r));          }
+  template <class T> inline UArbInt operator % (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_mod(r)); }
+  template <class T> inline UArbInt operator % (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_mod(r));          }
+  template <class T> inline ArbInt  operator % (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_mod(r)); }
+  template <class T> inline ArbInt  operator % (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_mod(r));          }
+  template <class T> inline UArbInt operator % (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_mod(r)); }
+  template <class T> inline ArbInt  operator % (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_mod(r)); }
+  template <class T> inline UArbInt operator % (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_mod(r)); }
+  template <class T> inline UArbInt operator % (UArbInt&&         l, T          const  r) { return std::move(l.op_mod(r));          }
+  template <class T> inline ArbInt  operator % (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_mod(r)); }
+  template <class T> inline ArbInt  operator % (ArbInt&&          l, T          const  r) { return std::move(l.op_mod(r));          }
+  template <class T> inline UArbInt operator % (T          const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_mod(r)); }
+  template <class T> inline ArbInt  operator % (T          const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_mod(r)); }
+                     inline UArbInt operator + (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_add(r)); }
+                     inline UArbInt operator + (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_add(r));          }
+                     inline ArbInt  operator + (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_add(r)); }
+                     inline ArbInt  operator + (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_add(r));          }
+                     inline ArbInt  operator + (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_add(r)); }
+                     inline ArbInt  operator + (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_add(r)); }
+                     inline ArbInt  operator + (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_add(r)); }
+                     inline ArbInt  operator + (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_add(r));          }
+  template <class T> inline UArbInt operator + (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_add(r)); }
+  template <class T> inline UArbInt operator + (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_add(r));          }
+  template <class T> inline ArbInt  operator + (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_add(r)); }
+  template <class T> inline ArbInt  operator + (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_add(r));          }
+  template <class T> inline UArbInt operator + (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_add(l)); }
+  template <class T> inline ArbInt  operator + (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_add(l)); }
+  template <class T> inline UArbInt operator + (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_add(r)); }
+  template <class T> inline UArbInt operator + (UArbInt&&         l, T          const  r) { return std::move(l.op_add(r));          }
+  template <class T> inline ArbInt  operator + (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_add(r)); }
+  template <class T> inline ArbInt  operator + (ArbInt&&          l, T          const  r) { return std::move(l.op_add(r));          }
+  template <class T> inline UArbInt operator + (T          const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_add(l)); }
+  template <class T> inline ArbInt  operator + (T          const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_add(l)); }
+                     inline UArbInt operator - (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_sub(r)); }
+                     inline UArbInt operator - (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_sub(r));          }
+                     inline ArbInt  operator - (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_sub(r)); }
+                     inline ArbInt  operator - (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_sub(r));          }
+                     inline ArbInt  operator - (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_sub(r)); }
+                     inline ArbInt  operator - (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_sub(r)); }
+                     inline ArbInt  operator - (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_sub(r)); }
+                     inline ArbInt  operator - (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_sub(r));          }
+  template <class T> inline UArbInt operator - (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_sub(r)); }
+  template <class T> inline UArbInt operator - (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_sub(r));          }
+  template <class T> inline ArbInt  operator - (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_sub(r)); }
+  template <class T> inline ArbInt  operator - (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_sub(r));          }
+  template <class T> inline UArbInt operator - (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_sub(r)); }
+  template <class T> inline ArbInt  operator - (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_sub(r)); }
+  template <class T> inline UArbInt operator - (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_sub(r)); }
+  template <class T> inline UArbInt operator - (UArbInt&&         l, T          const  r) { return std::move(l.op_sub(r));          }
+  template <class T> inline ArbInt  operator - (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_sub(r)); }
+  template <class T> inline ArbInt  operator - (ArbInt&&          l, T          const  r) { return std::move(l.op_sub(r));          }
+  template <class T> inline UArbInt operator - (T          const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_sub(r)); }
+  template <class T> inline ArbInt  operator - (T          const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_sub(r)); }
   
   /*
    * Bit shift operators.
    */
-                     inline UArbInt operator << (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_shl(r); }
-                     inline ArbInt  operator << (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_shl(r); }
-                     inline ArbInt  operator << (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_shl(r); }
-                     inline ArbInt  operator << (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_shl(r); }
-  template <class T> inline UArbInt operator << (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_shl(r); }
-  template <class T> inline ArbInt  operator << (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_shl(r); }
-  template <class T> inline UArbInt operator << (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(l).op_shl(r); }
-  template <class T> inline ArbInt  operator << (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (l).op_shl(r); }
-  template <class T> inline UArbInt operator << (UArbInt    const& l, T          const  r) { return UArbInt(l).op_shl(r); }
-  template <class T> inline ArbInt  operator << (ArbInt     const& l, T          const  r) { return ArbInt (l).op_shl(r); }
-  template <class T> inline UArbInt operator << (T          const  l, UArbInt    const& r) { return UArbInt(l).op_shl(r); }
-  template <class T> inline ArbInt  operator << (T          const  l, ArbInt     const& r) { return ArbInt (l).op_shl(r); }
-                     inline UArbInt operator >> (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_shr(r); }
-                     inline ArbInt  operator >> (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_shr(r); }
-                     inline ArbInt  operator >> (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_shr(r); }
-                     inline ArbInt  operator >> (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_shr(r); }
-  template <class T> inline UArbInt operator >> (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_shr(r); }
-  template <class T> inline ArbInt  operator >> (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_shr(r); }
-  template <class T> inline UArbInt operator >> (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(l).op_shr(r); }
-  template <class T> inline ArbInt  operator >> (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (l).op_shr(r); }
-  template <class T> inline UArbInt operator >> (UArbInt    const& l, T          const  r) { return UArbInt(l).op_shr(r); }
-  template <class T> inline ArbInt  operator >> (ArbInt     const& l, T          const  r) { return ArbInt (l).op_shr(r); }
-  template <class T> inline UArbInt operator >> (T          const  l, UArbInt    const& r) { return UArbInt(l).op_shr(r); }
-  template <class T> inline ArbInt  operator >> (T          const  l, ArbInt     const& r) { return ArbInt (l).op_shr(r); }
+                     inline UArbInt operator << (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_shl(r)); }
+                     inline UArbInt operator << (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_shl(r));          }
+                     inline ArbInt  operator << (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_shl(r)); }
+                     inline ArbInt  operator << (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_shl(r));          }
+                     inline ArbInt  operator << (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_shl(r)); }
+                     inline ArbInt  operator << (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_shl(r)); }
+                     inline ArbInt  operator << (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_shl(r)); }
+                     inline ArbInt  operator << (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_shl(r));          }
+  template <class T> inline UArbInt operator << (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_shl(r)); }
+  template <class T> inline UArbInt operator << (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_shl(r));          }
+  template <class T> inline ArbInt  operator << (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_shl(r)); }
+  template <class T> inline ArbInt  operator << (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_shl(r));          }
+  template <class T> inline UArbInt operator << (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_shl(r)); }
+  template <class T> inline ArbInt  operator << (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_shl(r)); }
+  template <class T> inline UArbInt operator << (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_shl(r)); }
+  template <class T> inline UArbInt operator << (UArbInt&&         l, T          const  r) { return std::move(l.op_shl(r));          }
+  template <class T> inline ArbInt  operator << (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_shl(r)); }
+  template <class T> inline ArbInt  operator << (ArbInt&&          l, T          const  r) { return std::move(l.op_shl(r));          }
+  template <class T> inline UArbInt operator << (T          const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_shl(r)); }
+  template <class T> inline ArbInt  operator << (T          const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_shl(r)); }
+                     inline UArbInt operator >> (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_shr(r)); }
+                     inline UArbInt operator >> (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_shr(r));          }
+                     inline ArbInt  operator >> (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_shr(r)); }
+                     inline ArbInt  operator >> (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_shr(r));          }
+                     inline ArbInt  operator >> (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_shr(r)); }
+                     inline ArbInt  operator >> (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_shr(r)); }
+                     inline ArbInt  operator >> (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_shr(r)); }
+                     inline ArbInt  operator >> (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_shr(r));          }
+  template <class T> inline UArbInt operator >> (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_shr(r)); }
+  template <class T> inline UArbInt operator >> (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_shr(r));          }
+  template <class T> inline ArbInt  operator >> (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_shr(r)); }
+  template <class T> inline ArbInt  operator >> (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_shr(r));          }
+  template <class T> inline UArbInt operator >> (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_shr(r)); }
+  template <class T> inline ArbInt  operator >> (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_shr(r)); }
+  template <class T> inline UArbInt operator >> (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_shr(r)); }
+  template <class T> inline UArbInt operator >> (UArbInt&&         l, T          const  r) { return std::move(l.op_shr(r));          }
+  template <class T> inline ArbInt  operator >> (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_shr(r)); }
+  template <class T> inline ArbInt  operator >> (ArbInt&&          l, T          const  r) { return std::move(l.op_shr(r));          }
+  template <class T> inline UArbInt operator >> (T          const  l, UArbInt    const& r) { return std::move(UArbInt(l).op_shr(r)); }
+  template <class T> inline ArbInt  operator >> (T          const  l, ArbInt     const& r) { return std::move(ArbInt (l).op_shr(r)); }
   
   /*
    * Comparsion operators.
@@ -2966,42 +3294,66 @@ namespace DAC {
   /*
    * Bitwise operators.
    */
-                     inline UArbInt operator & (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_bit_and(r); }
-                     inline ArbInt  operator & (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_bit_and(r); }
-                     inline ArbInt  operator & (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_bit_and(r); }
-                     inline ArbInt  operator & (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_bit_and(r); }
-  template <class T> inline UArbInt operator & (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_bit_and(r); }
-  template <class T> inline ArbInt  operator & (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_bit_and(r); }
-  template <class T> inline UArbInt operator & (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(r).op_bit_and(l); }
-  template <class T> inline ArbInt  operator & (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (r).op_bit_and(l); }
-  template <class T> inline UArbInt operator & (UArbInt    const& l, T          const  r) { return UArbInt(l).op_bit_and(r); }
-  template <class T> inline ArbInt  operator & (ArbInt     const& l, T          const  r) { return ArbInt (l).op_bit_and(r); }
-  template <class T> inline UArbInt operator & (T          const  l, UArbInt    const& r) { return UArbInt(r).op_bit_and(l); }
-  template <class T> inline ArbInt  operator & (T          const  l, ArbInt     const& r) { return ArbInt (r).op_bit_and(l); }
-                     inline UArbInt operator | (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_bit_ior(r); }
-                     inline ArbInt  operator | (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_bit_ior(r); }
-                     inline ArbInt  operator | (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_bit_ior(r); }
-                     inline ArbInt  operator | (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_bit_ior(r); }
-  template <class T> inline UArbInt operator | (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_bit_ior(r); }
-  template <class T> inline ArbInt  operator | (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_bit_ior(r); }
-  template <class T> inline UArbInt operator | (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(r).op_bit_ior(l); }
-  template <class T> inline ArbInt  operator | (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (r).op_bit_ior(l); }
-  template <class T> inline UArbInt operator | (UArbInt    const& l, T          const  r) { return UArbInt(l).op_bit_ior(r); }
-  template <class T> inline ArbInt  operator | (ArbInt     const& l, T          const  r) { return ArbInt (l).op_bit_ior(r); }
-  template <class T> inline UArbInt operator | (T          const  l, UArbInt    const& r) { return UArbInt(r).op_bit_ior(l); }
-  template <class T> inline ArbInt  operator | (T          const  l, ArbInt     const& r) { return ArbInt (r).op_bit_ior(l); }
-                     inline UArbInt operator ^ (UArbInt    const& l, UArbInt    const& r) { return UArbInt(l).op_bit_xor(r); }
-                     inline ArbInt  operator ^ (ArbInt     const& l, ArbInt     const& r) { return ArbInt (l).op_bit_xor(r); }
-                     inline ArbInt  operator ^ (UArbInt    const& l, ArbInt     const& r) { return ArbInt (l).op_bit_xor(r); }
-                     inline ArbInt  operator ^ (ArbInt     const& l, UArbInt    const& r) { return ArbInt (l).op_bit_xor(r); }
-  template <class T> inline UArbInt operator ^ (UArbInt    const& l, SafeInt<T> const  r) { return UArbInt(l).op_bit_xor(r); }
-  template <class T> inline ArbInt  operator ^ (ArbInt     const& l, SafeInt<T> const  r) { return ArbInt (l).op_bit_xor(r); }
-  template <class T> inline UArbInt operator ^ (SafeInt<T> const  l, UArbInt    const& r) { return UArbInt(r).op_bit_xor(l); }
-  template <class T> inline ArbInt  operator ^ (SafeInt<T> const  l, ArbInt     const& r) { return ArbInt (r).op_bit_xor(l); }
-  template <class T> inline UArbInt operator ^ (UArbInt    const& l, T          const  r) { return UArbInt(l).op_bit_xor(r); }
-  template <class T> inline ArbInt  operator ^ (ArbInt     const& l, T          const  r) { return ArbInt (l).op_bit_xor(r); }
-  template <class T> inline UArbInt operator ^ (T          const  l, UArbInt    const& r) { return UArbInt(r).op_bit_xor(l); }
-  template <class T> inline ArbInt  operator ^ (T          const  l, ArbInt     const& r) { return ArbInt (r).op_bit_xor(l); }
+                     inline UArbInt operator & (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_bit_and(r)); }
+                     inline UArbInt operator & (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_bit_and(r));          }
+                     inline ArbInt  operator & (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_bit_and(r)); }
+                     inline ArbInt  operator & (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_bit_and(r));          }
+                     inline ArbInt  operator & (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_bit_and(r)); }
+                     inline ArbInt  operator & (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_bit_and(r)); }
+                     inline ArbInt  operator & (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_bit_and(r)); }
+                     inline ArbInt  operator & (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_bit_and(r));          }
+  template <class T> inline UArbInt operator & (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_bit_and(r)); }
+  template <class T> inline UArbInt operator & (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_bit_and(r));          }
+  template <class T> inline ArbInt  operator & (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_bit_and(r)); }
+  template <class T> inline ArbInt  operator & (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_bit_and(r));          }
+  template <class T> inline UArbInt operator & (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_bit_and(l)); }
+  template <class T> inline ArbInt  operator & (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_bit_and(l)); }
+  template <class T> inline UArbInt operator & (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_bit_and(r)); }
+  template <class T> inline UArbInt operator & (UArbInt&&         l, T          const  r) { return std::move(l.op_bit_and(r));          }
+  template <class T> inline ArbInt  operator & (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_bit_and(r)); }
+  template <class T> inline ArbInt  operator & (ArbInt&&          l, T          const  r) { return std::move(l.op_bit_and(r));          }
+  template <class T> inline UArbInt operator & (T          const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_bit_and(l)); }
+  template <class T> inline ArbInt  operator & (T          const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_bit_and(l)); }
+                     inline UArbInt operator | (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_bit_ior(r)); }
+                     inline UArbInt operator | (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_bit_ior(r));          }
+                     inline ArbInt  operator | (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_bit_ior(r)); }
+                     inline ArbInt  operator | (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_bit_ior(r));          }
+                     inline ArbInt  operator | (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_bit_ior(r)); }
+                     inline ArbInt  operator | (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_bit_ior(r)); }
+                     inline ArbInt  operator | (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_bit_ior(r)); }
+                     inline ArbInt  operator | (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_bit_ior(r));          }
+  template <class T> inline UArbInt operator | (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_bit_ior(r)); }
+  template <class T> inline UArbInt operator | (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_bit_ior(r));          }
+  template <class T> inline ArbInt  operator | (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_bit_ior(r)); }
+  template <class T> inline ArbInt  operator | (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_bit_ior(r));          }
+  template <class T> inline UArbInt operator | (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_bit_ior(l)); }
+  template <class T> inline ArbInt  operator | (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_bit_ior(l)); }
+  template <class T> inline UArbInt operator | (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_bit_ior(r)); }
+  template <class T> inline UArbInt operator | (UArbInt&&         l, T          const  r) { return std::move(l.op_bit_ior(r));          }
+  template <class T> inline ArbInt  operator | (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_bit_ior(r)); }
+  template <class T> inline ArbInt  operator | (ArbInt&&          l, T          const  r) { return std::move(l.op_bit_ior(r));          }
+  template <class T> inline UArbInt operator | (T          const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_bit_ior(l)); }
+  template <class T> inline ArbInt  operator | (T          const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_bit_ior(l)); }
+                     inline UArbInt operator ^ (UArbInt    const& l, UArbInt    const& r) { return std::move(UArbInt(l).op_bit_xor(r)); }
+                     inline UArbInt operator ^ (UArbInt&&         l, UArbInt    const& r) { return std::move(l.op_bit_xor(r));          }
+                     inline ArbInt  operator ^ (ArbInt     const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_bit_xor(r)); }
+                     inline ArbInt  operator ^ (ArbInt&&          l, ArbInt     const& r) { return std::move(l.op_bit_xor(r));          }
+                     inline ArbInt  operator ^ (UArbInt    const& l, ArbInt     const& r) { return std::move(ArbInt (l).op_bit_xor(r)); }
+                     inline ArbInt  operator ^ (UArbInt&&         l, ArbInt     const& r) { return std::move(ArbInt(std::move(l)).op_bit_xor(r)); }
+                     inline ArbInt  operator ^ (ArbInt     const& l, UArbInt    const& r) { return std::move(ArbInt (l).op_bit_xor(r)); }
+                     inline ArbInt  operator ^ (ArbInt&&          l, UArbInt    const& r) { return std::move(l.op_bit_xor(r));          }
+  template <class T> inline UArbInt operator ^ (UArbInt    const& l, SafeInt<T> const  r) { return std::move(UArbInt(l).op_bit_xor(r)); }
+  template <class T> inline UArbInt operator ^ (UArbInt&&         l, SafeInt<T> const  r) { return std::move(l.op_bit_xor(r));          }
+  template <class T> inline ArbInt  operator ^ (ArbInt     const& l, SafeInt<T> const  r) { return std::move(ArbInt (l).op_bit_xor(r)); }
+  template <class T> inline ArbInt  operator ^ (ArbInt&&          l, SafeInt<T> const  r) { return std::move(l.op_bit_xor(r));          }
+  template <class T> inline UArbInt operator ^ (SafeInt<T> const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_bit_xor(l)); }
+  template <class T> inline ArbInt  operator ^ (SafeInt<T> const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_bit_xor(l)); }
+  template <class T> inline UArbInt operator ^ (UArbInt    const& l, T          const  r) { return std::move(UArbInt(l).op_bit_xor(r)); }
+  template <class T> inline UArbInt operator ^ (UArbInt&&         l, T          const  r) { return std::move(l.op_bit_xor(r));          }
+  template <class T> inline ArbInt  operator ^ (ArbInt     const& l, T          const  r) { return std::move(ArbInt (l).op_bit_xor(r)); }
+  template <class T> inline ArbInt  operator ^ (ArbInt&&          l, T          const  r) { return std::move(l.op_bit_xor(r));          }
+  template <class T> inline UArbInt operator ^ (T          const  l, UArbInt    const& r) { return std::move(UArbInt(r).op_bit_xor(l)); }
+  template <class T> inline ArbInt  operator ^ (T          const  l, ArbInt     const& r) { return std::move(ArbInt (r).op_bit_xor(l)); }
   
   /*
    * Arithmetic assignment operators.
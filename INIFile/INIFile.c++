@@ -7,14 +7,28 @@
 // Standard includes.
 #include <string>
 #include <vector>
-#include <fstream>
+#include <algorithm>
+#include <cerrno>
+#include <mutex>
+
+// Platform includes.
+#include <sys/types.h>
+#include <sys/stat.h>
+#if defined(INIFILE_MMAP)
+  #include <sys/mman.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#else
+  #include <fstream>
+  #include <demangle.h++>
+#endif
 
 // Internal includes.
 #include <ValReader.h++>
 #include <tokenize.h++>
-#include <AutoArray.h++>
 #include <trim.h++>
-#include <demangle.h++>
+#include <get_errorText.h++>
+#include <StringView.h++>
 
 // Class include.
 #include "INIFile.h++"
@@ -68,10 +82,10 @@ namespace DAC {
   /*
    * Provide access to sections.
    */
-  INIFile::Section INIFile::operator [] (string const& section) {
+  INIFile::Section INIFile::operator [] (StringView const& section) {
     
     // Read INI file if necessary.
-    if (!_wasread) {
+    if (_data.isNull()) {
       read();
     }
     
@@ -79,20 +93,21 @@ namespace DAC {
     return (*const_cast<INIFile const*>(this))[section];
     
   } 
-  INIFile::Section INIFile::operator [] (string const& section) const {
+  INIFile::Section INIFile::operator [] (StringView const& section) const {
     
     // Ensure that the INI file has been read.
-    if (!_wasread) {
+    if (_data.isNull()) {
       throw Errors::NotRead();
     }
     
     // Ensure that this section is defined.
-    if (!section_defined(section)) {
+    size_t const found = _data->find_section(section);
+    if (found == _Data::NOT_FOUND) {
       throw Errors::SectionUndefined();
     }
     
     // Return a Section object pointing to this section.
-    return Section(section, _sections.find(section)->second);
+    return Section(_data, found);
     
   }
   
@@ -102,10 +117,8 @@ namespace DAC {
   void INIFile::clear () {
     
     // Non-throw.
-    _wasread = false;
-    
     _filename.clear();
-    _sections.clear();
+    _data.clear();
     
   }
   
@@ -114,11 +127,9 @@ namespace DAC {
    */
   void INIFile::copy (INIFile const& inifile) {
     
-    // Non-throw.
-    _wasread = inifile._wasread;
-    
+    // Non-throw. The parsed file never changes, so share it.
     _filename = inifile._filename;
-    _sections = inifile._sections;
+    _data     = inifile._data;
     
   }
   
@@ -128,7 +139,7 @@ namespace DAC {
   INIFile::SectionListPT INIFile::get_sections () {
     
     // Read data if needed.
-    if (!_wasread) {
+    if (_data.isNull()) {
       read();
     }
     
@@ -139,20 +150,12 @@ namespace DAC {
   INIFile::SectionListPT INIFile::get_sections () const {
     
     // Make sure data has been read.
-    if (!_wasread) {
+    if (_data.isNull()) {
       throw Errors::NotRead();
     }
     
-    // Work area.
-    SectionListPT retval(new SectionListT);
-    
-    // Push section names into the section list.
-    for (_SectionT::const_iterator i = _sections.begin(); i != _sections.end(); ++i) {
-      retval->push_back(i->first);
-    }
-    
     // Done.
-    return retval;
+    return _data->get_sections();
     
   }
   
@@ -167,44 +170,17 @@ namespace DAC {
     }
     
     // Work area.
-    AutoArray<char> buffer     ;
-    vector<string>  lines      ;
-    _SectionT       newsections;
+    _DataPT            newdata(_DataPT::create());
+    vector<StringView> lines  ;
     
-    // Do not allow file errors to propagate.
-    try {
-      
-      // Open the INI file.
-      ifstream file(_filename.c_str());
-      if (!file) {
-        throw Errors::FileNoOpen();
-      }
-      
-      // Get the size of the file.
-      streampos filesize = 0;
-      file.seekg(0, ios::end);
-      filesize = file.tellg();
-      file.seekg(0, ios::beg);
-      
-      // Read the entire file into a buffer.
-      buffer = new char[filesize + static_cast<streampos>(1)];
-      file.read(buffer.get(), filesize);
-      file.close();
-      
-    // Error during file operation.
-    } catch (exception& e) {
-      string errtype;
-      throw Errors::FileUnexpectedError().Type(demangle(errtype, e)).Message(e.what());
-    } catch (...) {
-      throw Errors::FileUnexpectedError().Type("-Unknown-").Message("-Unknown-");
-    }
+    // Map the file.
+    s_load(_filename, *newdata);
     
     // Split each line.
-    tokenize(buffer.get(), lines, "\n");
+    tokenize(StringView(newdata->Text, newdata->Size), lines, "\n");
     
     // Process each line.
-    string section;
-    for (vector<string>::iterator line = lines.begin(); line != lines.end(); ++line) {
+    for (vector<StringView>::iterator line = lines.begin(); line != lines.end(); ++line) {
       
       // Trim whitespace.
       trim(*line);
@@ -215,10 +191,10 @@ namespace DAC {
       }
       
       // Work area.
-      string::size_type valuesep = string::npos;
+      StringView::size_type valuesep = StringView::npos;
       
       // Check if this is the beginning of a section.
-      if ((*line)[0] == '[' && (*line)[line->size() - 1] == ']') {
+      if ((*line)[0] == '[' && line->back() == ']') {
         
         // Make sure the section is not blank.
         if (line->size() == 2) {
@@ -226,48 +202,45 @@ namespace DAC {
         }
         
         // Get the section name.
-        section = line->substr(1, line->size() - 2);
+        StringView const section(line->substr(1, line->size() - 2));
         
         // Make sure this section does not already exist.
-        if (newsections.count(section)) {
-          throw Errors::SectionMultiDefine().Section(section);
+        if (newdata->find_section(section) != _Data::NOT_FOUND) {
+          throw Errors::SectionMultiDefine().Section(section.to_string());
         }
         
         // Create the new section.
-        newsections[section];
+        newdata->add_section(section);
         
       // Check for a key=value.
-      } else if ((valuesep = line->find('=')) != string::npos) {
+      } else if ((valuesep = line->find('=')) != StringView::npos) {
         
         // Make sure that we have a key.
         if (valuesep == 0) {
           throw Errors::ValueNoKey();
         }
         
-        // Work area.
-        string key  ;
-        string value;
-        
         // Get the key, trim whitespace from end.
-        key = line->substr(0, min(line->find_last_not_of(" \t", valuesep - 1) + 1, valuesep));
+        StringView const key(line->substr(0, min(line->find_last_not_of(" \t", valuesep - 1) + 1, valuesep)));
         
         // Make sure that we have an active section.
-        if (section.empty()) {
-          throw Errors::KeyNoSection().Key(key);
+        if (newdata->Sections.empty()) {
+          throw Errors::KeyNoSection().Key(key.to_string());
         }
         
         // Make sure this key does not already exist in this section.
-        if (newsections[section].count(key)) {
-          throw Errors::KeyMultiDefine().Section(section).Key(key);
+        if (newdata->find_key(newdata->Sections.size() - 1, key) != _Data::NOT_FOUND) {
+          throw Errors::KeyMultiDefine().Section(newdata->Sections.back().Name.to_string()).Key(key.to_string());
         }
         
         // Get the value, trim whitespace from beginning.
+        StringView value;
         if (valuesep != line->size() - 1) {
           value = line->substr(line->find_first_not_of(" \t", valuesep + 1));
         }
         
         // Add the key.
-        newsections[section].insert(_KeyT::value_type(key, value));
+        newdata->add_key(key, value);
         
       // Parse error.
       } else {
@@ -276,11 +249,36 @@ namespace DAC {
       
     }
     
-    // Swap in new sections.
-    _sections.swap(newsections);
+    // Swap in the new file. Sections and copies still using the old one
+    // keep it alive.
+    _data = newdata;
+    
+  }
+  
+  /*
+   * Read the INI file again if it has changed.
+   */
+  bool INIFile::reload () {
+    
+    // Make sure that the filename is set.
+    if (_filename.empty()) {
+      throw Errors::FileNotSet();
+    }
+    
+    // Skip reading if the file looks the same. If it cannot be found, let
+    // read() report it.
+    if (!_data.isNull()) {
+      long long mtime   = 0;
+      long long mtimens = 0;
+      long long size    = 0;
+      if (s_stat(_filename, mtime, mtimens, size) && mtime == _data->MTime && mtimens == _data->MTimeNS && size == _data->StSize) {
+        return false;
+      }
+    }
     
-    // File was successfully read.
-    _wasread = true;
+    // Read it.
+    read();
+    return true;
     
   }
   
@@ -289,11 +287,122 @@ namespace DAC {
    */
   void INIFile::reset () {
     
-    // Turn off wasread flag.
-    _wasread = false;
+    // Clear data, this is also the read flag.
+    _data.clear();
     
-    // Clear data.
-    _sections.clear();
+  }
+  
+  /*
+   * Map or read the file, and get what it looks like.
+   */
+  void INIFile::s_load (string const& filename, _Data& data) {
+  
+#if defined(INIFILE_MMAP)
+    
+    // Work area.
+    string errtext;
+    
+    // Open the INI file.
+    int const fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      throw Errors::FileNoOpen();
+    }
+    
+    // Get what it looks like from the file we opened, not the name, in case
+    // it is being replaced.
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+      int const errnum = errno;
+      close(fd);
+      throw Errors::FileUnexpectedError().Type("fstat").Message(get_errorText(errtext, errnum));
+    }
+    data.MTime  = info.st_mtime;
+    data.StSize = info.st_size;
+    #if defined(INIFILE_STAT_MTIM)
+      data.MTimeNS = info.st_mtim.tv_nsec;
+    #endif
+    
+    // Map it. An empty file cannot be mapped, and does not need to be.
+    if (info.st_size != 0) {
+      void* const text = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (text == MAP_FAILED) {
+        int const errnum = errno;
+        close(fd);
+        throw Errors::FileUnexpectedError().Type("mmap").Message(get_errorText(errtext, errnum));
+      }
+      data.Text  = static_cast<char const*>(text);
+      data.Size  = info.st_size;
+      data.Owned = true;
+    }
+    
+    // The mapping does not need the file to stay open.
+    close(fd);
+    
+#else
+    
+    // Get what it looks like first, a change while reading will be picked
+    // up by the next reload.
+    if (!s_stat(filename, data.MTime, data.MTimeNS, data.StSize)) {
+      throw Errors::FileNoOpen();
+    }
+    
+    // Do not allow file errors to propagate.
+    try {
+      
+      // Open the INI file.
+      ifstream file(filename.c_str(), ios::binary);
+      if (!file) {
+        throw Errors::FileNoOpen();
+      }
+      
+      // Get the size of the file.
+      file.seekg(0, ios::end);
+      streamoff const filesize = file.tellg();
+      file.seekg(0, ios::beg);
+      
+      // Read the entire file into a buffer.
+      char* const text = new char[static_cast<size_t>(filesize) + 1];
+      data.Text  = text;
+      data.Owned = true;
+      file.read(text, filesize);
+      data.Size = file.gcount();
+      file.close();
+      
+    // Error during file operation.
+    } catch (Errors::FileNoOpen&) {
+      throw;
+    } catch (exception& e) {
+      string errtype;
+      throw Errors::FileUnexpectedError().Type(demangle(errtype, e)).Message(e.what());
+    } catch (...) {
+      throw Errors::FileUnexpectedError().Type("-Unknown-").Message("-Unknown-");
+    }
+    
+#endif
+  
+  }
+  
+  /*
+   * Get what the file looks like now.
+   */
+  bool INIFile::s_stat (string const& filename, long long& mtime, long long& mtimens, long long& size) {
+    
+    // Missing files are not an error here.
+    struct stat info;
+    if (stat(filename.c_str(), &info) == -1) {
+      return false;
+    }
+    
+    // Modification time, to the nanosecond where we can.
+    mtime   = info.st_mtime;
+    mtimens = 0;
+    #if defined(INIFILE_STAT_MTIM)
+      mtimens = info.st_mtim.tv_nsec;
+    #endif
+    size = info.st_size;
+    
+    // We done.
+    return true;
     
   }
   
@@ -307,33 +416,172 @@ namespace DAC {
   /*
    * Return a key's value.
    */
-  ValReader INIFile::Section::operator [] (string const& key) const {
+  ValReader INIFile::Section::operator [] (StringView const& key) const {
     
     // Make sure the key is defined.
-    if (!key_defined(key)) {
+    size_t const found = _data->find_key(_section, key);
+    if (found == _Data::NOT_FOUND) {
       throw Errors::KeyUndefined();
     }
     
-    // Return the value.
-    return _keys.find(key)->second;
+    // Return the value, which keeps the file alive.
+    return ValReader(_data->Keys[found].Value, ConstReferencePointer<ReferenceCounted>(_data.get()));
     
   }
   
+  /***************************************************************************
+   * Class INIFile::_Data.
+   ***************************************************************************/
+   
+  /***************************************************************************/
+  // Constants.
+  
+  // Not found.
+  size_t const INIFile::_Data::NOT_FOUND = static_cast<size_t>(-1);
+  
+  /***************************************************************************/
+  // Function members.
+  
   /*
-   * Get a list of keys in this section.
+   * Default constructor.
    */
-  INIFile::KeyListPT INIFile::Section::get_keys () const {
+  INIFile::_Data::_Data () :
+    Text   (""   ),
+    Size   (0    ),
+    Owned  (false),
+    MTime  (0    ),
+    MTimeNS(0    ),
+    StSize (0    )
+  {}
+  
+  /*
+   * Destructor.
+   */
+  INIFile::_Data::~_Data () {
+    
+    // Unmap or free the file.
+    if (Owned) {
+#if defined(INIFILE_MMAP)
+      munmap(const_cast<char*>(Text), Size);
+#else
+      delete[] Text;
+#endif
+    }
     
-    // Work area.
-    KeyListPT retval(new KeyListT);
+  }
+  
+  /*
+   * Add a section.
+   */
+  void INIFile::_Data::add_section (StringView const& name) {
+    
+    // Keys that follow are in this section.
+    SectionEntry entry;
+    entry.Name     = name;
+    entry.Hash     = s_hash(name);
+    entry.FirstKey = Keys.size();
+    entry.NumKeys  = 0;
+    Sections.push_back(entry);
+    
+    // Index it.
+    s_insert(SectionIndex, Sections);
+    
+  }
+  
+  /*
+   * Add a key to the last section.
+   */
+  void INIFile::_Data::add_key (StringView const& name, StringView const& value) {
+    
+    // Add it.
+    KeyEntry entry;
+    entry.Name    = name;
+    entry.Value   = value;
+    entry.Section = Sections.size() - 1;
+    entry.Hash    = s_keyHash(entry.Section, name);
+    Keys.push_back(entry);
+    ++Sections.back().NumKeys;
+    
+    // Index it.
+    s_insert(KeyIndex, Keys);
+    
+  }
+  
+  /*
+   * Get a list of sections.
+   */
+  INIFile::SectionListPT INIFile::_Data::get_sections () const {
+    
+    // Build the list the first time.
+    lock_guard<mutex> lock(ListLock);
+    if (SectionList.isNull()) {
+      ReferencePointer<SectionListT> list(ReferencePointer<SectionListT>::create());
+      SectionList = list;
+      list->reserve(Sections.size());
+      for (vector<SectionEntry>::const_iterator i = Sections.begin(); i != Sections.end(); ++i) {
+        list->push_back(i->Name.to_string());
+      }
+      sort(list->begin(), list->end());
+    }
+    
+    // Done.
+    return SectionList;
     
-    // Push key names into the key list.
-    for (_KeyT::const_iterator i = _keys.begin(); i != _keys.end(); ++i) {
-      retval->push_back(i->first);
+  }
+  
+  /*
+   * Get a list of keys in a section.
+   */
+  INIFile::KeyListPT INIFile::_Data::get_keys (size_t const section) const {
+    
+    // Build the list the first time.
+    lock_guard<mutex> lock(ListLock);
+    if (KeyLists.empty()) {
+      KeyLists.resize(Sections.size());
+    }
+    if (KeyLists[section].isNull()) {
+      ReferencePointer<KeyListT> list(ReferencePointer<KeyListT>::create());
+      KeyLists[section] = list;
+      list->reserve(Sections[section].NumKeys);
+      for (size_t i = Sections[section].FirstKey; i != Sections[section].FirstKey + Sections[section].NumKeys; ++i) {
+        list->push_back(Keys[i].Name.to_string());
+      }
+      sort(list->begin(), list->end());
     }
     
     // Done.
-    return retval;
+    return KeyLists[section];
+    
+  }
+  
+  /*
+   * Add the last entry to a hash table.
+   */
+  template <class EntryT> void INIFile::_Data::s_insert (vector<size_t>& index, vector<EntryT> const& entries) {
+    
+    // Keep the table at most half full. Rebuild it if it grows, which
+    // indexes the new entry too.
+    if (entries.size() * 2 > index.size()) {
+      vector<size_t> newindex(max(index.size() * 2, static_cast<size_t>(16)), 0);
+      size_t const   mask = newindex.size() - 1;
+      for (size_t i = 0; i != entries.size(); ++i) {
+        size_t slot = entries[i].Hash & mask;
+        while (newindex[slot]) {
+          slot = (slot + 1) & mask;
+        }
+        newindex[slot] = i + 1;
+      }
+      index.swap(newindex);
+      return;
+    }
+    
+    // Probe for an empty slot.
+    size_t const mask = index.size() - 1;
+    size_t       slot = entries.back().Hash & mask;
+    while (index[slot]) {
+      slot = (slot + 1) & mask;
+    }
+    index[slot] = entries.size();
     
   }
   
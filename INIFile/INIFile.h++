@@ -10,20 +10,27 @@
 
 // Standard includes.
   #include <string>
-  #include <map>
-  #include <iterator>
   #include <vector>
+  #include <cstddef>
+  #include <mutex>
 
 // System includes.
   #include <ReferencePointer.h++>
   #include <Exception.h++>
   #include <ValReader.h++>
+  #include <StringView.h++>
 
 // Namespace wrapping.
 namespace DAC {
   
   /***************************************************************************
    * INIFile
+   ***************************************************************************
+   * The file is mapped into memory and never copied. Sections, keys and
+   * values are views into the mapping, found through hash tables, and the
+   * mapping lives as long as anything refers to it. Replace INI files by
+   * writing a new file and renaming it over the old one, rewriting a mapped
+   * file in place changes or truncates what has already been read.
    ***************************************************************************/
   class INIFile {
     
@@ -35,8 +42,9 @@ namespace DAC {
       /***********************************************************************/
       // Data types.
       
-      // Key type.
-      typedef std::map<std::string, std::string> _KeyT;
+      // A parsed file, shared by copies and sections.
+      class _Data;
+      typedef ReferencePointer<_Data> _DataPT;
       
     /*
      * Public members.
@@ -50,14 +58,16 @@ namespace DAC {
       typedef std::vector<std::string> SectionListT;
       typedef std::vector<std::string> KeyListT    ;
       
-      // Pointers to lists of sections and keys.
-      typedef ReferencePointer<SectionListT> SectionListPT;
-      typedef ReferencePointer<KeyListT    > KeyListPT;
+      // Pointers to lists of sections and keys. Lists are built once per
+      // read and shared by every call.
+      typedef ConstReferencePointer<SectionListT> SectionListPT;
+      typedef ConstReferencePointer<KeyListT    > KeyListPT;
       
       /***********************************************************************
        * Section
        ***********************************************************************
-       * Provides access to INI file sections.
+       * Provides access to INI file sections. A handle, cheap to copy, that
+       * keeps the file it came from alive.
        ***********************************************************************/
       class Section {
         
@@ -69,17 +79,11 @@ namespace DAC {
           /*******************************************************************/
           // Function members.
           
-          // Constructs with a reference to a section.
-          Section (std::string const& section, _KeyT const& keylist) :
-            _section(section),
-            _keys   (keylist)
-          {};
-          
           // Provides access to key values.
-          ValReader operator [] (std::string const& key) const;
+          ValReader operator [] (StringView const& key) const;
           
           // Determine if a particular key is defined.
-          bool key_defined (std::string const& key) const;
+          bool key_defined (StringView const& key) const;
           
           // Get a list of keys defined in this section.
           KeyListPT get_keys () const;
@@ -89,14 +93,26 @@ namespace DAC {
          */
         private:
           
+          /*******************************************************************/
+          // Friends.
+          
+          // Only INIFile creates sections.
+          friend class INIFile;
+          
+          /*******************************************************************/
+          // Function members.
+          
+          // Constructs with a section of a parsed file.
+          Section (_DataPT const& data, size_t const section);
+          
           /*******************************************************************/
           // Data members.
           
-          // The name of the section we are representing.
-          std::string _section;
+          // The file this section is in.
+          _DataPT _data;
           
-          // Reference to the keys in this section.
-          _KeyT const& _keys;
+          // The section we are representing.
+          size_t _section;
           
       };
       
@@ -249,8 +265,8 @@ namespace DAC {
       INIFile& operator = (INIFile const& inifile);
       
       // Provide access to section keys.
-      Section operator [] (std::string const& section)     ;
-      Section operator [] (std::string const& section) const;
+      Section operator [] (StringView const& section)     ;
+      Section operator [] (StringView const& section) const;
       
       // Properties.
       INIFile& Filename (std::string const& filename);
@@ -259,30 +275,34 @@ namespace DAC {
       // Reset to just-constructed state.
       void clear ();
       
-      // Copy a given INIFile object.
+      // Copy a given INIFile object. Both share the same parsed file.
       void copy (INIFile const& inifile);
       
       // Determine if a section is defined in this INI file.
-      bool section_defined (std::string const& section)      ;
-      bool section_defined (std::string const& section) const;
+      bool section_defined (StringView const& section)      ;
+      bool section_defined (StringView const& section) const;
       
       // Determine if a key is defined in a given section.
-      bool key_defined (std::string const& section, std::string const& key)      ;
-      bool key_defined (std::string const& section, std::string const& key) const;
+      bool key_defined (StringView const& section, StringView const& key)      ;
+      bool key_defined (StringView const& section, StringView const& key) const;
       
       // Get a list of sections in this INI file.
       SectionListPT get_sections ()      ;
       SectionListPT get_sections () const;
       
       // Get a list of keys in a given section.
-      KeyListPT get_keys (std::string const& section)      ;
-      KeyListPT get_keys (std::string const& section) const;
+      KeyListPT get_keys (StringView const& section)      ;
+      KeyListPT get_keys (StringView const& section) const;
       
       // Read the INI file. Not necessary to call this manually unless you
       // want the file read immedately. A good reason would be to catch any
       // errors that are thrown at a predictable time.
       void read ();
       
+      // Read the INI file again if its modification time or size has
+      // changed since it was last read. Returns true if it was read.
+      bool reload ();
+      
       // Reset file read status. Will make new calls re-read the file.
       void reset ();
       
@@ -291,11 +311,113 @@ namespace DAC {
      */
     private:
       
-      /***********************************************************************/
-      // Data types.
-      
-      // Section type.
-      typedef std::map<std::string, _KeyT> _SectionT;
+      /***********************************************************************
+       * _Data
+       ***********************************************************************
+       * A parsed INI file. Never changes once read, other than building the
+       * lists of names the first time they are asked for. Counts its own
+       * references, so values read from it can keep it alive.
+       ***********************************************************************/
+      class _Data : public ReferenceCounted {
+        
+        /*
+         * Public members.
+         */
+        public:
+          
+          /*******************************************************************/
+          // Data types.
+          
+          // A section. Keys of a section are contiguous.
+          class SectionEntry {
+            public:
+              StringView Name    ;
+              size_t     Hash    ;
+              size_t     FirstKey;
+              size_t     NumKeys ;
+          };
+          
+          // A key and its value.
+          class KeyEntry {
+            public:
+              StringView Name   ;
+              StringView Value  ;
+              size_t     Hash   ;
+              size_t     Section;
+          };
+          
+          /*******************************************************************/
+          // Constants.
+          
+          // Not found.
+          static size_t const NOT_FOUND;
+          
+          /*******************************************************************/
+          // Function members.
+          
+          // Default constructor and destructor.
+          _Data ();
+          ~_Data ();
+          
+          // Find a section or key, NOT_FOUND if it is not defined.
+          size_t find_section (StringView const& name                      ) const;
+          size_t find_key     (size_t const section, StringView const& name) const;
+          
+          // Add a section or key, must not already be defined.
+          void add_section (StringView const& name);
+          void add_key     (StringView const& name, StringView const& value);
+          
+          // Get lists of names.
+          SectionListPT get_sections (                    ) const;
+          KeyListPT     get_keys     (size_t const section) const;
+          
+          /*******************************************************************/
+          // Data members.
+          
+          // The file, either mapped or read into a buffer, and whether
+          // there is anything to unmap or free.
+          char const* Text ;
+          size_t      Size ;
+          bool        Owned;
+          
+          // What the file looked like when it was read.
+          long long MTime  ;
+          long long MTimeNS;
+          long long StSize ;
+          
+          // Sections and keys, in file order.
+          std::vector<SectionEntry> Sections;
+          std::vector<KeyEntry    > Keys    ;
+          
+          // Open-addressed hash tables of index + 1, 0 for an empty slot.
+          std::vector<size_t> SectionIndex;
+          std::vector<size_t> KeyIndex    ;
+          
+          // Sorted lists of names, built when first asked for. The lock
+          // lets handles in several threads ask at once.
+          mutable SectionListPT          SectionList;
+          mutable std::vector<KeyListPT> KeyLists   ;
+          mutable std::mutex             ListLock   ;
+          
+        /*
+         * Private members.
+         */
+        private:
+          
+          /*******************************************************************/
+          // Function members.
+          
+          // Hash a key, mixed with its section.
+          static size_t s_keyHash (size_t const section, StringView const& name);
+          
+          // Add the last entry to a hash table, growing it if it is half full.
+          template <class EntryT> static void s_insert (std::vector<size_t>& index, std::vector<EntryT> const& entries);
+          
+          // No copying.
+          _Data (_Data const&);
+          _Data& operator = (_Data const&);
+          
+      };
       
       /***********************************************************************/
       // Data members.
@@ -303,11 +425,20 @@ namespace DAC {
       // The name of the INI file.
       std::string _filename;
       
-      // Sections.
-      _SectionT _sections;
+      // The parsed file, null if it has not been read.
+      _DataPT _data;
       
-      // Track whether INI file was read.
-      bool _wasread;
+      /***********************************************************************/
+      // Function members.
+      
+      // Hash a name.
+      static size_t s_hash (StringView const& text);
+      
+      // Map or read the file, and get what it looks like.
+      static void s_load (std::string const& filename, _Data& data);
+      
+      // Get what the file looks like now, false if it cannot be found.
+      static bool s_stat (std::string const& filename, long long& mtime, long long& mtimens, long long& size);
       
   };
   
@@ -330,45 +461,43 @@ namespace DAC {
   /*
    * Determine if a section is defined in this INI file.
    */
-  inline bool INIFile::section_defined (std::string const& section) {
-    if (!_wasread) {
+  inline bool INIFile::section_defined (StringView const& section) {
+    if (_data.isNull()) {
       read();
     }
     return const_cast<INIFile const*>(this)->section_defined(section);
   }
-  inline bool INIFile::section_defined (std::string const& section) const {
-    if (!_wasread) {
+  inline bool INIFile::section_defined (StringView const& section) const {
+    if (_data.isNull()) {
       throw Errors::NotRead();
     }
-    return _sections.count(section);
+    return _data->find_section(section) != _Data::NOT_FOUND;
   }
   
   /*
    * Determine if a key is defined in a given section.
    */
-  inline bool INIFile::key_defined (std::string const& section, std::string const& key) {
-    if (!_wasread) {
+  inline bool INIFile::key_defined (StringView const& section, StringView const& key) {
+    if (_data.isNull()) {
       read();
     }
     return const_cast<INIFile const*>(this)->key_defined(section, key);
   }
-  inline bool INIFile::key_defined (std::string const& section, std::string const& key) const {
-    if (!_wasread) {
+  inline bool INIFile::key_defined (StringView const& section, StringView const& key) const {
+    if (_data.isNull()) {
       throw Errors::NotRead();
     }
-    if (!section_defined(section)) {
-      return false;
-    }
-    return (*this)[section].key_defined(key);
+    size_t const found = _data->find_section(section);
+    return found != _Data::NOT_FOUND && _data->find_key(found, key) != _Data::NOT_FOUND;
   }
   
   /*
    * Get a list of keys in a given section.
    */
-  inline INIFile::KeyListPT INIFile::get_keys (std::string const& section) {
+  inline INIFile::KeyListPT INIFile::get_keys (StringView const& section) {
     return (*this)[section].get_keys();
   }
-  inline INIFile::KeyListPT INIFile::get_keys (std::string const& section) const {
+  inline INIFile::KeyListPT INIFile::get_keys (StringView const& section) const {
     return (*this)[section].get_keys();
   }
   
@@ -378,6 +507,17 @@ namespace DAC {
   inline std::string INIFile::Filename (                           ) const { return _filename;                            }
   inline INIFile&    INIFile::Filename (std::string const& filename)       { clear(); _filename = filename; return *this; }
   
+  /*
+   * Hash a name, FNV-1a.
+   */
+  inline size_t INIFile::s_hash (StringView const& text) {
+    size_t retval = static_cast<size_t>(14695981039346656037ULL);
+    for (StringView::const_iterator i = text.begin(); i != text.end(); ++i) {
+      retval = (retval ^ static_cast<unsigned char>(*i)) * static_cast<size_t>(1099511628211ULL);
+    }
+    return retval;
+  }
+  
   /***************************************************************************
    * Class INIFile::Section.
    ***************************************************************************/
@@ -385,10 +525,80 @@ namespace DAC {
   /***************************************************************************/
   // Function members.
   
+  /*
+   * Constructs with a section of a parsed file.
+   */
+  inline INIFile::Section::Section (_DataPT const& data, size_t const section) : _data(data), _section(section) {}
+  
   /*
    * Verify that a key is defined.
    */
-  inline bool INIFile::Section::key_defined (std::string const& key) const { return _keys.count(key); }
+  inline bool INIFile::Section::key_defined (StringView const& key) const { return _data->find_key(_section, key) != _Data::NOT_FOUND; }
+  
+  /*
+   * Get a list of keys in this section.
+   */
+  inline INIFile::KeyListPT INIFile::Section::get_keys () const { return _data->get_keys(_section); }
+  
+  /***************************************************************************
+   * Class INIFile::_Data.
+   ***************************************************************************/
+   
+  /***************************************************************************/
+  // Function members.
+  
+  /*
+   * Find a section.
+   */
+  inline size_t INIFile::_Data::find_section (StringView const& name) const {
+    
+    // Nothing to find.
+    if (SectionIndex.empty()) {
+      return NOT_FOUND;
+    }
+    
+    // Probe until the name or an empty slot.
+    size_t const hash = s_hash(name);
+    size_t const mask = SectionIndex.size() - 1;
+    for (size_t slot = hash & mask; SectionIndex[slot]; slot = (slot + 1) & mask) {
+      SectionEntry const& entry = Sections[SectionIndex[slot] - 1];
+      if (entry.Hash == hash && entry.Name == name) {
+        return SectionIndex[slot] - 1;
+      }
+    }
+    return NOT_FOUND;
+    
+  }
+  
+  /*
+   * Find a key in a section.
+   */
+  inline size_t INIFile::_Data::find_key (size_t const section, StringView const& name) const {
+    
+    // Nothing to find.
+    if (KeyIndex.empty()) {
+      return NOT_FOUND;
+    }
+    
+    // Probe until the name or an empty slot.
+    size_t const hash = s_keyHash(section, name);
+    size_t const mask = KeyIndex.size() - 1;
+    for (size_t slot = hash & mask; KeyIndex[slot]; slot = (slot + 1) & mask) {
+      KeyEntry const& entry = Keys[KeyIndex[slot] - 1];
+      if (entry.Hash == hash && entry.Section == section && entry.Name == name) {
+        return KeyIndex[slot] - 1;
+      }
+    }
+    return NOT_FOUND;
+    
+  }
+  
+  /*
+   * Hash a key, mixed with its section.
+   */
+  inline size_t INIFile::_Data::s_keyHash (size_t const section, StringView const& name) {
+    return s_hash(name) ^ ((section + 1) * static_cast<size_t>(0x9E3779B97F4A7C15ULL));
+  }
   
 }
 
@@ -0,0 +1,138 @@
+/*****************************************************************************
+ * OpCounters
+ *****************************************************************************
+ * Running totals of the work done by the arbitrary-precision classes.
+ *****************************************************************************/
+
+// Include guard.
+#if !defined(OPCOUNTERS_x7d2m9k4q1)
+	#define OPCOUNTERS_x7d2m9k4q1
+
+// STL includes.
+	#include <atomic>
+
+// Namespace container.
+namespace DAC {
+	
+	/***************************************************************************
+	 * OpCounters
+	 ***************************************************************************
+	 * Totals over all threads, for benchmarks and tests to see what a
+	 * workload costs. Totals are only kept when built with
+	 * OPCOUNTERS_ENABLED. Otherwise counting compiles to nothing and every
+	 * total reads 0.
+	 ***************************************************************************/
+	class OpCounters {
+	
+		/*
+		 * Public members.
+		 */
+		public:
+		
+			/***********************************************************************/
+			// Data types.
+			
+			// What is counted.
+			enum Counter {
+				DIGIT_OPS  , // Inner-loop steps of arithmetic, one per digit or limb.
+				ALLOCATIONS, // Digit buffers taken from the heap.
+				REDUCTIONS , // Arb fractions brought to lowest terms or to a fixed denominator.
+				GCD_STEPS  , // Steps of Euclid or Lehmer on full-length numbers.
+				NUM_COUNTERS
+			};
+			
+			/***********************************************************************/
+			// Constants.
+			
+			// Whether totals are kept.
+			#if defined(OPCOUNTERS_ENABLED)
+				static bool const enabled = true;
+			#else
+				static bool const enabled = false;
+			#endif
+			
+			/***********************************************************************/
+			// Function members.
+			
+			// Add to a total.
+			static void add (Counter const counter, unsigned long long const count = 1);
+			
+			// Read a total, or set them all back to 0.
+			static unsigned long long get   (Counter const counter);
+			static void               reset (                     );
+			
+			// Name of a counter, for output.
+			static char const* name (Counter const counter);
+		
+		/*
+		 * Private members.
+		 */
+		private:
+		
+			/***********************************************************************/
+			// Function members.
+			
+			// The totals.
+			static std::atomic<unsigned long long>* s_totals ();
+	
+	};
+	
+	/***************************************************************************
+	 * Inline and template definitions.
+	 ***************************************************************************/
+	
+	/***************************************************************************
+	 * OpCounters
+	 ***************************************************************************/
+	
+	/***************************************************************************/
+	// Function members.
+	
+	/*
+	 * Add to a total. Totals are only ever read after the work is done, so
+	 * nothing needs to be ordered.
+	 */
+	inline void OpCounters::add (Counter const counter, unsigned long long const count) {
+		#if defined(OPCOUNTERS_ENABLED)
+			s_totals()[counter].fetch_add(count, std::memory_order_relaxed);
+		#else
+			if (counter && count) {}
+		#endif
+	}
+	
+	/*
+	 * Read a total.
+	 */
+	inline unsigned long long OpCounters::get (Counter const counter) {
+		return s_totals()[counter].load(std::memory_order_relaxed);
+	}
+	
+	/*
+	 * Set all totals back to 0.
+	 */
+	inline void OpCounters::reset () {
+		for (int i = 0; i != NUM_COUNTERS; ++i) {
+			s_totals()[i].store(0, std::memory_order_relaxed);
+		}
+	}
+	
+	/*
+	 * Name of a counter.
+	 */
+	inline char const* OpCounters::name (Counter const counter) {
+		static char const* const names[NUM_COUNTERS] = { "digit_ops", "allocations", "reductions", "gcd_steps" };
+		return names[counter];
+	}
+	
+	/*
+	 * The totals, one set shared by every translation unit.
+	 */
+	inline std::atomic<unsigned long long>* OpCounters::s_totals () {
+		static std::atomic<unsigned long long> totals[NUM_COUNTERS] = {};
+		return totals;
+	}
+
+}
+
+// End include guard.
+#endif
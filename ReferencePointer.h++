@@ -8,14 +8,220 @@
 #if !defined(REFERENCEPOINTER_huhoeu89o8e)
 	#define REFERENCEPOINTER_huhoeu89o8e
 
+// STL includes.
+	#include <atomic>
+	#include <type_traits>
+	#include <utility>
+
 // Namespace wrapper.
 namespace DAC {
 	
+	// Forward declarations.
+	class ReferenceCounted;
+	
+	/***************************************************************************
+	 * ReferencePointerUtil
+	 ***************************************************************************
+	 * Reference counters and the blocks that hold them.
+	 ***************************************************************************/
+	namespace ReferencePointerUtil {
+		
+		/*************************************************************************
+		 * Count
+		 *************************************************************************
+		 * A reference count that may be changed from several threads at once.
+		 * Adding a reference needs no ordering, since whoever adds one already
+		 * has one. Dropping one releases everything this thread did to the
+		 * object, and whoever drops the last one sees all of it before cleaning
+		 * up. Reading the count acquires as well, so that a thread that sees it
+		 * is the only owner may safely write.
+		 *************************************************************************/
+		class Count {
+			
+			/*
+			 * Public members.
+			 */
+			public:
+				
+				// Typedefs.
+				typedef int RefCountT;
+				
+				// Default constructor, no references.
+				Count ();
+				
+				// Get the number of references.
+				RefCountT get () const;
+				
+				// Add a reference.
+				void add ();
+				
+				// Drop a reference, return how many are left.
+				RefCountT drop ();
+				
+			/*
+			 * Private members.
+			 */
+			private:
+				
+				// The count.
+				std::atomic<RefCountT> _refs;
+				
+				// Not copyable.
+				Count (Count const&);
+				Count& operator = (Count const&);
+				
+		};
+		
+		/*************************************************************************
+		 * Block
+		 *************************************************************************
+		 * A reference count, and what to do when it runs out.
+		 *************************************************************************/
+		class Block {
+			
+			/*
+			 * Public members.
+			 */
+			public:
+				
+				// The number of references.
+				Count Refs;
+				
+				// The last reference is gone, destroy the object.
+				virtual void destroy () = 0;
+				
+				// The last reference was released, hand the object to the
+				// caller. Returns false if the object cannot outlive the block, in
+				// which case it is destroyed.
+				virtual bool detach () = 0;
+				
+			/*
+			 * Protected members.
+			 */
+			protected:
+				
+				// Only destroyed through destroy() or detach().
+				virtual ~Block ();
+				
+		};
+		
+		/*************************************************************************
+		 * Adopted
+		 *************************************************************************
+		 * Counts references to an object allocated separately with new.
+		 *************************************************************************/
+		template <class T> class Adopted : public Block {
+			
+			/*
+			 * Public members.
+			 */
+			public:
+				
+				// Constructor.
+				explicit Adopted (T* const p);
+				
+				// Block interface.
+				virtual void destroy ();
+				virtual bool detach  ();
+				
+			/*
+			 * Private members.
+			 */
+			private:
+				
+				// The object.
+				T* _p;
+				
+		};
+		
+		/*************************************************************************
+		 * Combined
+		 *************************************************************************
+		 * An object and its reference count in one allocation.
+		 *************************************************************************/
+		template <class T> class Combined : public Block {
+			
+			/*
+			 * Public members.
+			 */
+			public:
+				
+				// The object.
+				T Object;
+				
+				// Construct the object in place.
+				template <class... Args> explicit Combined (Args&&... args);
+				
+				// Block interface.
+				virtual void destroy ();
+				virtual bool detach  ();
+				
+		};
+		
+		/*************************************************************************
+		 * Counted
+		 *************************************************************************
+		 * Find, or make, the block for an object, and make new objects.
+		 * Objects derived from ReferenceCounted are their own block.
+		 *************************************************************************/
+		template <class T, bool intrusive = std::is_base_of<ReferenceCounted, T>::value> class Counted;
+		template <class T> class Counted<T, false> {
+			public:
+				static Block* adopt (T* const p);
+				template <class... Args> static Block* make (T*& p, Args&&... args);
+		};
+		template <class T> class Counted<T, true> {
+			public:
+				static Block* adopt (T* const p);
+				template <class... Args> static Block* make (T*& p, Args&&... args);
+		};
+		
+	}
+	
+	/***************************************************************************
+	 * ReferenceCounted
+	 ***************************************************************************
+	 * Base class for objects that carry their own reference count. A
+	 * ReferencePointer to one of these needs no separate counter, and any
+	 * number of ReferencePointers may be made from the same raw pointer.
+	 * Copying an object does not copy its count.
+	 ***************************************************************************/
+	class ReferenceCounted : public ReferencePointerUtil::Block {
+		
+		/*
+		 * Protected members.
+		 */
+		protected:
+			
+			// Constructors, no references.
+			ReferenceCounted ();
+			ReferenceCounted (ReferenceCounted const&);
+			
+			// Assignment does not change the count.
+			ReferenceCounted& operator = (ReferenceCounted const&);
+			
+			// Destructor.
+			virtual ~ReferenceCounted ();
+			
+		/*
+		 * Private members.
+		 */
+		private:
+			
+			// Block interface.
+			virtual void destroy ();
+			virtual bool detach  ();
+			
+	};
+	
 	/***************************************************************************
 	 * ReferencePointer
 	 ***************************************************************************
 	 * Smart pointer type that counts the number of times it is referenced and
-	 * only deletes itself when the reference count falls to 0.
+	 * only deletes itself when the reference count falls to 0. Counts are
+	 * atomic, so copies may be made and dropped from any thread, though the
+	 * object itself is not protected. Use create() to allocate the object and
+	 * its count together.
 	 ***************************************************************************/
 	template <class T> class ReferencePointer {
 		
@@ -25,11 +231,12 @@ namespace DAC {
 		public:
 			
 			// Typedefs.
-			typedef int RefCountT;
-			typedef T   value_type;
+			typedef ReferencePointerUtil::Count::RefCountT RefCountT;
+			typedef T                                      value_type;
 			
-			// Copy constructor.
+			// Copy and move constructors.
 			ReferencePointer (ReferencePointer<T> const& p);
+			ReferencePointer (ReferencePointer<T>&&      p);
 			
 			// Conversion constructor, also default constructor.
 			explicit ReferencePointer (T* const p = 0);
@@ -37,8 +244,12 @@ namespace DAC {
 			// Destructor.
 			~ReferencePointer ();
 			
+			// Make a new object with its counter in a single allocation.
+			template <class... Args> static ReferencePointer create (Args&&... args);
+			
 			// Assignment operator.
 			ReferencePointer& operator = (ReferencePointer<T> const& right);
+			ReferencePointer& operator = (ReferencePointer<T>&&      right);
 			ReferencePointer& operator = (T* const                   right);
 			
 			// Dereference operator.
@@ -54,7 +265,9 @@ namespace DAC {
 			// Get the pointer without creating an additional reference.
 			T* get () const;
 			
-			// Get the pointer and release this reference.
+			// Get the pointer and release this reference. If this was the last
+			// reference, the caller now owns the object, unless it was made by
+			// create(), in which case it is destroyed and this returns 0.
 			T* release ();
 			
 			// Release the current pointer and set a new one.
@@ -64,9 +277,9 @@ namespace DAC {
 			// Swap this pointer with another one.
 			void swap (ReferencePointer<T>& p);
 			
-			// Reset to just-constructed by default constructor state.
+			// Release the current pointer, same as reset().
 			void clear ();
-		
+			
 		/*
 		 * Private members.
 		 */
@@ -78,11 +291,11 @@ namespace DAC {
 			// The pointer.
 			T* _p;
 			
-			// Number of references to this pointer.
-			RefCountT* _refs;
+			// Counter for this pointer.
+			ReferencePointerUtil::Block* _refs;
 			
-			// Decrement the reference count.
-			RefCountT _decrementRefs();
+			// Drop this reference, destroying the object if it was the last.
+			void _drop ();
 			
 	};
 	
@@ -100,11 +313,13 @@ namespace DAC {
 		public:
 			
 			// Typedefs.
-			typedef int RefCountT;
+			typedef ReferencePointerUtil::Count::RefCountT RefCountT;
 			
-			// Copy constructor.
+			// Copy and move constructors.
 			ConstReferencePointer (ReferencePointer<T>      const& p);
 			ConstReferencePointer (ConstReferencePointer<T> const& p);
+			ConstReferencePointer (ReferencePointer<T>&&           p);
+			ConstReferencePointer (ConstReferencePointer<T>&&      p);
 			
 			// Conversion constructor, also default constructor.
 			explicit ConstReferencePointer (T*       const p = 0);
@@ -116,6 +331,8 @@ namespace DAC {
 			// Assignment operator.
 			ConstReferencePointer& operator = (ReferencePointer<T>      const& right);
 			ConstReferencePointer& operator = (ConstReferencePointer<T> const& right);
+			ConstReferencePointer& operator = (ReferencePointer<T>&&           right);
+			ConstReferencePointer& operator = (ConstReferencePointer<T>&&      right);
 			ConstReferencePointer& operator = (T*                       const  right);
 			ConstReferencePointer& operator = (T const*                 const  right);
 			
@@ -132,7 +349,8 @@ namespace DAC {
 			// Get the pointer without creating an additional reference.
 			T const* get () const;
 			
-			// Get the pointer and release this reference.
+			// Get the pointer and release this reference, same as
+			// ReferencePointer.
 			T const* release ();
 			
 			// Release the current pointer and set a new one.
@@ -144,7 +362,7 @@ namespace DAC {
 			// Swap this pointer with another one.
 			void swap (ConstReferencePointer<T>& p);
 			
-			// Reset to just-constructed by default constructor state.
+			// Release the current pointer, same as reset().
 			void clear ();
 			
 		/*
@@ -155,25 +373,82 @@ namespace DAC {
 			// The pointer.
 			T const* _p;
 			
-			// Number of references to this pointer.
-			RefCountT* _refs;
+			// Counter for this pointer.
+			ReferencePointerUtil::Block* _refs;
 			
-			// Decrement the reference count.
-			RefCountT _decrementRefs();
+			// Drop this reference, destroying the object if it was the last.
+			void _drop ();
 			
 	};
 	
 	/***************************************************************************
 	 * Inline and template definitions.
 	 ***************************************************************************/
+	 
+	namespace ReferencePointerUtil {
+		
+		/*************************************************************************
+		 * Count
+		 *************************************************************************/
+		inline                  Count::Count () : _refs(0) {}
+		inline Count::RefCountT Count::get   () const { return _refs.load(std::memory_order_acquire);           }
+		inline void             Count::add   ()       { _refs.fetch_add(1, std::memory_order_relaxed);          }
+		inline Count::RefCountT Count::drop  ()       { return _refs.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+		
+		/*************************************************************************
+		 * Block
+		 *************************************************************************/
+		inline Block::~Block () {}
+		
+		/*************************************************************************
+		 * Adopted
+		 *************************************************************************/
+		template <class T> inline      Adopted<T>::Adopted (T* const p) : _p(p) {}
+		template <class T> inline void Adopted<T>::destroy ()                   { delete _p; delete this; }
+		template <class T> inline bool Adopted<T>::detach  ()                   { delete this; return true; }
+		
+		/*************************************************************************
+		 * Combined
+		 *************************************************************************/
+		template <class T> template <class... Args> inline Combined<T>::Combined (Args&&... args) : Object(std::forward<Args>(args)...) {}
+		template <class T> inline void Combined<T>::destroy () { delete this;               }
+		template <class T> inline bool Combined<T>::detach  () { delete this; return false; }
+		
+		/*************************************************************************
+		 * Counted
+		 *************************************************************************/
+		template <class T>                          inline Block* Counted<T, false>::adopt (T* const p)                { return new Adopted<T>(p); }
+		template <class T> template <class... Args> inline Block* Counted<T, false>::make  (T*& p, Args&&... args) {
+			Combined<T>* const block = new Combined<T>(std::forward<Args>(args)...);
+			p = &block->Object;
+			return block;
+		}
+		template <class T>                          inline Block* Counted<T, true >::adopt (T* const p)                { return p; }
+		template <class T> template <class... Args> inline Block* Counted<T, true >::make  (T*& p, Args&&... args) {
+			p = new T(std::forward<Args>(args)...);
+			return p;
+		}
+		
+	}
+	
+	/***************************************************************************
+	 * ReferenceCounted
+	 ***************************************************************************/
+	inline                   ReferenceCounted::ReferenceCounted  (                       ) {}
+	inline                   ReferenceCounted::ReferenceCounted  (ReferenceCounted const&) : ReferencePointerUtil::Block() {}
+	inline ReferenceCounted& ReferenceCounted::operator =        (ReferenceCounted const&) { return *this; }
+	inline                   ReferenceCounted::~ReferenceCounted (                       ) {}
+	inline void              ReferenceCounted::destroy           (                       ) { delete this; }
+	inline bool              ReferenceCounted::detach            (                       ) { return true; }
 	
+	/***************************************************************************
+	 * ReferencePointer
+	 ***************************************************************************/
+	 
 	/*
 	 * Copy constructor.
 	 */
-	template <class T> inline ReferencePointer<T>::ReferencePointer (ReferencePointer<T> const& p) {
-		
-		// Just constructed.
-		clear();
+	template <class T> inline ReferencePointer<T>::ReferencePointer (ReferencePointer<T> const& p) : _p(0), _refs(0) {
 		
 		// Set the pointer & increment references.
 		reset(p);
@@ -181,12 +456,20 @@ namespace DAC {
 	}
 	
 	/*
-	 * Conversion and default constructor.
+	 * Move constructor.
 	 */
-	template <class T> inline ReferencePointer<T>::ReferencePointer (T* const p) {
+	template <class T> inline ReferencePointer<T>::ReferencePointer (ReferencePointer<T>&& p) : _p(p._p), _refs(p._refs) {
+		
+		// Take the reference without touching the count.
+		p._p    = 0;
+		p._refs = 0;
 		
-		// Just constructed.
-		clear();
+	}
+	
+	/*
+	 * Conversion and default constructor.
+	 */
+	template <class T> inline ReferencePointer<T>::ReferencePointer (T* const p) : _p(0), _refs(0) {
 		
 		// Set the pointer & start reference counting.
 		reset(p);
@@ -199,7 +482,22 @@ namespace DAC {
 	template <class T> inline ReferencePointer<T>::~ReferencePointer () {
 		
 		// Release the current pointer.
-		reset();
+		_drop();
+		
+	}
+	
+	/*
+	 * Make a new object with its counter in a single allocation.
+	 */
+	template <class T> template <class... Args> inline ReferencePointer<T> ReferencePointer<T>::create (Args&&... args) {
+		
+		// Make the object and take the first reference.
+		ReferencePointer<T> retval;
+		retval._refs = ReferencePointerUtil::Counted<T>::make(retval._p, std::forward<Args>(args)...);
+		retval._refs->Refs.add();
+		
+		// Done.
+		return retval;
 		
 	}
 	
@@ -216,6 +514,22 @@ namespace DAC {
 		
 	}
 	
+	/*
+	 * Assignment operator (move).
+	 */
+	template <class T> inline ReferencePointer<T>& ReferencePointer<T>::operator = (ReferencePointer<T>&& right) {
+		
+		// Trade, the old pointer is released along with right.
+		if (this != &right) {
+			swap(right);
+			right.reset();
+		}
+		
+		// Return this because that's how the assignment operator works.
+		return *this;
+		
+	}
+	
 	/*
 	 * Assignment operator (conversion).
 	 */
@@ -259,7 +573,7 @@ namespace DAC {
 		if (_refs == 0) {
 			return 0;
 		} else {
-			return *_refs;
+			return _refs->Refs.get();
 		}
 		
 	}
@@ -292,10 +606,14 @@ namespace DAC {
 		// Hold the current pointer.
 		T* tp = _p;
 		
-		// Set this pointer to nothing, decrement the reference count, and
-		// release the reference counter.
+		// Decrement the reference count, and hand over the object if this was
+		// the last reference.
+		if (_refs != 0 && _refs->Refs.drop() == 0 && !_refs->detach()) {
+			tp = 0;
+		}
+		
+		// Set this pointer to nothing.
 		_p    = 0;
-		_decrementRefs();
 		_refs = 0;
 		
 		// Return the old pointer.
@@ -313,18 +631,14 @@ namespace DAC {
 			
 			// Decrement references to the old pointer. Delete it if references
 			// fall to zero.
-			if (_decrementRefs() == 0) {
-				delete _p;
-			}
+			_drop();
 			
-			// Set the new pointer and create a reference counter. If _p is a
-			// null pointer, there is no counter.
+			// Set the new pointer and find or create a reference counter. If _p
+			// is a null pointer, there is no counter.
 			_p = p;
-			if (_p == 0) {
-				_refs = 0;
-			} else {
-				_refs  = new int;
-				*_refs = 1;
+			if (_p != 0) {
+				_refs = ReferencePointerUtil::Counted<T>::adopt(_p);
+				_refs->Refs.add();
 			}
 			
 		}
@@ -339,23 +653,18 @@ namespace DAC {
 		// Make sure this is a new pointer.
 		if (_p != p._p) {
 			
+			// Reference the new pointer first, p may be owned by the old one.
+			if (p._refs != 0) {
+				p._refs->Refs.add();
+			}
+			
 			// Decrement references to the old pointer. Delete it if references
 			// fall to zero.
-			if (_decrementRefs() == 0) {
-				delete _p;
-			}
+			_drop();
 			
-			// Set the new pointer and link to and increment the current reference
-			// counter. If _p is a null pointer, there is no counter.
-			_p = p._p;
-			if (_p == 0) {
-				_refs = 0;
-			} else {
-				_refs = p._refs;
-				if (_refs != 0) {
-					++(*_refs);
-				}
-			}
+			// Link to the new pointer and its counter.
+			_p    = p._p   ;
+			_refs = p._refs;
 			
 		}
 		
@@ -366,74 +675,60 @@ namespace DAC {
 	 */
 	template <class T> inline void ReferencePointer<T>::swap (ReferencePointer<T>& p) {
 		
-		// Make sure this is a new pointer.
-		if (_p != p._p) {
-			
-			// Swap.
-			T* tmpp = _p;
-			_p      = p._p;
-			p._p    = tmpp;
-			
-			int* tmprefs = _refs;
-			_refs        = p._refs;
-			p._refs      = tmprefs;
-			
-		}
+		// Swap.
+		std::swap(_p   , p._p   );
+		std::swap(_refs, p._refs);
 		
 	}
 	
 	/*
-	 * Reset to just-constructed by default constructor state.
+	 * Release the current pointer.
 	 */
 	template <class T> inline void ReferencePointer<T>::clear () {
 		
-		// Pointing to nothing.
-		_p = 0;
-		
-		// No counter.
-		_refs = 0;
+		// Same as reset().
+		reset();
 		
 	}
 	
 	/*
-	 * Decrement the number of references to the pointer.
+	 * Drop this reference.
 	 */
-	template <class T> inline typename ReferencePointer<T>::RefCountT ReferencePointer<T>::_decrementRefs () {
+	template <class T> inline void ReferencePointer<T>::_drop () {
 		
-		// Only decrement if the counter exists.
-		if (_refs != 0) {
-			
-			// Decrement the refs and release the reference counter if it reaches
-			// zero.
-			--(*_refs);
-			if (*_refs == 0) {
-				delete _refs;
-				_refs = 0;
-			}
-			
+		// Only decrement if the counter exists, and destroy the object if
+		// this was the last reference. Clear first, the object may own this.
+		ReferencePointerUtil::Block* const refs = _refs;
+		_p    = 0;
+		_refs = 0;
+		if (refs != 0 && refs->Refs.drop() == 0) {
+			refs->destroy();
 		}
 		
-		// Return the number of references to this pointer.
-		return (_refs == 0) ? 0 : *_refs;
-		
 	}
 	
+	/***************************************************************************
+	 * ConstReferencePointer
+	 ***************************************************************************/
+	 
 	/*
-	 * Copy constructor.
+	 * Copy and move constructors.
 	 */
-	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (ReferencePointer<T>      const& p) { clear(); reset(p); }
-	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (ConstReferencePointer<T> const& p) { clear(); reset(p); }
+	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (ReferencePointer<T>      const& p) : _p(0     ), _refs(0      ) { reset(p); }
+	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (ConstReferencePointer<T> const& p) : _p(0     ), _refs(0      ) { reset(p); }
+	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (ReferencePointer<T>&&           p) : _p(p._p ), _refs(p._refs) { p._p = 0; p._refs = 0; }
+	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (ConstReferencePointer<T>&&      p) : _p(p._p ), _refs(p._refs) { p._p = 0; p._refs = 0; }
 	
 	/*
 	 * Conversion and default constructor.
 	 */
-	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (T*       const p) { clear(); reset(p); }
-	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (T const* const p) { clear(); reset(p); }
+	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (T*       const p) : _p(0), _refs(0) { reset(p); }
+	template <class T> inline ConstReferencePointer<T>::ConstReferencePointer (T const* const p) : _p(0), _refs(0) { reset(p); }
 	
 	/*
 	 * Destructor.
 	 */
-	template <class T> inline ConstReferencePointer<T>::~ConstReferencePointer () { reset(); }
+	template <class T> inline ConstReferencePointer<T>::~ConstReferencePointer () { _drop(); }
 	
 	/*
 	 * Assignment operator (copy).
@@ -441,6 +736,12 @@ namespace DAC {
 	template <class T> inline ConstReferencePointer<T>& ConstReferencePointer<T>::operator = (ReferencePointer<T>      const& right) { reset(right); return *this; }
 	template <class T> inline ConstReferencePointer<T>& ConstReferencePointer<T>::operator = (ConstReferencePointer<T> const& right) { reset(right); return *this; }
 	
+	/*
+	 * Assignment operator (move).
+	 */
+	template <class T> inline ConstReferencePointer<T>& ConstReferencePointer<T>::operator = (ReferencePointer<T>&&      right) { ConstReferencePointer<T> tmp(std::move(right)); swap(tmp); return *this; }
+	template <class T> inline ConstReferencePointer<T>& ConstReferencePointer<T>::operator = (ConstReferencePointer<T>&& right) { ConstReferencePointer<T> tmp(std::move(right)); swap(tmp); return *this; }
+	
 	/*
 	 * Assignment operator (conversion).
 	 */
@@ -460,7 +761,7 @@ namespace DAC {
 	/*
 	 * Return the number of references to the pointer.
 	 */
-	template <class T> inline typename ConstReferencePointer<T>::RefCountT ConstReferencePointer<T>::refs () const { if (_refs == 0) { return 0; } else { return *_refs; } }
+	template <class T> inline typename ConstReferencePointer<T>::RefCountT ConstReferencePointer<T>::refs () const { if (_refs == 0) { return 0; } else { return _refs->Refs.get(); } }
 	
 	/*
 	 * Return true if the pointer is null.
@@ -475,34 +776,34 @@ namespace DAC {
 	/*
 	 * Get the pointer and release this reference.
 	 */
-	template <class T> inline T const* ConstReferencePointer<T>::release () { T const* tp = _p; _p = 0; _decrementRefs(); _refs = 0; return tp; }
+	template <class T> inline T const* ConstReferencePointer<T>::release () { T const* tp = _p; if (_refs != 0 && _refs->Refs.drop() == 0 && !_refs->detach()) { tp = 0; } _p = 0; _refs = 0; return tp; }
 	
 	/*
 	 * Set this pointer to point to a new pointer. (pointer)
 	 */
-	template <class T> inline void ConstReferencePointer<T>::reset (T*       const p) { if (_p != p) { if (_decrementRefs() == 0) { delete _p; } _p = p; if (_p == 0) { _refs = 0; } else { _refs = new int; *_refs = 1; } } }
-	template <class T> inline void ConstReferencePointer<T>::reset (T const* const p) { if (_p != p) { if (_decrementRefs() == 0) { delete _p; } _p = p; if (_p == 0) { _refs = 0; } else { _refs = new int; *_refs = 1; } } }
+	template <class T> inline void ConstReferencePointer<T>::reset (T*       const p) { reset(static_cast<T const*>(p)); }
+	template <class T> inline void ConstReferencePointer<T>::reset (T const* const p) { if (_p != p) { _drop(); _p = p; if (_p != 0) { _refs = ReferencePointerUtil::Counted<T>::adopt(const_cast<T*>(p)); _refs->Refs.add(); } } }
 	
 	/*
 	 * Set this pointer to point to an existing pointer. (ReferencePointer)
 	 */
-	template <class T> inline void ConstReferencePointer<T>::reset (ReferencePointer<T>      const& p) { if (_p != p._p) { if (_decrementRefs() == 0) { delete _p; } _p = p._p; if (_p == 0) { _refs = 0; } else { _refs = p._refs; if (_refs != 0) { ++(*_refs); } } } }
-	template <class T> inline void ConstReferencePointer<T>::reset (ConstReferencePointer<T> const& p) { if (_p != p._p) { if (_decrementRefs() == 0) { delete _p; } _p = p._p; if (_p == 0) { _refs = 0; } else { _refs = p._refs; if (_refs != 0) { ++(*_refs); } } } }
+	template <class T> inline void ConstReferencePointer<T>::reset (ReferencePointer<T>      const& p) { if (_p != p._p) { if (p._refs != 0) { p._refs->Refs.add(); } _drop(); _p = p._p; _refs = p._refs; } }
+	template <class T> inline void ConstReferencePointer<T>::reset (ConstReferencePointer<T> const& p) { if (_p != p._p) { if (p._refs != 0) { p._refs->Refs.add(); } _drop(); _p = p._p; _refs = p._refs; } }
 	
 	/*
 	 * Swap this pointer with another one.
 	 */
-	template <class T> inline void ConstReferencePointer<T>::swap (ConstReferencePointer<T>& p) { if (_p != p._p) { T* tmpp = _p; _p = p._p; p._p = tmpp; int* tmprefs = _refs; _refs = p._refs; p._refs = tmprefs; } }
+	template <class T> inline void ConstReferencePointer<T>::swap (ConstReferencePointer<T>& p) { std::swap(_p, p._p); std::swap(_refs, p._refs); }
 	
 	/*
-	 * Reset to just-constructed by default constructor state.
+	 * Release the current pointer.
 	 */
-	template <class T> inline void ConstReferencePointer<T>::clear () { _p = 0; _refs = 0; }
+	template <class T> inline void ConstReferencePointer<T>::clear () { reset(); }
 	
 	/*
-	 * Decrement the number of references to the pointer.
+	 * Drop this reference.
 	 */
-	template <class T> inline typename ConstReferencePointer<T>::RefCountT ConstReferencePointer<T>::_decrementRefs () { if (_refs != 0) { --(*_refs); if (*_refs == 0) { delete _refs; _refs = 0; } } return (_refs == 0) ? 0 : *_refs; }
+	template <class T> inline void ConstReferencePointer<T>::_drop () { ReferencePointerUtil::Block* const refs = _refs; _p = 0; _refs = 0; if (refs != 0 && refs->Refs.drop() == 0) { refs->destroy(); } }
 	
 }
 
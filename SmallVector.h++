@@ -0,0 +1,565 @@
+/*****************************************************************************
+ * SmallVector
+ *****************************************************************************
+ * Like std::vector, except the first few elements are stored in the object
+ * itself.
+ *****************************************************************************/
+
+// Include guard.
+#if !defined(SMALLVECTOR_8h3nf02kd9sj)
+	#define SMALLVECTOR_8h3nf02kd9sj
+
+// STL includes.
+	#include <algorithm>
+	#include <cstddef>
+	#include <cstring>
+	#include <iterator>
+	#include <new>
+	#include <type_traits>
+	#include <utility>
+
+// Internal includes.
+	#include "OpCounters.h++"
+	#include "ReferencePointer.h++"
+
+// Namespace container.
+namespace DAC {
+	
+	/***************************************************************************/
+	// Types.
+	
+	/***************************************************************************
+	 * SmallVector
+	 ***************************************************************************
+	 * A sequence of plain data that holds up to N elements without allocating
+	 * and only goes to the heap once it grows past that. Supports the parts of
+	 * the std::vector interface that a sequence of plain data needs.
+	 * Iterators are pointers, and are invalidated by anything that may
+	 * change the size, and by swap and move if the elements are inline.
+	 * 
+	 * If Shared, copies share heap storage until one of them is changed, and
+	 * anything that gives non-const access first makes a private copy. The
+	 * count is atomic, so a vector may be copied from several threads at once.
+	 * References and iterators from non-const access must not be held across
+	 * a copy of the vector.
+	 ***************************************************************************/
+	template <class T, size_t N, bool Shared = false> class SmallVector {
+		
+		// Elements are moved around with memmove.
+		static_assert(std::is_trivial<T>::value, "SmallVector only holds plain data.");
+		static_assert(N > 0, "SmallVector must have inline storage.");
+		
+		/*
+		 * Public members.
+		 */
+		public:
+			
+			/***********************************************************************/
+			// Typedefs.
+			
+			typedef T                                     value_type            ;
+			typedef size_t                                size_type             ;
+			typedef ptrdiff_t                             difference_type       ;
+			typedef T&                                    reference             ;
+			typedef T const&                              const_reference       ;
+			typedef T*                                    pointer               ;
+			typedef T const*                              const_pointer         ;
+			typedef T*                                    iterator              ;
+			typedef T const*                              const_iterator        ;
+			typedef std::reverse_iterator<iterator      > reverse_iterator      ;
+			typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+			
+			/***********************************************************************/
+			// Function members.
+			
+			// Default constructor.
+			SmallVector ();
+			
+			// Fill and range constructors.
+			explicit SmallVector (size_type const count, T const& value = T());
+			template <class InputIt> SmallVector (InputIt first, InputIt last, typename std::enable_if<!std::is_integral<InputIt>::value>::type* = 0);
+			
+			// Copy and move constructors. A moved-from SmallVector is empty.
+			SmallVector (SmallVector const& other);
+			SmallVector (SmallVector&&      other);
+			
+			// Destructor.
+			~SmallVector ();
+			
+			// Assignment operators.
+			SmallVector& operator = (SmallVector const& other);
+			SmallVector& operator = (SmallVector&&      other);
+			
+			// Iterators.
+			iterator               begin  ()      ;
+			const_iterator         begin  () const;
+			iterator               end    ()      ;
+			const_iterator         end    () const;
+			reverse_iterator       rbegin ()      ;
+			const_reverse_iterator rbegin () const;
+			reverse_iterator       rend   ()      ;
+			const_reverse_iterator rend   () const;
+			
+			// Element access.
+			reference       operator [] (size_type const pos)      ;
+			const_reference operator [] (size_type const pos) const;
+			reference       front       ()                         ;
+			const_reference front       ()                   const;
+			reference       back        ()                         ;
+			const_reference back        ()                   const;
+			pointer         data        ()                         ;
+			const_pointer   data        ()                   const;
+			
+			// Capacity.
+			bool      empty    ()                       const;
+			size_type size     ()                       const;
+			size_type capacity ()                       const;
+			void      reserve  (size_type const newcap)      ;
+			
+			// Modifiers.
+			                         void     clear     ();
+			                         void     push_back (T const& value);
+			                         void     pop_back  ();
+			                         void     resize    (size_type const count, T const& value = T());
+			                         void     assign    (size_type const count, T const& value);
+			template <class InputIt> void     assign    (InputIt first, InputIt last);
+			                         iterator insert    (const_iterator pos, T const& value);
+			                         iterator insert    (const_iterator pos, size_type const count, T const& value);
+			template <class InputIt> iterator insert    (const_iterator pos, InputIt first, InputIt last);
+			                         iterator erase     (const_iterator pos);
+			                         iterator erase     (const_iterator first, const_iterator last);
+			                         void     swap      (SmallVector& other);
+			
+			// Is the data inline or on the heap.
+			bool isInline () const;
+			
+			// Is the heap storage shared with another vector.
+			bool isShared () const;
+		
+		/*
+		 * Private members.
+		 */
+		private:
+			
+			/***********************************************************************/
+			// Data members.
+			
+			T*        _data    ; // The elements, either _inline or on the heap.
+			size_type _size    ; // Number of elements.
+			size_type _capacity; // Elements that fit in _data.
+			T         _inline[N]; // Storage for small sequences.
+			
+			/***********************************************************************/
+			// Function members.
+			
+			// Make room for count elements at pos, return where they go.
+			T* _open (size_type const pos, size_type const count);
+			
+			// Copy the elements of a vector that holds them inline.
+			void _assignInline (SmallVector const& other);
+			
+			// Make a private copy of shared storage before writing.
+			void _unshare ();
+			
+			// Stop sharing without keeping the contents.
+			void _detach ();
+			
+			// Heap storage. Shared storage is preceded by its reference count.
+			static T*                          s_allocate (size_type const capacity);
+			static void                        s_release  (T* const        data    );
+			static ReferencePointerUtil::Count* s_count    (T const* const  data    );
+			
+			// Space before the elements for the count, keeping them aligned.
+			static size_t const s_header = Shared ? ((sizeof(ReferencePointerUtil::Count) + alignof(T) - 1) / alignof(T)) * alignof(T) : 0;
+	
+	};
+	
+	/***************************************************************************/
+	// Functions.
+	
+	// Comparison operators, lexicographical like std::vector.
+	template <class T, size_t N, bool Shared> bool operator == (SmallVector<T, N, Shared> const& l, SmallVector<T, N, Shared> const& r);
+	template <class T, size_t N, bool Shared> bool operator != (SmallVector<T, N, Shared> const& l, SmallVector<T, N, Shared> const& r);
+	template <class T, size_t N, bool Shared> bool operator <  (SmallVector<T, N, Shared> const& l, SmallVector<T, N, Shared> const& r);
+	
+	/***************************************************************************
+	 * Inline and template definitions.
+	 ***************************************************************************/
+	
+	/*
+	 * Default constructor.
+	 */
+	template <class T, size_t N, bool Shared> inline SmallVector<T, N, Shared>::SmallVector () : _data(_inline), _size(0), _capacity(N) {}
+	
+	/*
+	 * Fill constructor.
+	 */
+	template <class T, size_t N, bool Shared> inline SmallVector<T, N, Shared>::SmallVector (size_type const count, T const& value) : _data(_inline), _size(0), _capacity(N) {
+		assign(count, value);
+	}
+	
+	/*
+	 * Range constructor.
+	 */
+	template <class T, size_t N, bool Shared> template <class InputIt> inline SmallVector<T, N, Shared>::SmallVector (InputIt first, InputIt last, typename std::enable_if<!std::is_integral<InputIt>::value>::type*) : _data(_inline), _size(0), _capacity(N) {
+		assign(first, last);
+	}
+	
+	/*
+	 * Copy constructor.
+	 */
+	template <class T, size_t N, bool Shared> inline SmallVector<T, N, Shared>::SmallVector (SmallVector const& other) : _data(_inline), _size(0), _capacity(N) {
+		*this = other;
+	}
+	
+	/*
+	 * Move constructor. Heap storage is taken, inline storage is copied.
+	 */
+	template <class T, size_t N, bool Shared> inline SmallVector<T, N, Shared>::SmallVector (SmallVector&& other) : _data(_inline), _size(0), _capacity(N) {
+		*this = std::move(other);
+	}
+	
+	/*
+	 * Destructor.
+	 */
+	template <class T, size_t N, bool Shared> inline SmallVector<T, N, Shared>::~SmallVector () {
+		if (!isInline()) {
+			s_release(_data);
+		}
+	}
+	
+	/*
+	 * Copy assignment.
+	 */
+	template <class T, size_t N, bool Shared> inline SmallVector<T, N, Shared>& SmallVector<T, N, Shared>::operator = (SmallVector const& other) {
+		
+		// Assigning to self or to storage already shared does nothing.
+		if (_data == other._data) {
+			_size = other._size;
+			return *this;
+		}
+		
+		// Copy inline elements, share the other's heap storage, or copy it.
+		if (other.isInline()) {
+			_assignInline(other);
+		} else if (Shared) {
+			s_count(other._data)->add();
+			if (!isInline()) {
+				s_release(_data);
+			}
+			_data     = other._data    ;
+			_size     = other._size    ;
+			_capacity = other._capacity;
+		} else {
+			assign(other.begin(), other.end());
+		}
+		
+		// Done.
+		return *this;
+	
+	}
+	
+	/*
+	 * Move assignment.
+	 */
+	template <class T, size_t N, bool Shared> SmallVector<T, N, Shared>& SmallVector<T, N, Shared>::operator = (SmallVector&& other) {
+		
+		// Moving to self does nothing.
+		if (this == &other) {
+			return *this;
+		}
+		
+		// Take the other's heap storage, or copy its inline elements.
+		if (other.isInline()) {
+			_assignInline(other);
+		} else {
+			if (!isInline()) {
+				s_release(_data);
+			}
+			_data           = other._data    ;
+			_capacity       = other._capacity;
+			_size           = other._size    ;
+			other._data     = other._inline  ;
+			other._capacity = N              ;
+		}
+		other._size = 0;
+		
+		// Done.
+		return *this;
+	
+	}
+	
+	/*
+	 * Iterators.
+	 */
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::iterator               SmallVector<T, N, Shared>::begin  ()       { _unshare(); return _data;             }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::const_iterator         SmallVector<T, N, Shared>::begin  () const { return _data;                         }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::iterator               SmallVector<T, N, Shared>::end    ()       { _unshare(); return _data + _size;     }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::const_iterator         SmallVector<T, N, Shared>::end    () const { return _data + _size;                 }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::reverse_iterator       SmallVector<T, N, Shared>::rbegin ()       { return reverse_iterator      (end  ()); }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::const_reverse_iterator SmallVector<T, N, Shared>::rbegin () const { return const_reverse_iterator(end  ()); }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::reverse_iterator       SmallVector<T, N, Shared>::rend   ()       { return reverse_iterator      (begin()); }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::const_reverse_iterator SmallVector<T, N, Shared>::rend   () const { return const_reverse_iterator(begin()); }
+	
+	/*
+	 * Element access.
+	 */
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::reference       SmallVector<T, N, Shared>::operator [] (size_type const pos)       { _unshare(); return _data[pos];       }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::const_reference SmallVector<T, N, Shared>::operator [] (size_type const pos) const {             return _data[pos];       }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::reference       SmallVector<T, N, Shared>::front       ()                          { _unshare(); return _data[0];         }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::const_reference SmallVector<T, N, Shared>::front       ()                    const {             return _data[0];         }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::reference       SmallVector<T, N, Shared>::back        ()                          { _unshare(); return _data[_size - 1]; }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::const_reference SmallVector<T, N, Shared>::back        ()                    const {             return _data[_size - 1]; }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::pointer         SmallVector<T, N, Shared>::data        ()                          { _unshare(); return _data;            }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::const_pointer   SmallVector<T, N, Shared>::data        ()                    const {             return _data;            }
+	
+	/*
+	 * Capacity.
+	 */
+	template <class T, size_t N, bool Shared> inline bool                                  SmallVector<T, N, Shared>::empty    () const { return _size == 0;       }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::size_type SmallVector<T, N, Shared>::size     () const { return _size;            }
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::size_type SmallVector<T, N, Shared>::capacity () const { return _capacity;        }
+	template <class T, size_t N, bool Shared> inline bool                                  SmallVector<T, N, Shared>::isInline () const { return _data == _inline; }
+	template <class T, size_t N, bool Shared> inline bool                                  SmallVector<T, N, Shared>::isShared () const { return Shared && !isInline() && s_count(_data)->get() != 1; }
+	
+	/*
+	 * Make sure there is room for at least newcap elements.
+	 */
+	template <class T, size_t N, bool Shared> void SmallVector<T, N, Shared>::reserve (size_type const newcap) {
+		
+		// Only work if necessary.
+		if (newcap <= _capacity) {
+			return;
+		}
+		
+		// Grow geometrically so that push_back is amortized constant.
+		size_type const grown   = _capacity << 1;
+		size_type const cap     = (newcap > grown) ? newcap : grown;
+		T*        const newdata = s_allocate(cap);
+		if (_size) {
+			std::memcpy(newdata, _data, _size * sizeof(T));
+		}
+		if (!isInline()) {
+			s_release(_data);
+		}
+		_data     = newdata;
+		_capacity = cap    ;
+	
+	}
+	
+	/*
+	 * Modifiers.
+	 */
+	template <class T, size_t N, bool Shared> inline void SmallVector<T, N, Shared>::clear () { _size = 0; }
+	template <class T, size_t N, bool Shared> inline void SmallVector<T, N, Shared>::push_back (T const& value) {
+		if (_size == _capacity) {
+			T const tmp(value);
+			reserve(_size + 1);
+			_data[_size++] = tmp;
+		} else {
+			_unshare();
+			_data[_size++] = value;
+		}
+	}
+	template <class T, size_t N, bool Shared> inline void SmallVector<T, N, Shared>::pop_back () { --_size; }
+	template <class T, size_t N, bool Shared> inline void SmallVector<T, N, Shared>::resize (size_type const count, T const& value) {
+		if (count > _size) {
+			T const tmp(value);
+			reserve(count);
+			_unshare();
+			for (size_type i = _size; i != count; ++i) {
+				_data[i] = tmp;
+			}
+		}
+		_size = count;
+	}
+	template <class T, size_t N, bool Shared> inline void SmallVector<T, N, Shared>::assign (size_type const count, T const& value) {
+		T const tmp(value);
+		_detach();
+		_size = 0;
+		resize(count, tmp);
+	}
+	template <class T, size_t N, bool Shared> template <class InputIt> void SmallVector<T, N, Shared>::assign (InputIt first, InputIt last) {
+		
+		// Ranges that can be measured are copied straight in, allocating
+		// once if they do not fit. A range from inside this vector always
+		// fits, and copying front to back never overwrites it before it is
+		// read. Storage shared with another vector stays alive while it is
+		// read.
+		_detach();
+		typedef typename std::iterator_traits<InputIt>::iterator_category category;
+		if (std::is_base_of<std::forward_iterator_tag, category>::value) {
+			size_type const count = std::distance(first, last);
+			if (count > _capacity) {
+				_size = 0;
+				reserve(count);
+			}
+			for (size_type i = 0; first != last; ++first, ++i) {
+				_data[i] = *first;
+			}
+			_size = count;
+			return;
+		}
+		
+		// Otherwise build it on the side.
+		SmallVector tmp;
+		for (; first != last; ++first) {
+			tmp.push_back(*first);
+		}
+		swap(tmp);
+	
+	}
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::iterator SmallVector<T, N, Shared>::insert (const_iterator pos, T const& value) {
+		return insert(pos, 1, value);
+	}
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::iterator SmallVector<T, N, Shared>::insert (const_iterator pos, size_type const count, T const& value) {
+		T const tmp (value);
+		T*      dest(_open(pos - _data, count));
+		for (size_type i = 0; i != count; ++i) {
+			dest[i] = tmp;
+		}
+		return dest;
+	}
+	template <class T, size_t N, bool Shared> template <class InputIt> inline typename SmallVector<T, N, Shared>::iterator SmallVector<T, N, Shared>::insert (const_iterator pos, InputIt first, InputIt last) {
+		SmallVector tmp (first, last);
+		T*          dest(_open(pos - _data, tmp._size));
+		if (tmp._size) {
+			std::memcpy(dest, tmp._data, tmp._size * sizeof(T));
+		}
+		return dest;
+	}
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::iterator SmallVector<T, N, Shared>::erase (const_iterator pos) {
+		return erase(pos, pos + 1);
+	}
+	template <class T, size_t N, bool Shared> inline typename SmallVector<T, N, Shared>::iterator SmallVector<T, N, Shared>::erase (const_iterator first, const_iterator last) {
+		size_type const begin = first - _data;
+		size_type const count = last  - first;
+		if (count) {
+			_unshare();
+			std::memmove(_data + begin, _data + begin + count, (_size - begin - count) * sizeof(T));
+			_size -= count;
+		}
+		return _data + begin;
+	}
+	
+	/*
+	 * Swap with another SmallVector.
+	 */
+	template <class T, size_t N, bool Shared> void SmallVector<T, N, Shared>::swap (SmallVector& other) {
+		
+		// Two heap vectors only trade pointers.
+		if (!isInline() && !other.isInline()) {
+			std::swap(_data    , other._data    );
+			std::swap(_size    , other._size    );
+			std::swap(_capacity, other._capacity);
+		
+		// Otherwise go through a third.
+		} else if (this != &other) {
+			SmallVector tmp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(tmp  );
+		}
+	
+	}
+	
+	/*
+	 * Make room for count elements at pos, return where they go.
+	 */
+	template <class T, size_t N, bool Shared> T* SmallVector<T, N, Shared>::_open (size_type const pos, size_type const count) {
+		reserve(_size + count);
+		_unshare();
+		if (pos != _size) {
+			std::memmove(_data + pos + count, _data + pos, (_size - pos) * sizeof(T));
+		}
+		_size += count;
+		return _data + pos;
+	}
+	
+	/*
+	 * Copy the elements of a vector that holds them inline. There are never
+	 * more than N of them, so they always fit.
+	 */
+	template <class T, size_t N, bool Shared> inline void SmallVector<T, N, Shared>::_assignInline (SmallVector const& other) {
+		size_type const count = (other._size < N) ? other._size : N;
+		_detach();
+		if (count) {
+			std::memcpy(_data, other._inline, count * sizeof(T));
+		}
+		_size = count;
+	}
+	
+	/*
+	 * Make a private copy of shared storage before writing.
+	 */
+	template <class T, size_t N, bool Shared> inline void SmallVector<T, N, Shared>::_unshare () {
+		if (isShared()) {
+			T* const newdata = s_allocate(_capacity);
+			std::memcpy(newdata, _data, _size * sizeof(T));
+			s_release(_data);
+			_data = newdata;
+		}
+	}
+	
+	/*
+	 * Stop sharing without keeping the contents. The other owner keeps the
+	 * old storage alive.
+	 */
+	template <class T, size_t N, bool Shared> inline void SmallVector<T, N, Shared>::_detach () {
+		if (isShared()) {
+			s_release(_data);
+			_data     = _inline;
+			_size     = 0      ;
+			_capacity = N      ;
+		}
+	}
+	
+	/*
+	 * Heap storage.
+	 */
+	template <class T, size_t N, bool Shared> inline T* SmallVector<T, N, Shared>::s_allocate (size_type const capacity) {
+		char* const block = static_cast<char*>(::operator new(s_header + capacity * sizeof(T)));
+		OpCounters::add(OpCounters::ALLOCATIONS);
+		if (Shared) {
+			new (block) ReferencePointerUtil::Count;
+			reinterpret_cast<ReferencePointerUtil::Count*>(block)->add();
+		}
+		return reinterpret_cast<T*>(block + s_header);
+	}
+	template <class T, size_t N, bool Shared> inline void SmallVector<T, N, Shared>::s_release (T* const data) {
+		if (Shared) {
+			ReferencePointerUtil::Count* const count = s_count(data);
+			if (count->drop() != 0) {
+				return;
+			}
+			count->~Count();
+		}
+		::operator delete(reinterpret_cast<char*>(data) - s_header);
+	}
+	template <class T, size_t N, bool Shared> inline ReferencePointerUtil::Count* SmallVector<T, N, Shared>::s_count (T const* const data) {
+		return reinterpret_cast<ReferencePointerUtil::Count*>(const_cast<char*>(reinterpret_cast<char const*>(data)) - s_header);
+	}
+	
+	/*
+	 * Comparison operators.
+	 */
+	template <class T, size_t N, bool Shared> inline bool operator == (SmallVector<T, N, Shared> const& l, SmallVector<T, N, Shared> const& r) {
+		if (l.size() != r.size()) {
+			return false;
+		}
+		for (typename SmallVector<T, N, Shared>::size_type i = 0; i != l.size(); ++i) {
+			if (!(l[i] == r[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+	template <class T, size_t N, bool Shared> inline bool operator != (SmallVector<T, N, Shared> const& l, SmallVector<T, N, Shared> const& r) {
+		return !(l == r);
+	}
+	template <class T, size_t N, bool Shared> inline bool operator < (SmallVector<T, N, Shared> const& l, SmallVector<T, N, Shared> const& r) {
+		return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end());
+	}
+
+}
+
+#endif
@@ -0,0 +1,233 @@
+/*****************************************************************************
+ * StringView
+ *****************************************************************************
+ * A read-only reference to a run of characters owned by someone else.
+ *****************************************************************************/
+
+// Include guard.
+#if !defined(STRINGVIEW_u3k8d0x7qm2c)
+	#define STRINGVIEW_u3k8d0x7qm2c
+
+// STL includes.
+	#include <algorithm>
+	#include <cstddef>
+	#include <cstring>
+	#include <string>
+
+// Namespace container.
+namespace DAC {
+
+	/***************************************************************************
+	 * StringView
+	 ***************************************************************************
+	 * A pointer and a length. Never allocates and never owns; the characters
+	 * must outlive the view. Supports the parts of the std::string interface
+	 * that searching and comparing need, with the same npos conventions.
+	 ***************************************************************************/
+	class StringView {
+	
+		/*
+		 * Public members.
+		 */
+		public:
+		
+			/***********************************************************************/
+			// Typedefs.
+			
+			typedef char        value_type    ;
+			typedef size_t      size_type     ;
+			typedef char const* const_iterator;
+			typedef char const* iterator      ;
+			
+			/***********************************************************************/
+			// Constants.
+			
+			// Not found, same as std::string.
+			static size_type const npos = static_cast<size_type>(-1);
+			
+			/***********************************************************************/
+			// Function members.
+			
+			// Default constructor, an empty view.
+			StringView ();
+			
+			// View a string, a C string, or a run of characters. Views of
+			// strings are made explicitly, so that a view cannot quietly be
+			// left pointing into a temporary.
+			explicit StringView (std::string const& text);
+			         StringView (char const* const  text);
+			StringView (char const* const  text, size_type const size);
+			
+			// Iterators.
+			const_iterator begin () const;
+			const_iterator end   () const;
+			
+			// Properties.
+			char const* data  () const;
+			size_type   size  () const;
+			bool        empty () const;
+			
+			// Characters.
+			char operator [] (size_type const pos) const;
+			char front       (                   ) const;
+			char back        (                   ) const;
+			
+			// Part of this view.
+			StringView substr (size_type const pos, size_type const count = npos) const;
+			
+			// Search, same as std::string.
+			size_type find              (char       const  c    , size_type const pos = 0   ) const;
+			size_type find_first_of     (StringView const& chars, size_type const pos = 0   ) const;
+			size_type find_first_not_of (StringView const& chars, size_type const pos = 0   ) const;
+			size_type find_last_not_of  (StringView const& chars, size_type const pos = npos) const;
+			
+			// Compare, same as std::string.
+			int compare (StringView const& other) const;
+			
+			// Copy into a string.
+			std::string& to_string (std::string& buffer) const;
+			std::string  to_string (                   ) const;
+		
+		/*
+		 * Private members.
+		 */
+		private:
+		
+			/***********************************************************************/
+			// Data members.
+			
+			// The characters.
+			char const* _data;
+			size_type   _size;
+	
+	};
+	
+	/***************************************************************************/
+	// Operators.
+	
+	// Comparison.
+	bool operator == (StringView const& l, StringView const& r);
+	bool operator != (StringView const& l, StringView const& r);
+	bool operator <  (StringView const& l, StringView const& r);
+	
+	/***************************************************************************
+	 * Inline and template definitions.
+	 ***************************************************************************/
+	
+	/***************************************************************************
+	 * StringView
+	 ***************************************************************************/
+	
+	/***************************************************************************/
+	// Function members.
+	
+	/*
+	 * Constructors.
+	 */
+	inline StringView::StringView (                                            ) : _data(""         ), _size(0                ) {}
+	inline StringView::StringView (std::string const& text                     ) : _data(text.data()), _size(text.size()      ) {}
+	inline StringView::StringView (char const* const  text                     ) : _data(text       ), _size(std::strlen(text)) {}
+	inline StringView::StringView (char const* const  text, size_type const size) : _data(text       ), _size(size             ) {}
+	
+	/*
+	 * Iterators.
+	 */
+	inline StringView::const_iterator StringView::begin () const { return _data        ; }
+	inline StringView::const_iterator StringView::end   () const { return _data + _size; }
+	
+	/*
+	 * Properties.
+	 */
+	inline char const*           StringView::data  () const { return _data     ; }
+	inline StringView::size_type StringView::size  () const { return _size     ; }
+	inline bool                  StringView::empty () const { return _size == 0; }
+	
+	/*
+	 * Characters.
+	 */
+	inline char StringView::operator [] (size_type const pos) const { return _data[pos]      ; }
+	inline char StringView::front       (                   ) const { return _data[0]        ; }
+	inline char StringView::back        (                   ) const { return _data[_size - 1]; }
+	
+	/*
+	 * Part of this view.
+	 */
+	inline StringView StringView::substr (size_type const pos, size_type const count) const {
+		size_type const start = std::min(pos, _size);
+		return StringView(_data + start, std::min(count, _size - start));
+	}
+	
+	/*
+	 * Find a character.
+	 */
+	inline StringView::size_type StringView::find (char const c, size_type const pos) const {
+		if (pos >= _size) {
+			return npos;
+		}
+		void const* const found = std::memchr(_data + pos, c, _size - pos);
+		return found ? static_cast<char const*>(found) - _data : npos;
+	}
+	
+	/*
+	 * Find the first character that is, or is not, one of a set.
+	 */
+	inline StringView::size_type StringView::find_first_of (StringView const& chars, size_type const pos) const {
+		for (size_type i = pos; i < _size; ++i) {
+			if (chars.find(_data[i]) != npos) {
+				return i;
+			}
+		}
+		return npos;
+	}
+	inline StringView::size_type StringView::find_first_not_of (StringView const& chars, size_type const pos) const {
+		for (size_type i = pos; i < _size; ++i) {
+			if (chars.find(_data[i]) == npos) {
+				return i;
+			}
+		}
+		return npos;
+	}
+	
+	/*
+	 * Find the last character that is not one of a set.
+	 */
+	inline StringView::size_type StringView::find_last_not_of (StringView const& chars, size_type const pos) const {
+		for (size_type i = std::min(pos, _size - 1) + 1; _size && i-- != 0; ) {
+			if (chars.find(_data[i]) == npos) {
+				return i;
+			}
+		}
+		return npos;
+	}
+	
+	/*
+	 * Compare with another view.
+	 */
+	inline int StringView::compare (StringView const& other) const {
+		int const retval = std::memcmp(_data, other._data, std::min(_size, other._size));
+		if (retval) {
+			return retval;
+		}
+		return (_size < other._size) ? -1 : (_size > other._size) ? 1 : 0;
+	}
+	
+	/*
+	 * Copy into a string.
+	 */
+	inline std::string& StringView::to_string (std::string& buffer) const { buffer.assign(_data, _size); return buffer; }
+	inline std::string  StringView::to_string (                   ) const { return std::string(_data, _size);           }
+	
+	/***************************************************************************/
+	// Operators.
+	
+	/*
+	 * Comparison.
+	 */
+	inline bool operator == (StringView const& l, StringView const& r) { return l.size() == r.size() && std::memcmp(l.data(), r.data(), l.size()) == 0; }
+	inline bool operator != (StringView const& l, StringView const& r) { return !(l == r);                                                                 }
+	inline bool operator <  (StringView const& l, StringView const& r) { return l.compare(r) < 0;                                                         }
+
+}
+
+// End include guard.
+#endif
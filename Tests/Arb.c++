@@ -0,0 +1,255 @@
+/*****************************************************************************
+ * Arb.c++
+ *****************************************************************************
+ * Tests the Arb class.
+ *****************************************************************************/
+
+// Standard includes.
+#include <string>
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <type_traits>
+
+// Testing include.
+#include "Arb.h++"
+#include "testcommon.h++"
+
+// Bring in namespaces.
+using namespace std;
+using namespace DAC;
+
+// Tests.
+int test_reduce_known ();
+int test_reduce_chains ();
+int test_root_known ();
+int test_temporaries ();
+
+// Run a chain of operations and describe every result.
+string run_chain (unsigned int seed, bool const fixed);
+
+/*
+ * Run a chain of operations and describe every result.
+ */
+string run_chain (unsigned int seed, bool const fixed) {
+
+  string retval;
+
+  Arb number(1);
+  number.Fixed(fixed);
+  for (int i = 0; i != 120; ++i) {
+
+    // A random operation with a random operand.
+    unsigned int const random = next_random(seed);
+    Arb operand(static_cast<int>((random >> 8) % 97) - 48);
+    operand /= static_cast<int>(random % 31) + 1;
+    switch ((random >> 16) % 6) {
+      case 0: number += operand; break;
+      case 1: number -= operand; break;
+      case 2: if (operand != 0) { number *= operand; } break;
+      case 3: if (operand != 0) { number /= operand; } break;
+      case 4: number += static_cast<int>(random % 7); break;
+      case 5: number *= static_cast<int>(random % 5) + 1; break;
+    }
+
+    // Everything observable.
+    retval += number.to_string(Arb::FMT_RADIX) + " " + number.to_string(Arb::FMT_FRACTION) + " " + (number.isInteger() ? "i" : "f") + (number < operand ? "<" : number == operand ? "=" : ">") + "\n";
+
+  }
+
+  return retval;
+
+}
+
+/*
+ * Deferred reduction with known results.
+ */
+int test_reduce_known () {
+
+  cout << "  Known fractions... ";
+
+  // Harmonic sum, never reduced along the way but always output in lowest
+  // terms.
+  Arb harmonic;
+  for (int k = 1; k <= 20; ++k) {
+    harmonic += Arb(1) / Arb(k);
+  }
+  if (harmonic.to_string(Arb::FMT_FRACTION) != "55835135/15519504" || (-harmonic).to_string(Arb::FMT_FRACTION) != "-55835135/15519504") {
+    cout << "Harmonic FAILED!" << endl;
+    return 1;
+  }
+
+  // A product that cancels down to an integer.
+  Arb product(1);
+  for (int k = 1; k <= 50; ++k) {
+    product *= Arb(k + 1) / Arb(k);
+  }
+  if (!product.isInteger() || product != 51) {
+    cout << "Product FAILED!" << endl;
+    return 1;
+  }
+
+  // Equal values compare equal however they were built.
+  Arb third(1);
+  third /= 3;
+  Arb sixths(Arb(1) / Arb(6));
+  sixths += Arb(1) / Arb(6);
+  if (third != sixths || !(third <= sixths) || third < sixths || !(Arb(1) / Arb(3) < Arb(1) / Arb(2)) || Arb(2) / Arb(3) < Arb(1) / Arb(2)) {
+    cout << "Compare FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Check that deferring reduction does not change any result.
+ */
+int test_reduce_chains () {
+
+  size_t const threshold = Arb::reduce_threshold;
+
+  for (unsigned int seed = 1; seed != 9; ++seed) {
+    for (int fixed = 0; fixed != 2; ++fixed) {
+
+      cout << "  Chain " << seed << (fixed ? " fixed" : "") << "... ";
+
+      // Reduce every time, then defer by default and without limit.
+      Arb::reduce_threshold = 0;
+      string control(run_chain(seed, fixed));
+      Arb::reduce_threshold = threshold;
+      string deferred(run_chain(seed, fixed));
+      Arb::reduce_threshold = numeric_limits<size_t>::max();
+      string unlimited(run_chain(seed, fixed));
+      Arb::reduce_threshold = threshold;
+
+      if (deferred != control || unlimited != control) {
+        cout << "FAILED!" << endl;
+        return 1;
+      }
+
+      cout << "OK!" << endl;
+
+    }
+  }
+
+  return 0;
+
+}
+
+/*
+ * Roots and fractional powers with known results.
+ */
+int test_root_known () {
+
+  cout << "  Known roots... ";
+
+  // Rounded to MaxRadix digits.
+  if (Arb(2).root(2).to_string() != "1.4142135624" || Arb(-2).root(3).to_string() != "-1.2599210499" || Arb(2).root(-2).to_string() != "0.7071067812") {
+    cout << "Irrational FAILED!" << endl;
+    return 1;
+  }
+
+  // Exact roots are exact.
+  if (Arb(16).root(4) != 2 || Arb(-8).root(3) != -2 || (Arb(9) / Arb(4)).root(2) != Arb(3) / Arb(2)) {
+    cout << "Exact FAILED!" << endl;
+    return 1;
+  }
+
+  // Small numbers keep their significant digits.
+  if (Arb(string("0.000000000000000000000002")).root(2).to_string() != "0.000000000001414213562") {
+    cout << "Small FAILED!" << endl;
+    return 1;
+  }
+
+  // Fractional powers, at the precision of the base.
+  Arb number(string("12345.6789"));
+  number.MaxRadix(50);
+  Arb power;
+  power.MaxRadix(50);
+  power = number.pow(Arb(string("1.5")));
+  if (power.to_string() != "1371742.09375857343080075452276843300510639996575812609188" || Arb(4).pow(Arb(string("-1.5"))) != Arb(1) / Arb(8)) {
+    cout << "Power FAILED!" << endl;
+    return 1;
+  }
+
+  // Even roots of negative numbers.
+  try {
+    Arb(-2).root(2);
+    cout << "Complex FAILED!" << endl;
+    return 1;
+  } catch (Arb::Errors::Complex&) {
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Expressions that work on their temporaries in place.
+ */
+int test_temporaries () {
+
+  cout << "  Temporaries... ";
+
+  // Mixed expressions keep the type of the widest operand.
+  static_assert(is_same<decltype(Arb    (2) * Arb   (3)), Arb>::value, "Arb * Arb");
+  static_assert(is_same<decltype(ArbInt (2) * Arb   (3)), Arb>::value, "ArbInt * Arb");
+  static_assert(is_same<decltype(UArbInt(2) - Arb   (3)), Arb>::value, "UArbInt - Arb");
+  static_assert(is_same<decltype(Arb    (2) / ArbInt(3)), Arb>::value, "Arb / ArbInt");
+  static_assert(is_same<decltype(Arb    (2) + 3        ), Arb>::value, "Arb + int");
+
+  // Named operands are left alone, temporaries give the same results.
+  Arb const x(7);
+  Arb const y(Arb(1) / 3);
+  Arb const n(3);
+  Arb const expected((x / y + y) / n);
+  string const text(expected.to_string(Arb::FMT_FRACTION));
+  if ((Arb(x) / y + y) / n != expected || (x / y + y) / n != expected || ((x / y + y) / n).to_string(Arb::FMT_FRACTION) != text) {
+    cout << "Value FAILED!" << endl;
+    return 1;
+  }
+  if (x != 7 || y * 3 != 1 || n != 3) {
+    cout << "Operands FAILED!" << endl;
+    return 1;
+  }
+  if (ArbInt(-4) * Arb(y) != Arb(-4) / 3 || ArbInt(-4) / Arb(y) != -12 || UArbInt(1) - Arb(y) != Arb(2) / 3 || (Arb(y) << 3) != Arb(8) / 3 || Arb(x) % ArbInt(4) != 3 || Arb(x) - 10 != -3) {
+    cout << "Mixed FAILED!" << endl;
+    return 1;
+  }
+
+  // A named number can be given up to an expression.
+  Arb used(x);
+  Arb const result(std::move(used) * 2);
+  if (result != 14) {
+    cout << "Move FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Main.
+ */
+int main () {
+
+  cout << "Testing Arb deferred reduction..." << endl;
+  if (test_reduce_known ()) { return 1; }
+  if (test_reduce_chains()) { return 1; }
+  cout << "Testing Arb roots..." << endl;
+  if (test_root_known()) { return 1; }
+  cout << "Testing Arb temporaries..." << endl;
+  if (test_temporaries()) { return 1; }
+
+  // All tests passed.
+  cout << "OK!" << endl;
+  return 0;
+
+}
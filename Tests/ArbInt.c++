@@ -0,0 +1,638 @@
+/*****************************************************************************
+ * ArbInt.c++
+ *****************************************************************************
+ * Tests the ArbInt and UArbInt classes.
+ *****************************************************************************/
+
+// Standard includes.
+#include <string>
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+// Testing include.
+#include "ArbInt.h++"
+#include "testcommon.h++"
+
+// Bring in namespaces.
+using namespace std;
+using namespace DAC;
+
+// Tests.
+int test_mul_known ();
+int test_mul_algorithms ();
+int test_div_known ();
+int test_div_algorithms ();
+int test_conv_known ();
+int test_conv_algorithms ();
+int test_gcd_known ();
+int test_gcd_algorithms ();
+int test_root_known ();
+int test_root_algorithms ();
+int test_temporaries ();
+
+// Build a pseudo-random number of a given number of hex digits.
+UArbInt random_number (string::size_type const digits, unsigned int& seed);
+
+/*
+ * Build a pseudo-random number of a given number of hex digits.
+ */
+UArbInt random_number (string::size_type const digits, unsigned int& seed) {
+
+  // Random digits.
+  static char const hexdigits[] = "0123456789ABCDEF";
+  string number;
+  for (string::size_type i = 0; i != digits; ++i) {
+    number += hexdigits[(next_random(seed) >> 8) & 0xF];
+  }
+
+  // Occasionally leave long runs of all-ones or zeros to exercise carries.
+  if (digits > 8 && (seed & 0x30000) == 0) {
+    number.replace(digits / 4, digits / 2, digits / 2, 'F');
+  } else if (digits > 8 && (seed & 0x30000) == 0x10000) {
+    number.replace(digits / 4, digits / 2, digits / 2, '0');
+  }
+
+  return UArbInt().Base(16).set(number, false);
+
+}
+
+/*
+ * Multiply numbers with known products.
+ */
+int test_mul_known () {
+
+  cout << "  Known products... ";
+
+  // 2^64 - 1 squared.
+  if ((UArbInt(string("18446744073709551615")) * UArbInt(string("18446744073709551615"))).to_string() != "340282366920938463426481119284349108225") {
+    cout << "2^64 - 1 squared FAILED!" << endl;
+    return 1;
+  }
+
+  // 3^200 through pow().
+  if (UArbInt(3).pow(200).to_string() != "265613988875874769338781322035779626829233452653394495974574961739092490901302182994384699044001") {
+    cout << "3^200 FAILED!" << endl;
+    return 1;
+  }
+
+  // Zero and one.
+  if (!(UArbInt(string("123456789012345678901234567890")) * UArbInt(0)).isZero() || UArbInt(string("123456789012345678901234567890")) * UArbInt(1) != UArbInt(string("123456789012345678901234567890"))) {
+    cout << "Multiply by 0 or 1 FAILED!" << endl;
+    return 1;
+  }
+
+  // Squaring in place.
+  UArbInt square(string("340282366920938463463374607431768211455"));
+  square *= square;
+  if (square.to_string() != "115792089237316195423570985008687907852589419931798687112530834793049593217025") {
+    cout << "In-place square FAILED!" << endl;
+    return 1;
+  }
+
+  // ArbInt signs.
+  if ((ArbInt(string("-12345678901234567890")) * ArbInt(string("98765432109876543210"))).to_string() != "-1219326311370217952237463801111263526900") {
+    cout << "Signed multiply FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Check that every multiplication algorithm agrees with schoolbook.
+ */
+int test_mul_algorithms () {
+
+  // Sizes in hex digits, 8 to a limb. Covers balanced, unbalanced, and
+  // lengths that do not split evenly.
+  static string::size_type const sizes[] = { 1, 7, 64, 255, 256, 257, 777, 1024, 1500, 4099 };
+  static size_t const numsizes = sizeof(sizes) / sizeof(sizes[0]);
+
+  size_t       const karatsuba = UArbInt::karatsuba_threshold;
+  size_t       const toom3     = UArbInt::toom3_threshold;
+  size_t       const newton    = UArbInt::newton_threshold;
+  unsigned int       seed      = 42;
+
+  for (size_t i = 0; i != numsizes; ++i) {
+    for (size_t j = 0; j <= i; ++j) {
+
+      cout << "  " << sizes[i] << " x " << sizes[j] << " hex digits... ";
+
+      UArbInt l(random_number(sizes[i], seed));
+      UArbInt r(random_number(sizes[j], seed));
+
+      // Reference product, schoolbook only.
+      UArbInt::karatsuba_threshold = numeric_limits<size_t>::max();
+      UArbInt::toom3_threshold     = numeric_limits<size_t>::max();
+      UArbInt control(l * r);
+
+      // Karatsuba all the way down.
+      UArbInt::karatsuba_threshold = 2;
+      UArbInt::toom3_threshold     = numeric_limits<size_t>::max();
+      UArbInt karaprod(l * r);
+
+      // Toom-3 all the way down.
+      UArbInt::karatsuba_threshold = 2;
+      UArbInt::toom3_threshold     = 3;
+      UArbInt toomprod(r * l);
+
+      // Defaults.
+      UArbInt::karatsuba_threshold = karatsuba;
+      UArbInt::toom3_threshold     = toom3;
+      UArbInt defprod(l * r);
+
+      if (karaprod != control || toomprod != control || defprod != control) {
+        cout << "FAILED!" << endl;
+        return 1;
+      }
+
+      // Check against long division, which does not share any code with
+      // multiplication.
+      UArbInt::newton_threshold = numeric_limits<size_t>::max();
+      if (!r.isZero() && (control / r != l || !(control % r).isZero())) {
+        cout << "Division check FAILED!" << endl;
+        return 1;
+      }
+      UArbInt::newton_threshold = newton;
+
+      cout << "OK!" << endl;
+
+    }
+  }
+
+  return 0;
+
+}
+
+/*
+ * Divide numbers with known results.
+ */
+int test_div_known () {
+
+  cout << "  Known quotients... ";
+
+  // Quotient digit guesses that need correcting.
+  UArbInt quotient;
+  UArbInt remainder;
+  UArbInt(string("340282366920938463463374607431768211455")).divmod(UArbInt(string("18446744073709551616")), quotient, remainder);
+  if (quotient.to_string() != "18446744073709551615" || remainder.to_string() != "18446744073709551615") {
+    cout << "2^128 - 1 / 2^64 FAILED!" << endl;
+    return 1;
+  }
+  UArbInt(string("340282366920938463426481119284349108225")).divmod(UArbInt(string("18446744073709551615")), quotient, remainder);
+  if (quotient.to_string() != "18446744073709551615" || !remainder.isZero()) {
+    cout << "(2^64 - 1)^2 / (2^64 - 1) FAILED!" << endl;
+    return 1;
+  }
+
+  // Divisor larger than dividend.
+  UArbInt(12345).divmod(UArbInt(string("123456789012345678901234567890")), quotient, remainder);
+  if (!quotient.isZero() || remainder != 12345) {
+    cout << "Small / large FAILED!" << endl;
+    return 1;
+  }
+
+  // Results written over an operand.
+  UArbInt number(string("98765432109876543210987654321"));
+  number.divmod(UArbInt(string("1234567890123")), number, remainder);
+  if (number.to_string() != "80000000729029606" || remainder.to_string() != "694365672783") {
+    cout << "In-place quotient FAILED!" << endl;
+    return 1;
+  }
+  number = string("98765432109876543210987654321");
+  number.divmod(UArbInt(string("1234567890123")), quotient, number);
+  if (quotient.to_string() != "80000000729029606" || number.to_string() != "694365672783") {
+    cout << "In-place remainder FAILED!" << endl;
+    return 1;
+  }
+
+  // Division by zero.
+  try {
+    UArbInt(1).divmod(UArbInt(0), quotient, remainder);
+    cout << "Divide by zero FAILED!" << endl;
+    return 1;
+  } catch (UArbInt::Errors::DivByZero&) {}
+
+  // ArbInt signs, truncated toward zero.
+  ArbInt squotient;
+  ArbInt sremainder;
+  ArbInt(-7).divmod(ArbInt(2), squotient, sremainder);
+  if (squotient != -3 || sremainder != -1) {
+    cout << "-7 / 2 FAILED!" << endl;
+    return 1;
+  }
+  ArbInt(7).divmod(ArbInt(-2), squotient, sremainder);
+  if (squotient != -3 || sremainder != 1) {
+    cout << "7 / -2 FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Check that long division and Newton division agree.
+ */
+int test_div_algorithms () {
+
+  // Sizes in hex digits, 8 to a limb.
+  static string::size_type const sizes[] = { 9, 17, 130, 513, 1111, 2048, 4099 };
+  static size_t const numsizes = sizeof(sizes) / sizeof(sizes[0]);
+
+  size_t       const newton = UArbInt::newton_threshold;
+  unsigned int       seed   = 7;
+
+  for (size_t i = 0; i != numsizes; ++i) {
+    for (size_t j = 0; j <= i; ++j) {
+
+      cout << "  " << sizes[i] << " / " << sizes[j] << " hex digits... ";
+
+      UArbInt l(random_number(sizes[i], seed));
+      UArbInt r(random_number(sizes[j], seed));
+      if (r.isZero()) {
+        r = 1;
+      }
+
+      // Long division only.
+      UArbInt quotient;
+      UArbInt remainder;
+      UArbInt::newton_threshold = numeric_limits<size_t>::max();
+      l.divmod(r, quotient, remainder);
+
+      // Newton all the way down.
+      UArbInt nquotient;
+      UArbInt nremainder;
+      UArbInt::newton_threshold = 2;
+      l.divmod(r, nquotient, nremainder);
+      UArbInt::newton_threshold = newton;
+
+      if (remainder >= r || quotient * r + remainder != l) {
+        cout << "FAILED!" << endl;
+        return 1;
+      }
+      if (nquotient != quotient || nremainder != remainder) {
+        cout << "Newton FAILED!" << endl;
+        return 1;
+      }
+      if (l / r != quotient || l % r != remainder) {
+        cout << "Operators FAILED!" << endl;
+        return 1;
+      }
+
+      cout << "OK!" << endl;
+
+    }
+  }
+
+  return 0;
+
+}
+
+/*
+ * Convert numbers with known digits.
+ */
+int test_conv_known () {
+
+  cout << "  Known conversions... ";
+
+  // Zero, and the autobase prefixes.
+  if (UArbInt(0).to_string() != "0" || UArbInt(string("")).to_string() != "0") {
+    cout << "Zero FAILED!" << endl;
+    return 1;
+  }
+  if (UArbInt(string("0xFFFFFFFFFFFFFFFF")).to_string() != "18446744073709551615" || UArbInt(string("0b101")) != 5 || UArbInt(string("0777")) != 511) {
+    cout << "Autobase FAILED!" << endl;
+    return 1;
+  }
+  if (UArbInt(string("18446744073709551616")).to_string(36) != "3W5E11264SGSG" || UArbInt(string("18446744073709551616")).to_string(2) != "1" + string(64, '0')) {
+    cout << "Output base FAILED!" << endl;
+    return 1;
+  }
+
+  // Bad digits are reported where they are.
+  try {
+    UArbInt(string("12345A789"));
+    cout << "Bad digit FAILED!" << endl;
+    return 1;
+  } catch (UArbInt::Errors::BadFormat& e) {
+    if (e.Position() != 5) {
+      cout << "Bad digit position FAILED!" << endl;
+      return 1;
+    }
+  }
+
+  // Powers of the base, and pushing digits on the back.
+  if (UArbInt().setBasePow(10, 25).to_string() != "1" + string(25, '0') || UArbInt().setBasePow(16, 0) != 1) {
+    cout << "Base power FAILED!" << endl;
+    return 1;
+  }
+  UArbInt pushed(string("123456789"));
+  pushed.push_back(string("0000000000987654321"));
+  if (pushed.to_string() != "1234567890000000000987654321") {
+    cout << "push_back FAILED!" << endl;
+    return 1;
+  }
+
+  // Pushed strings are digits in the number's base, prefixes are not read.
+  UArbInt octal(string("7"));
+  octal.push_back(string("010"));
+  UArbInt hex(string("0x10"));
+  hex.push_back(string("10"));
+  if (octal != 7010 || hex != 1610) {
+    cout << "push_back prefix FAILED!" << endl;
+    return 1;
+  }
+  try {
+    hex.push_back(string("0x1"));
+    cout << "push_back hex FAILED!" << endl;
+    return 1;
+  } catch (UArbInt::Errors::BadFormat&) {
+  }
+
+  // Long runs of zeros and nines straddle every split.
+  string zeros("1" + string(20000, '0'));
+  string nines(20000, '9');
+  if (UArbInt(zeros) != UArbInt().setBasePow(10, 20000) || UArbInt(zeros).to_string() != zeros || UArbInt(nines).to_string() != nines || UArbInt(nines) + 1 != UArbInt(zeros)) {
+    cout << "Long runs FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Check that base conversion agrees with repeated division, both with and
+ * without splitting.
+ */
+int test_conv_algorithms () {
+
+  // Sizes in hex digits, and bases including ones with no output digits.
+  static string::size_type const sizes[] = { 1, 9, 130, 777, 3001 };
+  static UArbInt::value_type const bases[] = { 2, 3, 10, 16, 36, 1000, 65536 };
+  static size_t const numsizes = sizeof(sizes) / sizeof(sizes[0]);
+  static size_t const numbases = sizeof(bases) / sizeof(bases[0]);
+
+  size_t       const baseconv = UArbInt::baseconv_threshold;
+  unsigned int       seed     = 99;
+
+  for (size_t i = 0; i != numsizes; ++i) {
+
+    UArbInt number(random_number(sizes[i], seed));
+
+    for (size_t j = 0; j != numbases; ++j) {
+
+      cout << "  " << sizes[i] << " hex digits to base " << bases[j] << "... ";
+
+      // Reference digits, one division per digit.
+      vector<unsigned int> control;
+      UArbInt              work(number);
+      UArbInt              digit;
+      while (!work.isZero()) {
+        work.op_div(UArbInt(bases[j]), &digit);
+        control.push_back(digit.Value<unsigned int>());
+      }
+
+      // Split all the way down, never split, and defaults.
+      static size_t const thresholds[] = { 1, numeric_limits<size_t>::max(), 0 };
+      for (size_t k = 0; k != sizeof(thresholds) / sizeof(thresholds[0]); ++k) {
+        UArbInt::baseconv_threshold = thresholds[k] ? thresholds[k] : baseconv;
+        vector<unsigned int> digits;
+        if (number.getDigits(digits, bases[j]) != control || UArbInt().setDigits(control, bases[j]) != number) {
+          cout << "FAILED!" << endl;
+          return 1;
+        }
+        if (bases[j] <= UArbInt::max_input_base && UArbInt().Base(bases[j]).set(number.to_string(bases[j]), false) != number) {
+          cout << "String FAILED!" << endl;
+          return 1;
+        }
+      }
+      UArbInt::baseconv_threshold = baseconv;
+
+      cout << "OK!" << endl;
+
+    }
+  }
+
+  return 0;
+
+}
+
+/*
+ * GCDs with known results.
+ */
+int test_gcd_known () {
+
+  cout << "  Known GCDs... ";
+
+  // Zero and one.
+  if (gcd(UArbInt(0), UArbInt(0)) != 0 || gcd(UArbInt(0), UArbInt(12)) != 12 || gcd(UArbInt(12), UArbInt(0)) != 12 || gcd(UArbInt(1), UArbInt(string("123456789012345678901234567890"))) != 1) {
+    cout << "Zero and one FAILED!" << endl;
+    return 1;
+  }
+
+  // Consecutive Fibonacci numbers are coprime and take the most steps.
+  UArbInt f1(1);
+  UArbInt f2(1);
+  for (int i = 0; i != 3000; ++i) {
+    f1 += f2;
+    f1.swap(f2);
+  }
+  if (gcd(f2, f1) != 1 || gcd(f1, f2) != 1) {
+    cout << "Fibonacci FAILED!" << endl;
+    return 1;
+  }
+
+  // Powers share the smaller power.
+  if (gcd(UArbInt(2).pow(5000) * 3, UArbInt(6).pow(700)) != UArbInt(2).pow(700) * 3 || gcd(UArbInt(10).pow(300), UArbInt(10).pow(301) - 1) != 1) {
+    cout << "Powers FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Check that Lehmer's algorithm agrees with Euclid's.
+ */
+int test_gcd_algorithms () {
+
+  // Sizes in hex digits of the two cofactors and the common factor.
+  static string::size_type const sizes[] = { 1, 8, 17, 200, 1500 };
+  static size_t const numsizes = sizeof(sizes) / sizeof(sizes[0]);
+
+  unsigned int seed = 1234;
+
+  for (size_t i = 0; i != numsizes; ++i) {
+    for (size_t j = 0; j != numsizes; ++j) {
+
+      cout << "  " << sizes[i] << " by " << sizes[j] << " hex digits... ";
+
+      for (int k = 0; k != 4; ++k) {
+
+        UArbInt common(random_number(sizes[k & 1 ? i : j] / 2 + 1, seed));
+        UArbInt l     (random_number(sizes[i], seed) * common);
+        UArbInt r     (random_number(sizes[j], seed) * common);
+
+        // Reference, one division per step.
+        UArbInt a(l);
+        UArbInt b(r);
+        while (!b.isZero()) {
+          a %= b;
+          a.swap(b);
+        }
+
+        if (gcd(l, r) != a || gcd(r, l) != a) {
+          cout << "FAILED!" << endl;
+          return 1;
+        }
+
+      }
+
+      cout << "OK!" << endl;
+
+    }
+  }
+
+  return 0;
+
+}
+
+/*
+ * Roots with known results.
+ */
+int test_root_known () {
+
+  cout << "  Known roots... ";
+
+  // Small numbers and the edges of perfect powers.
+  if (UArbInt(0).isqrt() != 0 || UArbInt(1).iroot(7) != 1 || UArbInt(15).isqrt() != 3 || UArbInt(16).isqrt() != 4 || UArbInt(999).iroot(3) != 9 || UArbInt(1000).iroot(3) != 10 || UArbInt(12345).iroot(1) != 12345 || UArbInt(12345).iroot(100) != 1) {
+    cout << "Small FAILED!" << endl;
+    return 1;
+  }
+
+  // Large perfect powers and their neighbors.
+  UArbInt power(UArbInt(string("123456789012345678901234567890")).pow(7));
+  if (power.iroot(7) != UArbInt(string("123456789012345678901234567890")) || (power - 1).iroot(7) != UArbInt(string("123456789012345678901234567889")) || UArbInt().setBasePow(10, 4000).isqrt() != UArbInt().setBasePow(10, 2000)) {
+    cout << "Large FAILED!" << endl;
+    return 1;
+  }
+
+  // No 0th root.
+  try {
+    UArbInt(5).iroot(0);
+    cout << "Zero FAILED!" << endl;
+    return 1;
+  } catch (UArbInt::Errors::DivByZero&) {
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Check that roots are the largest integer whose power does not exceed the
+ * number.
+ */
+int test_root_algorithms () {
+
+  // Sizes in hex digits, and roots.
+  static string::size_type const sizes[] = { 1, 8, 17, 200, 3001 };
+  static unsigned int const roots[] = { 2, 3, 5, 16, 101 };
+  static size_t const numsizes = sizeof(sizes) / sizeof(sizes[0]);
+  static size_t const numroots = sizeof(roots) / sizeof(roots[0]);
+
+  unsigned int seed = 4321;
+
+  for (size_t i = 0; i != numsizes; ++i) {
+    for (size_t j = 0; j != numroots; ++j) {
+
+      cout << "  Root " << roots[j] << " of " << sizes[i] << " hex digits... ";
+
+      for (int k = 0; k != 4; ++k) {
+        UArbInt number(random_number(sizes[i], seed));
+        UArbInt root  (number.iroot(roots[j]));
+        if (root.pow(roots[j]) > number || (root + 1).pow(roots[j]) <= number) {
+          cout << "FAILED!" << endl;
+          return 1;
+        }
+      }
+
+      cout << "OK!" << endl;
+
+    }
+  }
+
+  return 0;
+
+}
+
+/*
+ * Expressions that work on their temporaries in place.
+ */
+int test_temporaries () {
+
+  cout << "  Temporaries... ";
+
+  // Mixed expressions are signed.
+  static_assert(is_same<decltype(UArbInt(2) * UArbInt(3)), UArbInt>::value, "UArbInt * UArbInt");
+  static_assert(is_same<decltype(UArbInt(2) - ArbInt (3)), ArbInt >::value, "UArbInt - ArbInt");
+  static_assert(is_same<decltype(ArbInt (2) + UArbInt(3)), ArbInt >::value, "ArbInt + UArbInt");
+  static_assert(is_same<decltype(UArbInt(2) + 3         ), UArbInt>::value, "UArbInt + int");
+
+  // Named operands are left alone, temporaries give the same results.
+  UArbInt const a(string("123456789012345678901234567890"));
+  ArbInt  const b(string("-98765432109876543210"));
+  ArbInt  const expected((b * b - a) / ArbInt(7) + b);
+  if ((ArbInt(b) * b - a) / ArbInt(7) + b != expected || (b * b - a) / ArbInt(7) + b != expected || a != UArbInt(string("123456789012345678901234567890")) || b != ArbInt(string("-98765432109876543210"))) {
+    cout << "Value FAILED!" << endl;
+    return 1;
+  }
+  if (UArbInt(5) - ArbInt(7) != -2 || (UArbInt(a) % 1000) != 890 || (UArbInt(6) & UArbInt(3)) != 2 || (ArbInt(-1) << 4) != -16 || UArbInt(a) * ArbInt(-1) != ArbInt(a) * -1) {
+    cout << "Mixed FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Main.
+ */
+int main () {
+
+  cout << "Testing UArbInt multiplication..." << endl;
+  if (test_mul_known     ()) { return 1; }
+  if (test_mul_algorithms()) { return 1; }
+  cout << "Testing UArbInt division..." << endl;
+  if (test_div_known     ()) { return 1; }
+  if (test_div_algorithms()) { return 1; }
+  cout << "Testing UArbInt base conversion..." << endl;
+  if (test_conv_known     ()) { return 1; }
+  if (test_conv_algorithms()) { return 1; }
+  cout << "Testing UArbInt GCD..." << endl;
+  if (test_gcd_known     ()) { return 1; }
+  if (test_gcd_algorithms()) { return 1; }
+  cout << "Testing UArbInt roots..." << endl;
+  if (test_root_known     ()) { return 1; }
+  if (test_root_algorithms()) { return 1; }
+  cout << "Testing ArbInt temporaries..." << endl;
+  if (test_temporaries()) { return 1; }
+
+  // All tests passed.
+  cout << "OK!" << endl;
+  return 0;
+
+}
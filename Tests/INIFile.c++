@@ -0,0 +1,335 @@
+/*****************************************************************************
+ * INIFile.c++
+ *****************************************************************************
+ * Tests the INIFile class, and the view overloads it uses.
+ *****************************************************************************/
+
+// Standard includes.
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdio>
+
+// Testing includes.
+#include "INIFile.h++"
+#include "tokenize.h++"
+#include "trim.h++"
+
+// Bring in namespaces.
+using namespace std;
+using namespace DAC;
+
+// Tests.
+int test_views  ();
+int test_read   ();
+int test_errors ();
+int test_reload ();
+
+// Write a file, replacing any existing one with a rename.
+void write_file (string const& filename, string const& text);
+
+// Check that reading a file throws a particular error.
+template <class ErrorT> bool read_throws (string const& text);
+
+// Scratch file.
+string const g_filename("INIFile_test.ini");
+
+/*
+ * Write a file, replacing any existing one with a rename.
+ */
+void write_file (string const& filename, string const& text) {
+  string const tmpname(filename + ".tmp");
+  {
+    ofstream file(tmpname.c_str(), ios::binary);
+    file << text;
+  }
+  rename(tmpname.c_str(), filename.c_str());
+}
+
+/*
+ * Check that reading a file throws a particular error.
+ */
+template <class ErrorT> bool read_throws (string const& text) {
+  write_file(g_filename, text);
+  try {
+    INIFile(g_filename).read();
+  } catch (ErrorT&) {
+    return true;
+  }
+  return false;
+}
+
+/*
+ * View overloads.
+ */
+int test_views () {
+
+  cout << "  Views... ";
+
+  // Tokens view into the original.
+  string const       text("a,b,,c");
+  vector<StringView> tokens;
+  tokenize(StringView(text), tokens, ",");
+  if (tokens.size() != 4 || tokens[0] != "a" || !tokens[2].empty() || tokens[3] != "c" || tokens[3].data() != text.data() + 5) {
+    cout << "Tokenize FAILED!" << endl;
+    return 1;
+  }
+
+  // Trimming moves the ends of the view.
+  StringView padded(" \t x y \n");
+  StringView blank ("  \t ");
+  if (trim(padded) != "x y" || !trim(blank).empty() || rtrim(padded, "y ") != "x") {
+    cout << "Trim FAILED!" << endl;
+    return 1;
+  }
+
+  // Reading values. Leading zeros and prefixes still choose the base.
+  if (ValReader(StringView("1234567890123")).to_integer<long>() != 1234567890123L || ValReader(StringView("010")).to_integer<int>() != 8 || ValReader(StringView("0x10")).to_integer<int>() != 16) {
+    cout << "Integer FAILED!" << endl;
+    return 1;
+  }
+  if (!ValReader(StringView("yEs")).to_boolean() || ValReader(StringView("Off")).to_boolean() || ValReader(StringView("0")).to_boolean() || !ValReader(StringView("maybe")).to_boolean()) {
+    cout << "Boolean FAILED!" << endl;
+    return 1;
+  }
+  try {
+    ValReader(StringView("99999999999999999999")).to_integer<long>();
+    cout << "Overflow FAILED!" << endl;
+    return 1;
+  } catch (ValReader::Errors::BadNum&) {
+  }
+
+  // Values from strings are copied, and copies stand on their own.
+  ValReader owned(string("123"));
+  ValReader other;
+  other = owned;
+  ValReader copied(other);
+  owned = ValReader("456");
+  if (owned.to_integer<int>() != 456 || other.to_integer<int>() != 123 || copied.view() != "123" || copied.to_string() != "123") {
+    cout << "Owned FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Reading and lookups.
+ */
+int test_read () {
+
+  cout << "  Reading... ";
+
+  write_file(g_filename,
+    "; Comment\n"
+    "[server]\n"
+    "  host = example.com  \n"
+    "port=8080\n"
+    "empty =\n"
+    "\n"
+    "[client]\n"
+    "retries\t= 3\n"
+    "verbose = yes\n"
+    "\n"
+    "[a section]\n"
+    "key = value = more\n"
+  );
+
+  INIFile ini(g_filename);
+  if (ini["server"]["host"].to_string() != "example.com" || ini["server"]["port"].to_integer<int>() != 8080 || !ini["server"]["empty"].to_string().empty() || ini["client"]["retries"].to_integer<int>() != 3 || !ini["client"]["verbose"].to_boolean() || ini["a section"]["key"].to_string() != "value = more") {
+    cout << "Values FAILED!" << endl;
+    return 1;
+  }
+
+  // Lookups.
+  if (!ini.section_defined("client") || ini.section_defined("Client") || !ini.key_defined("server", "port") || ini.key_defined("client", "port") || ini.key_defined("nothing", "port") || !ini["client"].key_defined("retries")) {
+    cout << "Defined FAILED!" << endl;
+    return 1;
+  }
+
+  // Lists are sorted, and built once.
+  INIFile::SectionListPT sections(ini.get_sections());
+  INIFile::KeyListPT     keys    (ini.get_keys("server"));
+  if (sections->size() != 3 || (*sections)[0] != "a section" || (*sections)[2] != "server" || keys->size() != 3 || (*keys)[0] != "empty" || (*keys)[2] != "port" || ini.get_sections().get() != sections.get() || ini["server"].get_keys().get() != keys.get()) {
+    cout << "Lists FAILED!" << endl;
+    return 1;
+  }
+
+  // Many sections and keys, enough to grow the hash tables.
+  string big;
+  for (int section = 0; section != 50; ++section) {
+    big += "[s" + std::to_string(section) + "]\n";
+    for (int key = 0; key != 40; ++key) {
+      big += "k" + std::to_string(key) + " = " + std::to_string(section * 1000 + key) + "\n";
+    }
+  }
+  write_file(g_filename, big);
+  INIFile bigini(g_filename);
+  for (int section = 0; section != 50; ++section) {
+    INIFile::Section handle(bigini[StringView("s" + std::to_string(section))]);
+    for (int key = 0; key != 40; ++key) {
+      if (handle[StringView("k" + std::to_string(key))].to_integer<int>() != section * 1000 + key) {
+        cout << "Big FAILED!" << endl;
+        return 1;
+      }
+    }
+    if (handle.key_defined("k40")) {
+      cout << "Big key FAILED!" << endl;
+      return 1;
+    }
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Errors.
+ */
+int test_errors () {
+
+  cout << "  Errors... ";
+
+  if (!read_throws<INIFile::Errors::SectionBlank      >("[]\n"                 ) ||
+      !read_throws<INIFile::Errors::SectionMultiDefine>("[a]\n[b]\n[a]\n"      ) ||
+      !read_throws<INIFile::Errors::ValueNoKey        >("[a]\n= 1\n"           ) ||
+      !read_throws<INIFile::Errors::KeyNoSection      >("k = 1\n[a]\n"         ) ||
+      !read_throws<INIFile::Errors::KeyMultiDefine    >("[a]\nk = 1\nk = 2\n"  ) ||
+      !read_throws<INIFile::Errors::ParseError        >("[a]\nk = 1\nnonsense\n")) {
+    cout << "Parse FAILED!" << endl;
+    return 1;
+  }
+
+  // Line numbers count every line.
+  write_file(g_filename, "[a]\n\n; Comment\nbad\n");
+  try {
+    INIFile(g_filename).read();
+    cout << "Line FAILED!" << endl;
+    return 1;
+  } catch (INIFile::Errors::ParseError& e) {
+    if (e.Line() != 4) {
+      cout << "Line number FAILED!" << endl;
+      return 1;
+    }
+  }
+
+  // Missing files, sections and keys. The same key may be in two sections.
+  write_file(g_filename, "[a]\nk = 1\n[b]\nk = 2\n");
+  INIFile const unread(g_filename);
+  INIFile       ini   (g_filename);
+  try {
+    unread.section_defined("a");
+    cout << "NotRead FAILED!" << endl;
+    return 1;
+  } catch (INIFile::Errors::NotRead&) {
+  }
+  try {
+    ini["c"];
+    cout << "SectionUndefined FAILED!" << endl;
+    return 1;
+  } catch (INIFile::Errors::SectionUndefined&) {
+  }
+  try {
+    ini["a"]["j"];
+    cout << "KeyUndefined FAILED!" << endl;
+    return 1;
+  } catch (INIFile::Errors::KeyUndefined&) {
+  }
+  try {
+    INIFile("INIFile_test.missing").read();
+    cout << "FileNoOpen FAILED!" << endl;
+    return 1;
+  } catch (INIFile::Errors::FileNoOpen&) {
+  }
+  if (ini["a"]["k"].to_integer<int>() != 1 || ini["b"]["k"].to_integer<int>() != 2) {
+    cout << "Shared key FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Reloading.
+ */
+int test_reload () {
+
+  cout << "  Reloading... ";
+
+  write_file(g_filename, "[a]\nk = old\n");
+  INIFile ini(g_filename);
+
+  // First reload reads, unchanged files are not read again.
+  if (!ini.reload() || ini.reload()) {
+    cout << "Unchanged FAILED!" << endl;
+    return 1;
+  }
+
+  // Handles, values and copies from before a reload keep the old file.
+  INIFile::Section section(ini["a"]);
+  ValReader        value  (section["k"]);
+  INIFile          copy   (ini);
+  write_file(g_filename, "[a]\nk = newer\n");
+  if (!ini.reload() || ini["a"]["k"].to_string() != "newer" || section["k"].to_string() != "old" || value.to_string() != "old" || copy["a"]["k"].to_string() != "old") {
+    cout << "Changed FAILED!" << endl;
+    return 1;
+  }
+
+  // Values keep their file alive on their own, however they were read.
+  ValReader orphan = INIFile(g_filename)["a"]["k"];
+  ValReader last   = ini["a"]["k"];
+  ValReader held   = last;
+  write_file(g_filename, "[a]\nk = 123456\n");
+  if (!ini.reload() || orphan.to_string() != "newer" || last.to_string() != "newer" || held.view() != "newer" || ini["a"]["k"].to_integer<int>() != 123456) {
+    cout << "Value FAILED!" << endl;
+    return 1;
+  }
+
+  // A failed read leaves the last good file in place.
+  write_file(g_filename, "[a]\nbad\n");
+  try {
+    ini.reload();
+    cout << "Bad reload FAILED!" << endl;
+    return 1;
+  } catch (INIFile::Errors::ParseError&) {
+  }
+  if (ini["a"]["k"].to_string() != "123456") {
+    cout << "Kept FAILED!" << endl;
+    return 1;
+  }
+
+  // Empty files are fine.
+  write_file(g_filename, "");
+  if (!ini.reload() || !ini.get_sections()->empty()) {
+    cout << "Empty FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Main.
+ */
+int main () {
+
+  cout << "Testing INIFile..." << endl;
+  int retval = test_views() || test_read() || test_errors() || test_reload();
+  remove(g_filename.c_str());
+  if (retval) {
+    return 1;
+  }
+
+  // All tests passed.
+  cout << "OK!" << endl;
+  return 0;
+
+}
@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * OpCounters.c++
+ *****************************************************************************
+ * Tests the operation counters kept by UArbInt and Arb.
+ *****************************************************************************/
+
+// Standard includes.
+#include <string>
+#include <iostream>
+
+// Testing includes.
+#include "OpCounters.h++"
+#include "ArbInt.h++"
+#include "Arb.h++"
+
+// Bring in namespaces.
+using namespace std;
+using namespace DAC;
+
+// Tests.
+int test_disabled ();
+int test_enabled  ();
+
+// Read all counters.
+bool all_zero ();
+
+/*
+ * Read all counters.
+ */
+bool all_zero () {
+  for (int i = 0; i != OpCounters::NUM_COUNTERS; ++i) {
+    if (OpCounters::get(static_cast<OpCounters::Counter>(i)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * Without OPCOUNTERS_ENABLED, nothing is counted.
+ */
+int test_disabled () {
+
+  cout << "  Disabled... ";
+
+  UArbInt const a(string("123456789012345678901234567890123456789012345678901234567890"));
+  UArbInt const b(string("987654321098765432109876543210"));
+  Arb     const x(Arb(a) / Arb(b));
+  if ((a * b) / b != a || gcd(a, b) == 0 || x * Arb(b) != Arb(a) || !all_zero()) {
+    cout << "FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * With OPCOUNTERS_ENABLED, each kind of work shows up in its own counter.
+ */
+int test_enabled () {
+
+  cout << "  Enabled... ";
+
+  // Four-limb numbers, multiplied schoolbook.
+  UArbInt const a(string("0x0123456789ABCDEF0123456789ABCDEF"));
+  UArbInt const b(string("0x0FEDCBA9876543210FEDCBA987654321"));
+  OpCounters::reset();
+  UArbInt const product(a * b);
+  if (OpCounters::get(OpCounters::DIGIT_OPS) != 16 || OpCounters::get(OpCounters::ALLOCATIONS) == 0 || OpCounters::get(OpCounters::REDUCTIONS) != 0 || OpCounters::get(OpCounters::GCD_STEPS) != 0) {
+    cout << "Multiply FAILED!" << endl;
+    return 1;
+  }
+
+  // Numbers that fit inline do not allocate.
+  OpCounters::reset();
+  UArbInt small(12345);
+  small *= UArbInt(678);
+  if (OpCounters::get(OpCounters::ALLOCATIONS) != 0 || OpCounters::get(OpCounters::DIGIT_OPS) == 0) {
+    cout << "Inline FAILED!" << endl;
+    return 1;
+  }
+
+  // gcd takes steps.
+  OpCounters::reset();
+  if (gcd(product, b) != b || OpCounters::get(OpCounters::GCD_STEPS) == 0) {
+    cout << "GCD FAILED!" << endl;
+    return 1;
+  }
+
+  // A fraction is reduced once, when it is next looked at, however many
+  // multiplications came before.
+  Arb const bb   (b);
+  Arb const three(3);
+  Arb       x    (Arb(a) / bb);
+  OpCounters::reset();
+  x *= three;
+  x *= bb;
+  x *= three;
+  if (OpCounters::get(OpCounters::REDUCTIONS) != 0 || !x.isInteger() || OpCounters::get(OpCounters::REDUCTIONS) != 1) {
+    cout << "Reduce FAILED!" << endl;
+    return 1;
+  }
+
+  // Reset.
+  OpCounters::reset();
+  if (!all_zero()) {
+    cout << "Reset FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Main.
+ */
+int main () {
+
+  cout << "Testing OpCounters..." << endl;
+  if (OpCounters::enabled ? test_enabled() : test_disabled()) {
+    return 1;
+  }
+
+  // All tests passed.
+  cout << "OK!" << endl;
+  return 0;
+
+}
@@ -0,0 +1,369 @@
+/*****************************************************************************
+ * ReferencePointer.c++
+ *****************************************************************************
+ * Unit tests for ReferencePointer, the digit sharing built on it, and
+ * reading shared numbers from many threads.
+ *****************************************************************************/
+
+// Standard includes.
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <string>
+
+// Testing includes.
+#include "ReferencePointer.h++"
+#include "ArbInt.h++"
+#include "Arb.h++"
+
+// Bring in namespaces.
+using namespace std;
+using namespace DAC;
+
+/*****************************************************************************/
+// Types.
+
+// Counts its own destruction.
+class Tracked {
+	public:
+		Tracked (int const value = 0) : Value(value) {}
+		~Tracked () { ++s_destroyed; }
+		int Value;
+		static atomic<int> s_destroyed;
+};
+
+// The same, counting references itself.
+class Intrusive : public ReferenceCounted {
+	public:
+		Intrusive (int const value = 0) : Value(value) {}
+		~Intrusive () { ++s_destroyed; }
+		int Value;
+		static atomic<int> s_destroyed;
+};
+
+/*****************************************************************************/
+// Function declarations.
+
+// Tests.
+int test_pointer ();
+int test_threads ();
+int test_digits  ();
+int test_settle  ();
+
+// Program entry.
+int main ();
+
+/*****************************************************************************/
+// Global variables.
+
+// Count allocations.
+atomic<size_t> g_numalloc(0);
+
+// Count destructions.
+atomic<int> Tracked  ::s_destroyed(0);
+atomic<int> Intrusive::s_destroyed(0);
+
+// Threads in the stress tests.
+unsigned int const g_numthreads = 8;
+
+/*****************************************************************************/
+// Function definitions.
+
+/*
+ * Override new so we can count allocations.
+ */
+void* operator new (size_t size) {
+
+	// Do the allocation.
+	void* retval = malloc(size ? size : 1);
+	if (retval == 0) {
+		throw std::bad_alloc();
+	}
+
+	// Count it.
+	++g_numalloc;
+
+	// Done.
+	return retval;
+
+}
+void operator delete (void* p) throw() {
+	free(p);
+}
+void operator delete (void* p, size_t) throw() {
+	free(p);
+}
+
+/*
+ * Counting, ownership and allocations, single threaded.
+ */
+int test_pointer () {
+
+	cout << "  Pointer... ";
+
+	// Adopted pointers get a separate counter, created ones do not.
+	size_t before = g_numalloc;
+	ReferencePointer<Tracked> adopted(new Tracked(1));
+	if (g_numalloc != before + 2) {
+		cout << "Adopt FAILED!" << endl;
+		return 1;
+	}
+	before = g_numalloc;
+	ReferencePointer<Tracked> created(ReferencePointer<Tracked>::create(2));
+	ReferencePointer<Intrusive> intrusive(new Intrusive(3));
+	if (g_numalloc != before + 2 || created->Value != 2 || intrusive->Value != 3) {
+		cout << "Create FAILED!" << endl;
+		return 1;
+	}
+
+	// Copies, moves and const pointers share one count.
+	{
+		ReferencePointer<Tracked>      copy (created);
+		ConstReferencePointer<Tracked> ccopy(copy);
+		ReferencePointer<Tracked>      moved(std::move(copy));
+		if (created.refs() != 3 || !copy.isNull() || moved.get() != created.get() || ccopy.get() != created.get()) {
+			cout << "Share FAILED!" << endl;
+			return 1;
+		}
+		moved = adopted;
+		moved = std::move(moved);
+		if (created.refs() != 2 || adopted.refs() != 2 || moved.get() != adopted.get()) {
+			cout << "Assign FAILED!" << endl;
+			return 1;
+		}
+	}
+	if (created.refs() != 1 || adopted.refs() != 1 || Tracked::s_destroyed != 0) {
+		cout << "Scope FAILED!" << endl;
+		return 1;
+	}
+
+	// An intrusive object may be adopted again from the raw pointer.
+	{
+		ReferencePointer<Intrusive>      again (intrusive.get());
+		ConstReferencePointer<Intrusive> cagain(intrusive.get());
+		if (intrusive.refs() != 3) {
+			cout << "Intrusive FAILED!" << endl;
+			return 1;
+		}
+	}
+
+	// Releasing the last reference hands over an adopted object, and
+	// destroys a created one.
+	Tracked* const released = adopted.release();
+	if (released == 0 || released->Value != 1 || Tracked::s_destroyed != 0 || created.release() != 0 || Tracked::s_destroyed != 1) {
+		cout << "Release FAILED!" << endl;
+		return 1;
+	}
+	delete released;
+
+	// Dropping the last reference destroys.
+	intrusive.clear();
+	if (Intrusive::s_destroyed != 1 || Tracked::s_destroyed != 2) {
+		cout << "Destroy FAILED!" << endl;
+		return 1;
+	}
+
+	cout << "OK!" << endl;
+	return 0;
+
+}
+
+/*
+ * Copy and drop from many threads at once, counts must come out even.
+ */
+int test_threads () {
+
+	cout << "  Threads... ";
+
+	Tracked  ::s_destroyed = 0;
+	Intrusive::s_destroyed = 0;
+
+	{
+
+		ReferencePointer<Tracked>   const shared   (ReferencePointer<Tracked>::create(7));
+		ReferencePointer<Intrusive> const intrusive(new Intrusive(9));
+		atomic<int>                       bad      (0);
+
+		vector<thread> threads;
+		for (unsigned int t = 0; t != g_numthreads; ++t) {
+			threads.push_back(thread([&shared, &intrusive, &bad, t] () {
+				vector< ReferencePointer<Tracked> >        held;
+				vector< ConstReferencePointer<Intrusive> > cheld;
+				for (int i = 0; i != 20000; ++i) {
+					held.push_back(shared);
+					cheld.push_back(ConstReferencePointer<Intrusive>(intrusive));
+					ReferencePointer<Intrusive> again(intrusive.get());
+					if (held.back()->Value != 7 || again->Value != 9) {
+						++bad;
+					}
+					if ((i + t) % 3 == 0) {
+						ReferencePointer<Tracked> moved(std::move(held.back()));
+						held.pop_back();
+						cheld.pop_back();
+					}
+					if (held.size() > 64) {
+						held .clear();
+						cheld.clear();
+					}
+				}
+			}));
+		}
+		for (vector<thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+			i->join();
+		}
+
+		if (bad != 0 || shared.refs() != 1 || intrusive.refs() != 1 || Tracked::s_destroyed != 0 || Intrusive::s_destroyed != 0) {
+			cout << "Counts FAILED!" << endl;
+			return 1;
+		}
+
+	}
+
+	if (Tracked::s_destroyed != 1 || Intrusive::s_destroyed != 1) {
+		cout << "Destroy FAILED!" << endl;
+		return 1;
+	}
+
+	cout << "OK!" << endl;
+	return 0;
+
+}
+
+/*
+ * Big numbers share digits until written, from any thread.
+ */
+int test_digits () {
+
+	cout << "  Digits... ";
+
+	// Big enough to be on the heap.
+	UArbInt const big(string("123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890"));
+	string  const text(big.to_string());
+
+	// Copies do not allocate, writes do, and do not touch the original.
+	size_t before = g_numalloc;
+	UArbInt copy(big);
+	UArbInt other;
+	other = copy;
+	if (g_numalloc != before) {
+		cout << "Copy FAILED!" << endl;
+		return 1;
+	}
+	copy += 1;
+	other <<= 3;
+	if (big.to_string() != text || copy.to_string() != "123456789012345678901234567890123456789012345678901234567890123456789012345678901234567891" || other != big * 8) {
+		cout << "Write FAILED!" << endl;
+		return 1;
+	}
+
+	// Copy and change in many threads.
+	atomic<int>    bad(0);
+	vector<thread> threads;
+	for (unsigned int t = 0; t != g_numthreads; ++t) {
+		threads.push_back(thread([&big, &bad, t] () {
+			UArbInt const expected(big + t);
+			for (int i = 0; i != 2000; ++i) {
+				UArbInt mine(big);
+				UArbInt theirs(mine);
+				mine += t;
+				if (mine != expected || theirs != big) {
+					++bad;
+				}
+			}
+		}));
+	}
+	for (vector<thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+		i->join();
+	}
+	if (bad != 0 || big.to_string() != text) {
+		cout << "Threads FAILED!" << endl;
+		return 1;
+	}
+
+	cout << "OK!" << endl;
+	return 0;
+
+}
+
+/*
+ * A fraction not yet in lowest terms, read at once from many threads.
+ */
+int test_settle () {
+
+	cout << "  Settle... ";
+
+	// Numerator and denominator share a factor, so the first reader has to
+	// reduce. Expected values come from a number built the same way.
+	Arb const a(string("123456789012345678901234567890"));
+	Arb const b(string("987654321098765432109876543210"));
+	Arb const c(string("1000000000000000000000000000000"));
+	Arb    const expected(a * c / (b * c));
+	string const text    (expected.to_string());
+	bool   const integer (expected.isInteger());
+	double const value   (expected.Value<double>());
+
+	// Each round shares a new number, every thread waits for the others so
+	// that they all try to settle it at once.
+	atomic<int> bad(0);
+	for (int round = 0; round != 100; ++round) {
+		Arb const      shared(a * c / (b * c));
+		atomic<int>    ready (0);
+		vector<thread> threads;
+		for (unsigned int t = 0; t != g_numthreads; ++t) {
+			threads.push_back(thread([&, t] () {
+				for (++ready; ready != static_cast<int>(g_numthreads); ) {
+					this_thread::yield();
+				}
+				// Start from different reads, each racing the first to settle.
+				switch (t % 4) {
+					case 0: if (shared >= ArbInt (1)) { ++bad; } break;
+					case 1: if (shared >= UArbInt(1)) { ++bad; } break;
+					case 2: if (Arb(shared) * b != a) { ++bad; } break;
+				}
+				string buffer;
+				if (shared.to_string(buffer) != text || shared.isInteger() != integer || shared.Value<double>() != value || shared != expected || !(shared < 1) || Arb(shared) * b != a) {
+					++bad;
+				}
+
+				// Copies share digits with the shared number until written.
+				Arb mine(shared);
+				mine *= t + 2;
+				if (mine / (t + 2) != shared || shared.to_string(buffer) != text) {
+					++bad;
+				}
+			}));
+		}
+		for (vector<thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+			i->join();
+		}
+	}
+	if (bad != 0) {
+		cout << "Threads FAILED!" << endl;
+		return 1;
+	}
+
+	cout << "OK!" << endl;
+	return 0;
+
+}
+
+/*
+ * Program entry.
+ */
+int main () {
+
+	cout << "Testing ReferencePointer..." << endl;
+	if (test_pointer()) { return 1; }
+	if (test_threads()) { return 1; }
+	if (test_digits ()) { return 1; }
+	if (test_settle ()) { return 1; }
+
+	// All tests passed.
+	cout << "OK!" << endl;
+	return 0;
+
+}
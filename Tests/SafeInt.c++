@@ -16,6 +16,7 @@
 #include "NumInfo.h++"
 #include "to_string.h++"
 #include "testcommon.h++"
+#include "shard.h++"
 
 // Testing include.
 #include "SafeInt.h++"
@@ -1023,20 +1024,28 @@ template <class T, class U> int Test_RawCast<T, U, RelTypes::SS_SL>::op (vector<
 /*
  * Here we go.
  */
-int main () {
+int main (int argc, char** argv) {
+  
+  // Shard to run, each type is a unit of work. Everything by default,
+  // "SafeInt_test index count" to run part of it.
+  Shard shard(argc, argv);
+  if (!shard.valid()) {
+    cerr << "Usage: " << argv[0] << " [index count]" << endl;
+    return 1;
+  }
   
   // Test every possible type.
-  if (test1<bool          >()) { return 1; }
-  if (test1<char          >()) { return 1; }
-  if (test1<signed char   >()) { return 1; }
-  if (test1<unsigned char >()) { return 1; }
-  if (test1<wchar_t       >()) { return 1; }
-  if (test1<short         >()) { return 1; }
-  if (test1<unsigned short>()) { return 1; }
-  if (test1<int           >()) { return 1; }
-  if (test1<unsigned int  >()) { return 1; }
-  if (test1<long          >()) { return 1; }
-  if (test1<unsigned long >()) { return 1; }
+  if (shard.next() && test1<bool          >()) { return 1; }
+  if (shard.next() && test1<char          >()) { return 1; }
+  if (shard.next() && test1<signed char   >()) { return 1; }
+  if (shard.next() && test1<unsigned char >()) { return 1; }
+  if (shard.next() && test1<wchar_t       >()) { return 1; }
+  if (shard.next() && test1<short         >()) { return 1; }
+  if (shard.next() && test1<unsigned short>()) { return 1; }
+  if (shard.next() && test1<int           >()) { return 1; }
+  if (shard.next() && test1<unsigned int  >()) { return 1; }
+  if (shard.next() && test1<long          >()) { return 1; }
+  if (shard.next() && test1<unsigned long >()) { return 1; }
   
   // All tests passed.
   return 0;
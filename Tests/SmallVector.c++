@@ -0,0 +1,291 @@
+/*****************************************************************************
+ * SmallVector.c++
+ *****************************************************************************
+ * Unit tests for SmallVector.
+ *****************************************************************************/
+
+// Standard includes.
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <utility>
+
+// Testing includes.
+#include "SmallVector.h++"
+#include "testcommon.h++"
+
+// Bring in namespaces.
+using namespace std;
+using namespace DAC;
+
+/*****************************************************************************/
+// Types.
+
+// What is under test.
+typedef SmallVector<unsigned int, 4      > TestT;
+typedef SmallVector<unsigned int, 4, true> SharedT;
+
+/*****************************************************************************/
+// Function declarations.
+
+// Tests.
+int test_inline ();
+int test_moves  ();
+int test_random ();
+int test_shared ();
+
+// Check a SmallVector against a vector.
+bool same (TestT const& test, vector<unsigned int> const& control);
+
+// Program entry.
+int main ();
+
+/*****************************************************************************/
+// Global variables.
+
+// Count allocations.
+size_t g_numalloc = 0;
+
+/*****************************************************************************/
+// Function definitions.
+
+/*
+ * Override new so we can count allocations.
+ */
+void* operator new (size_t size) {
+
+	// Do the allocation.
+	void* retval = malloc(size ? size : 1);
+	if (retval == 0) {
+		throw std::bad_alloc();
+	}
+
+	// Count it.
+	++g_numalloc;
+
+	// Done.
+	return retval;
+
+}
+void operator delete (void* p) throw() {
+	free(p);
+}
+void operator delete (void* p, size_t) throw() {
+	free(p);
+}
+
+/*
+ * Check a SmallVector against a vector.
+ */
+bool same (TestT const& test, vector<unsigned int> const& control) {
+	return test.size() == control.size() && equal(control.begin(), control.end(), test.begin());
+}
+
+/*
+ * Small sequences never allocate.
+ */
+int test_inline () {
+
+	cout << "  Inline storage... ";
+
+	size_t const before = g_numalloc;
+
+	// Fill, copy, insert and erase, all within the inline size.
+	TestT a(3, 7);
+	TestT b(a);
+	b.insert(b.begin(), 1);
+	b.erase(b.begin() + 1);
+	TestT c(b.rbegin(), b.rend());
+	c.swap(a);
+	a = std::move(c);
+	if (g_numalloc != before || !a.isInline() || a != TestT(3, 7) || b.size() != 3 || b[0] != 1 || b[1] != 7) {
+		cout << "FAILED!" << endl;
+		return 1;
+	}
+
+	// One past the inline size spills.
+	a.push_back(1);
+	a.push_back(2);
+	if (g_numalloc != before + 1 || a.isInline() || a.size() != 5 || a.back() != 2) {
+		cout << "Spill FAILED!" << endl;
+		return 1;
+	}
+
+	// A measurable range too big to fit is allocated for once.
+	vector<unsigned int> const control(1000, 3);
+	TestT                      d;
+	size_t const               ranged = g_numalloc;
+	d.assign(control.begin(), control.end());
+	if (g_numalloc != ranged + 1 || !same(d, control)) {
+		cout << "Range FAILED!" << endl;
+		return 1;
+	}
+
+	cout << "OK!" << endl;
+	return 0;
+
+}
+
+/*
+ * Moving heap storage does not allocate, and leaves the source empty.
+ */
+int test_moves () {
+
+	cout << "  Moves... ";
+
+	TestT a(100, 5);
+	TestT b(2, 9);
+
+	size_t const before = g_numalloc;
+	TestT c(std::move(a));
+	b = std::move(c);
+	c.swap(b);
+	if (g_numalloc != before || !a.empty() || !b.empty() || c.size() != 100 || c[99] != 5) {
+		cout << "FAILED!" << endl;
+		return 1;
+	}
+
+	// Mixed inline and heap swap both ways.
+	TestT d(2, 1);
+	d.swap(c);
+	if (d.size() != 100 || c.size() != 2 || !c.isInline() || d[0] != 5 || c[1] != 1) {
+		cout << "Swap FAILED!" << endl;
+		return 1;
+	}
+
+	// Self-assignment.
+	TestT& e = d;
+	d = e;
+	d = std::move(e);
+	if (d.size() != 100) {
+		cout << "Self FAILED!" << endl;
+		return 1;
+	}
+
+	cout << "OK!" << endl;
+	return 0;
+
+}
+
+/*
+ * Random operations give the same results as vector.
+ */
+int test_random () {
+
+	cout << "  Random operations... ";
+
+	TestT                test   ;
+	vector<unsigned int> control;
+	unsigned int         seed   = 7;
+
+	for (int i = 0; i != 20000; ++i) {
+
+		unsigned int const random = next_random(seed);
+		unsigned int const value  = random >> 8;
+		size_t       const pos    = control.empty() ? 0 : value % (control.size() + 1);
+
+		// Stay small enough to keep crossing the inline size.
+		switch (random % ((control.size() > 40) ? 11 : 9)) {
+			case 0: test.push_back(value); control.push_back(value); break;
+			case 1: test.insert(test.begin() + pos, value); control.insert(control.begin() + pos, value); break;
+			case 2: test.insert(test.begin() + pos, value % 5, value); control.insert(control.begin() + pos, value % 5, value); break;
+			case 3: { vector<unsigned int> head(control.begin(), control.begin() + pos); test.insert(test.begin() + pos, test.begin(), test.begin() + pos); control.insert(control.begin() + pos, head.begin(), head.end()); } break;
+			case 4: test.resize(value % 12, value); control.resize(value % 12, value); break;
+			case 5: { vector<unsigned int> tail(control.begin() + pos / 2, control.end()); test.assign(test.begin() + pos / 2, test.end()); control.swap(tail); } break;
+			case 6: { TestT tmp(test); test = tmp; } break;
+			case 7: { TestT tmp(std::move(test)); test.swap(tmp); } break;
+			case 8: if (!control.empty()) { test.pop_back(); control.pop_back(); } break;
+			default: test.erase(test.begin() + pos / 2, test.begin() + pos); control.erase(control.begin() + pos / 2, control.begin() + pos); break;
+		}
+
+		if (!same(test, control)) {
+			cout << "FAILED at " << i << "!" << endl;
+			return 1;
+		}
+
+	}
+
+	cout << "OK!" << endl;
+	return 0;
+
+}
+
+/*
+ * Shared copies do not allocate until written, and writes are not seen by
+ * other copies.
+ */
+int test_shared () {
+
+	cout << "  Shared storage... ";
+
+	SharedT a(100, 5);
+
+	// Copies share.
+	size_t const before = g_numalloc;
+	SharedT b(a);
+	SharedT c;
+	c = b;
+	SharedT const& ca = a;
+	SharedT const& cc = c;
+	if (g_numalloc != before || !a.isShared() || cc.data() != ca.data() || cc[99] != 5) {
+		cout << "FAILED!" << endl;
+		return 1;
+	}
+
+	// Writing through any non-const access makes a private copy.
+	b[0] = 1;
+	c.push_back(2);
+	if (g_numalloc != before + 2 || b.isShared() || c.isShared() || a.isShared() || a[0] != 5 || a.size() != 100 || b[0] != 1 || c.size() != 101 || c[0] != 5) {
+		cout << "Write FAILED!" << endl;
+		return 1;
+	}
+
+	// Changing only the size, or assigning, does not copy.
+	SharedT d(a);
+	SharedT e(a);
+	d.pop_back();
+	e.clear();
+	e.assign(size_t(3), 4U);
+	if (g_numalloc != before + 2 || d.size() != 99 || a.size() != 100 || !a.isShared() || e.size() != 3 || !e.isInline()) {
+		cout << "Size FAILED!" << endl;
+		return 1;
+	}
+
+	// Copies of a shared vector, and of itself, stay in step with vector.
+	vector<unsigned int> control(a.begin(), a.end());
+	a.erase(a.begin() + 10, a.end());
+	control.erase(control.begin() + 10, control.end());
+	a.insert(a.begin(), d.begin() + 1, d.begin() + 3);
+	control.insert(control.begin(), 2, 5);
+	a = a;
+	if (a.size() != control.size() || !equal(control.begin(), control.end(), a.begin())) {
+		cout << "Ranges FAILED!" << endl;
+		return 1;
+	}
+	if (d.size() != 99 || d[98] != 5) {
+		cout << "Source FAILED!" << endl;
+		return 1;
+	}
+
+	cout << "OK!" << endl;
+	return 0;
+
+}
+
+/*
+ * Program entry.
+ */
+int main () {
+
+	cout << "Testing SmallVector..." << endl;
+	if (test_inline()) { return 1; }
+	if (test_moves ()) { return 1; }
+	if (test_random()) { return 1; }
+	if (test_shared()) { return 1; }
+
+	// All tests passed.
+	cout << "OK!" << endl;
+	return 0;
+
+}
@@ -0,0 +1,367 @@
+/*****************************************************************************
+ * Timestamp.c++
+ *****************************************************************************
+ * Tests the Timestamp class.
+ *****************************************************************************/
+
+// Standard includes.
+#include <string>
+#include <iostream>
+#include <vector>
+
+// Testing include.
+#include "Timestamp.h++"
+#include "testcommon.h++"
+
+// Bring in namespaces.
+using namespace std;
+using namespace DAC;
+
+// Tests.
+int test_known ();
+int test_paths ();
+int test_parse ();
+int test_copy  ();
+
+// Every field, for comparing timestamps.
+string const g_allfields("%a %A %b %B %C %d %e %g %G %H %I %j %m %M %p %P %s %S %u %U %V %w %W %y %Y %z %Z|%-d %_m %-j %_H");
+
+// Build a pseudo-random timestamp, through either path.
+Timestamp random_timestamp (unsigned int& seed, bool const fast);
+
+// Describe everything observable about a timestamp.
+string describe (Timestamp const& ts, Timestamp const& other);
+
+/*
+ * Build a pseudo-random timestamp.
+ */
+Timestamp random_timestamp (unsigned int& seed, bool const fast) {
+
+  // Select the path.
+  bool const oldfast = Timestamp::fast_path;
+  Timestamp::fast_path = fast;
+
+  // Spread days over the ancient, calendar change, modern and far future.
+  Timestamp retval;
+  retval.Offset(static_cast<int>(next_random(seed) % 1441) - 720);
+  long long day = 0;
+  switch (next_random(seed) % 6) {
+    case 0: day = next_random(seed) % 3000;                  break;
+    case 1: day = 2299160 + next_random(seed) % 800 - 400;   break;
+    case 2: day = 2440588 + next_random(seed) % 40000;       break;
+    case 3: day = 1721424 + next_random(seed) % 1000 - 500;  break;
+    case 4: day = next_random(seed) % 2000000000;            break;
+    case 5: day = 2447893 + next_random(seed) % 30;          break;
+  }
+  Timestamp::TimeVal jd(day);
+  jd += Timestamp::TimeVal(static_cast<int>(next_random(seed) % 86400000)) / 86400000;
+  jd -= Timestamp::TimeVal(1) / 2;
+
+  // Set by Julian Date, by interval, or by POSIX time.
+  switch (next_random(seed) % 3) {
+    case 0: {
+      retval.Julian(jd);
+    } break;
+    case 1: {
+      Timestamp tmp(retval);
+      tmp.Julian(jd);
+      retval.set(tmp.get());
+    } break;
+    case 2: {
+      retval.POSIXDate((jd - Timestamp::TimeVal(2440587.5)) * 86400);
+    } break;
+  }
+
+  // Restore the path.
+  Timestamp::fast_path = oldfast;
+  return retval;
+
+}
+
+/*
+ * Describe everything observable about a timestamp.
+ */
+string describe (Timestamp const& ts, Timestamp const& other) {
+
+  // Work area.
+  string retval;
+  string tmpstr;
+
+  // Fields.
+  retval += ts.to_string(g_allfields) + "\n";
+  retval += ts.Julian().to_string(tmpstr, Arb::FMT_FRACTION) + " " + ts.POSIXDate().to_string(tmpstr, Arb::FMT_FRACTION) + "\n";
+
+  // MJD is only defined from 1858 on.
+  try {
+    retval += DAC::to_string(ts.MJD()) + "\n";
+  } catch (Arb::Errors::ScalarOverflow&) {
+    retval += "No MJD\n";
+  }
+  Timestamp::Interval gmt(ts.getGMT());
+  retval += gmt.Year().to_string(tmpstr) + "-" + gmt.Month().to_string(tmpstr) + "-" + gmt.Day().to_string(tmpstr) + " " + gmt.Hour().to_string(tmpstr) + ":" + gmt.Minute().to_string(tmpstr) + ":" + gmt.Second().to_string(tmpstr) + "." + gmt.Millisecond().to_string(tmpstr) + "\n";
+  retval += ts.jdday().to_string(tmpstr) + " " + ts.dow().to_string(tmpstr) + " " + ts.doy().to_string(tmpstr) + " " + ts.woy(Timestamp::DOW_SUNDAY).to_string(tmpstr) + " " + ts.woyISO().to_string(tmpstr) + " " + ts.getISOYear().to_string(tmpstr) + " " + ts.Millisecond().to_string(tmpstr) + "\n";
+
+  // Relations.
+  retval += (ts - other).to_string(tmpstr, Arb::FMT_FRACTION) + (ts < other ? " <" : "") + (ts == other ? " =" : "") + (ts > other ? " >" : "") + "\n";
+  Timestamp moved(ts);
+  moved += Timestamp::TimeVal(-3) / 7;
+  moved -= Timestamp::TimeVal(1);
+  retval += moved.to_string("%F %T") + " " + moved.Julian().to_string(tmpstr, Arb::FMT_FRACTION) + "\n";
+
+  return retval;
+
+}
+
+/*
+ * Known dates.
+ */
+int test_known () {
+
+  cout << "  Known dates... ";
+
+  // J2000.
+  Timestamp ts;
+  ts.set(Timestamp::Interval().Year(Timestamp::TimeVal(2000)).Month(Timestamp::TimeVal(1)).Day(Timestamp::TimeVal(1)));
+  if (ts.Julian() != 2451545 || ts.to_string() != "Sat Jan  1 12:00:00 2000" || ts.to_string("%j %U %V %G %g %u") != "001 00 52 1999 99 6") {
+    cout << "J2000 FAILED!" << endl;
+    return 1;
+  }
+
+  // POSIX epoch and an offset.
+  ts.POSIXDate(Timestamp::TimeVal(0));
+  if (ts.to_string("%F %T %z") != "1970-01-01 00:00:00 +0000" || ts.Offset(-300).to_string("%F %r %z") != "1969-12-31 07:00:00 PM -0500" || ts.POSIXDate() != 0) {
+    cout << "POSIX FAILED!" << endl;
+    return 1;
+  }
+
+  // Weekdays and weeks are those of the local date, offsets are hours and
+  // minutes.
+  if (ts.to_string("%a %A %u %w %U %V %G") != "Wed Wednesday 3 3 52 01 1970" || ts.dow() != 3 || ts.Offset(330).to_string("%F %T %a %z") != "1970-01-01 05:30:00 Thu +0530" || ts.dow() != 4 || ts.Offset(-570).to_string("%F %T %a %z") != "1969-12-31 14:30:00 Wed -0930" || ts.Offset(720).to_string("%a %U %z") != "Thu 00 +1200" || ts.Offset(-720).to_string("%a %U %z") != "Wed 52 -1200") {
+    cout << "Offset FAILED!" << endl;
+    return 1;
+  }
+
+  // Either side of the last day the fast representation holds.
+  ts.Offset(0).Julian(Timestamp::TimeVal(2147483646) + Timestamp::TimeVal(1) / 4);
+  if (ts.to_string("%F %T %a %z") != "5874898-06-02 18:00:00 Mon +0000" || ts.dow() != 1 || ts.Offset(720).to_string("%F %T %a %z") != "5874898-06-03 06:00:00 Tue +1200" || ts.dow() != 2 || ts.Offset(-720).to_string("%F %T %a %z") != "5874898-06-02 06:00:00 Mon -1200" || ts.dow() != 1) {
+    cout << "Fast limit FAILED!" << endl;
+    return 1;
+  }
+  ts.Offset(0);
+  ++ts;
+  if (ts.to_string("%F %T %a %z") != "5874898-06-03 18:00:00 Tue +0000" || ts.dow() != 2 || ts.Offset(720).to_string("%F %T %a %z") != "5874898-06-04 06:00:00 Wed +1200" || ts.dow() != 3 || ts.Offset(-720).to_string("%F %T %a %z") != "5874898-06-03 06:00:00 Tue -1200" || ts.dow() != 2) {
+    cout << "Past fast limit FAILED!" << endl;
+    return 1;
+  }
+
+  // The day after the last Julian date.
+  ts.Offset(0);
+  ts.set(Timestamp::Interval().Year(Timestamp::TimeVal(1582)).Month(Timestamp::TimeVal(10)).Day(Timestamp::TimeVal(4)));
+  ++ts;
+  if (ts.to_string("%F %A") != "1582-10-15 Friday") {
+    cout << "Calendar FAILED!" << endl;
+    return 1;
+  }
+
+  // Julian Day 0, BCE.
+  ts.Julian(Timestamp::TimeVal(0));
+  if (ts.to_string("%Y-%m-%d %H %C %y") != "-4713-01-01 12 48 -13") {
+    cout << "BCE FAILED!" << endl;
+    return 1;
+  }
+
+  // Sub-millisecond and far future times are kept exactly.
+  Timestamp::TimeVal jd(Timestamp::TimeVal(2451545) + Timestamp::TimeVal(1) / (3 * 86400000));
+  Timestamp::TimeVal far(string("123456789012345.5"));
+  if (ts.Julian(jd).Julian() != jd || (ts + Timestamp::TimeVal(1)).Julian() != jd + Timestamp::TimeVal(1) || ts.Julian(far).Julian() != far || ts.to_string("%T") != "00:00:00") {
+    cout << "Range FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Check that the fast representation gives the same results as Arb.
+ */
+int test_paths () {
+
+  cout << "  Fast path and Arb... ";
+
+  unsigned int fastseed = 1;
+  unsigned int arbseed  = 1;
+  for (int i = 0; i != 1500; ++i) {
+
+    // The same timestamps through both paths.
+    Timestamp const fastts   (random_timestamp(fastseed, true ));
+    Timestamp const fastother(random_timestamp(fastseed, true ));
+    Timestamp const arbts    (random_timestamp(arbseed , false));
+    Timestamp const arbother (random_timestamp(arbseed , false));
+
+    Timestamp::fast_path = true;
+    string const fast(describe(fastts, fastother));
+    Timestamp::fast_path = false;
+    string const arb(describe(arbts, arbother));
+    Timestamp::fast_path = true;
+
+    if (fast != arb) {
+      cout << "FAILED at " << i << "!" << endl << fast << arb;
+      return 1;
+    }
+
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Parse what was formatted.
+ */
+int test_parse () {
+
+  cout << "  Parsing... ";
+
+  // Batch round trip, modern dates to fit two-digit years.
+  unsigned int seed = 7;
+  vector<Timestamp> timestamps;
+  for (int i = 0; i != 500; ++i) {
+    Timestamp ts;
+    ts.Offset(static_cast<int>(next_random(seed) % 1441) - 720);
+    ts.POSIXDate(Timestamp::TimeVal(static_cast<int>(next_random(seed) % 2000000000)));
+    timestamps.push_back(ts);
+  }
+  char const* const formats[] = { "%c %z", "%D %r %z", "%A %B %e%s %Y %T %z %Z", "%-m/%_d/%Y %H:%M:%S %z, week %V %U %W %j %u %w %g %C %y %G" };
+  for (size_t f = 0; f != sizeof(formats) / sizeof(formats[0]); ++f) {
+    Timestamp::CompiledFormat format(formats[f]);
+    vector<string>    strings;
+    vector<Timestamp> parsed;
+    Timestamp::to_string(strings, timestamps, format);
+    Timestamp::parse(parsed, strings, format);
+    for (size_t i = 0; i != timestamps.size(); ++i) {
+      if (parsed[i] != timestamps[i] || parsed[i].Offset() != timestamps[i].Offset() || strings[i] != timestamps[i].to_string(formats[f])) {
+        cout << "Round trip FAILED on " << strings[i] << "!" << endl;
+        return 1;
+      }
+    }
+  }
+
+  // Parsing uses the offset of the prototype unless one is given.
+  Timestamp ts;
+  ts.Offset(60).parse("2001-02-03 04:05:06", "%F %T");
+  if (ts.to_string("%F %T") != "2001-02-03 04:05:06" || ts.getGMT().Hour() != 3 || ts.parse("12/31/99 11:59:59 PM", "%D %r").to_string("%F %T") != "1999-12-31 23:59:59") {
+    cout << "Offset FAILED!" << endl;
+    return 1;
+  }
+  Timestamp zoned;
+  if (zoned.parse("1970-01-01 05:30:00 +0530", "%F %T %z").POSIXDate() != 0 || zoned.Offset() != 330 || zoned.parse("1969-12-31 14:30:00 -0930", "%F %T %z").POSIXDate() != 0 || zoned.Offset() != -570) {
+    cout << "Parse offset FAILED!" << endl;
+    return 1;
+  }
+
+  // Errors.
+  try {
+    ts.parse("2001-02-03 04:05", "%F %T");
+    cout << "Short FAILED!" << endl;
+    return 1;
+  } catch (Timestamp::Errors::BadString& e) {
+    if (e.Position() != 16) {
+      cout << "Position FAILED!" << endl;
+      return 1;
+    }
+  }
+  try {
+    ts.parse("2001-02-30", "%F");
+    cout << "Invalid FAILED!" << endl;
+    return 1;
+  } catch (Timestamp::Errors::InvalidTime&) {
+  }
+  try {
+    zoned.parse("1970-01-01 +0575", "%F %z");
+    cout << "Offset minutes FAILED!" << endl;
+    return 1;
+  } catch (Timestamp::Errors::BadString& e) {
+    if (e.Position() != 12) {
+      cout << "Offset position FAILED!" << endl;
+      return 1;
+    }
+  }
+  try {
+    Timestamp::CompiledFormat format("%Y %Q");
+    cout << "Format FAILED!" << endl;
+    return 1;
+  } catch (Timestamp::Errors::BadFormat& e) {
+    if (e.Position() != 4) {
+      cout << "Format position FAILED!" << endl;
+      return 1;
+    }
+  }
+  if (ts.to_string("%F") != "1999-12-31") {
+    cout << "Unchanged FAILED!" << endl;
+    return 1;
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Copies skip members that are not in use, check they still match.
+ */
+int test_copy () {
+
+  cout << "  Copying... ";
+
+  unsigned int seed = 11;
+  Timestamp    used;
+  for (int i = 0; i != 200; ++i) {
+
+    // Alternate paths, and load the caches of some sources first.
+    Timestamp::fast_path = (i % 2 == 0);
+    Timestamp source(random_timestamp(seed, Timestamp::fast_path));
+    Timestamp other (random_timestamp(seed, Timestamp::fast_path));
+    if (i % 3 == 0) {
+      source.Year();
+      source.Julian();
+    }
+    if (i % 5 == 0) {
+      source.LastJulianDate(Timestamp::YMD(1752, 9, 2));
+    }
+    Timestamp::fast_path = true;
+
+    // Into a new timestamp and over one that has been used.
+    Timestamp const copied(source);
+    used = source;
+    string const expected(describe(source, other));
+    if (describe(copied, other) != expected || describe(used, other) != expected || used.Julian() != source.Julian() || used.LastJulianDate().Year != source.LastJulianDate().Year) {
+      cout << "FAILED at " << i << "!" << endl;
+      return 1;
+    }
+
+  }
+
+  cout << "OK!" << endl;
+  return 0;
+
+}
+
+/*
+ * Main.
+ */
+int main () {
+
+  cout << "Testing Timestamp..." << endl;
+  if (test_known()) { return 1; }
+  if (test_paths()) { return 1; }
+  if (test_parse()) { return 1; }
+  if (test_copy ()) { return 1; }
+
+  // All tests passed.
+  cout << "OK!" << endl;
+  return 0;
+
+}
@@ -9,11 +9,13 @@
 #include <iostream>
 #include <limits>
 #include <vector>
+#include <cstdlib>
 
 // Internal includes.
 #include "demangle.h++"
 #include "to_string.h++"
 #include "build_edges.h++"
+#include "shard.h++"
 
 // Testing include.
 #include "longDiv.h++"
@@ -26,10 +28,11 @@ using namespace DAC;
 // Declarations.
 
 // Main.
-int main ();
+int main (int argc, char** argv);
 
-// Run the test suite on a given type.
-template <class T> int test ();
+// Run the test suite on a given type, on numbers of up to maxdigits digits.
+// Each base is a unit of work for sharding.
+template <class T> int test (Shard& shard, size_t const maxdigits);
 
 // Output an error message.
 template <class T> void errMsg (string const& message, T const base, T const divisor, size_t const digits, vector<T> const& dividend, T const remainder, vector<T> const& quotient);
@@ -40,7 +43,7 @@ template <class T> void errMsg (string const& message, T const base, T const div
 /*
  * Run the test suite on a given type.
  */
-template <class T> int test () {
+template <class T> int test (Shard& shard, size_t const maxdigits) {
   
   {
     string tmpstr;
@@ -56,15 +59,22 @@ template <class T> int test () {
     cout << "  Testing longDiv()..." << endl;
     
     for (typename vector<T>::const_iterator base = edges.begin(); base != edges.end(); ++base) {
-      cout << "    Base: " << to_string(*base) << "..." << endl;
+      
+      // Leave this base to another shard.
+      if (!shard.next()) {
+        continue;
+      }
+      
+      // There are millions of numbers per base, so only failures are
+      // reported on their own.
+      cout << "    Base: " << to_string(*base) << "... ";
+      cout.flush();
       
       for (typename vector<T>::const_iterator divisor = edges.begin(); divisor != edges.end(); ++divisor) {
-        cout << "      Divisor: " << to_string(*divisor) << "..." << endl;
         
         vector<T>                                  longedges;
         vector<typename vector<T>::const_iterator> digitpos ;
-        for (size_t digits = 1; digits <= 5; ++digits) {
-          cout << "        Digits: " << digits << "..." << endl;
+        for (size_t digits = 1; digits <= maxdigits; ++digits) {
           
           // Add a new digit. Last digit position being set to end of edges is
           // used as an indicator to move to the next number of digits, so to
@@ -82,12 +92,6 @@ template <class T> int test () {
               longedges[digit] = *digitpos[digit];
             }
             
-            cout << "          Number: ";
-            for (typename vector<T>::const_iterator i = longedges.begin(); i != longedges.end(); ++i) {
-              cout << to_string(*i) << " ";
-            }
-            cout.flush();
-            
             vector<T> quotient            ;
             vector<T> dividend (longedges);
             T         remainder           ;
@@ -103,7 +107,6 @@ template <class T> int test () {
                 errMsg("Unexpected digit overflow, digit " + to_string(e.Digit()) + ".", *base, *divisor, digits, longedges, remainder, quotient);
                 return 1;
               }
-              cout << "Caught digit overflow on digit " << to_string(e.Digit()) << ", OK!" << endl;
               caughtok = true;
               
             } catch (LongDiv::Errors::DivideByZero&) {
@@ -112,7 +115,6 @@ template <class T> int test () {
                 errMsg("Unexpected divide by zero error.", *base, *divisor, digits, longedges, remainder, quotient);
                 return 1;
               }
-              cout << " Caught divide by zero, OK!" << endl;
               caughtok = true;
               
             } catch (LongDiv::Errors::MinBase&) {
@@ -121,7 +123,6 @@ template <class T> int test () {
                 errMsg("Unexpected minimum base error.", *base, *divisor, digits, longedges, remainder, quotient);
                 return 1;
               }
-              cout << "Caught minimum base error, OK!" << endl;
               caughtok = true;
               
             } catch (LongDiv::Errors::MaxBase&) {
@@ -130,7 +131,6 @@ template <class T> int test () {
                 errMsg("Unexpected maximum base error.", *base, *divisor, digits, longedges, remainder, quotient);
                 return 1;
               }
-              cout << "Caught maximum base error, OK!" << endl;
               caughtok = true;
               
             } catch (LongDiv::Errors::DivisorOverflow&) {
@@ -139,7 +139,6 @@ template <class T> int test () {
                 errMsg("Unexpected divisor overflow error.", *base, *divisor, digits, longedges, remainder, quotient);
                 return 1;
               }
-              cout << "Caught divisor overflow error, OK!" << endl;
               caughtok = true;
               
             } catch (Exception& e) {
@@ -232,18 +231,9 @@ template <class T> int test () {
                 dividend.resize(noinsignificantzeros);
               }
               
-              if (quotient == dividend) {
-                cout << "== ";
-                for (typename vector<T>::const_iterator i = quotient.begin(); i != quotient.end(); ++i) {
-                  cout << to_string(*i) << " ";
-                }
-                cout << "OK!" << endl;
-              } else {
-                cout << "!= ";
-                for (typename vector<T>::const_iterator i = quotient.begin(); i != quotient.end(); ++i) {
-                  cout << to_string(*i) << " ";
-                }
-                cout << "FAILED!" << endl;
+              if (quotient != dividend) {
+                cout << "Re-multiplied quotient does not match, FAILED!" << endl;
+                errMsg("Re-multiplied quotient does not match.", *base, *divisor, digits, longedges, remainder, quotient);
                 return 1;
               }
               
@@ -269,6 +259,8 @@ template <class T> int test () {
           
       }
       
+      cout << "OK!" << endl;
+      
     }
     
   }
@@ -301,22 +293,31 @@ template <class T> void errMsg (string const& message, T const base, T const div
 /*
  * Main.
  */
-int main () {
+int main (int argc, char** argv) {
   
-  // TODO: Why are unsigned types ~100x faster?
-  //if (test<bool          >()) { return 1; }  // Makes no sense, should be a compile-time error.
-  if (test<char          >()) { return 1; }
-  if (test<signed char   >()) { return 1; }
-  if (test<unsigned char >()) { return 1; }
-  if (test<wchar_t       >()) { return 1; }
-  if (test<short         >()) { return 1; }
-  if (test<unsigned short>()) { return 1; }
-  if (test<int           >()) { return 1; }
-  if (test<unsigned int  >()) { return 1; }
-  if (test<long          >()) { return 1; }
-  if (test<unsigned long >()) { return 1; }
+  // Shard to run, and the longest number to test. The whole sweep by
+  // default, "longDiv_test index count [digits]" to run part of it.
+  Shard        shard    (argc, argv);
+  size_t const maxdigits = (argc > 3) ? strtoul(argv[3], 0, 10) : 5;
+  if (!shard.valid() || maxdigits == 0) {
+    cerr << "Usage: " << argv[0] << " [index count [digits]]" << endl;
+    return 1;
+  }
+  
+  // Signed types have twice the edges of unsigned types, and a type's sweep
+  // grows with the seventh power of its edges, so they take ~100x as long.
+  //if (test<bool          >(shard, maxdigits)) { return 1; }  // Makes no sense, should be a compile-time error.
+  if (test<char          >(shard, maxdigits)) { return 1; }
+  if (test<signed char   >(shard, maxdigits)) { return 1; }
+  if (test<unsigned char >(shard, maxdigits)) { return 1; }
+  if (test<wchar_t       >(shard, maxdigits)) { return 1; }
+  if (test<short         >(shard, maxdigits)) { return 1; }
+  if (test<unsigned short>(shard, maxdigits)) { return 1; }
+  if (test<int           >(shard, maxdigits)) { return 1; }
+  if (test<unsigned int  >(shard, maxdigits)) { return 1; }
+  if (test<long          >(shard, maxdigits)) { return 1; }
+  if (test<unsigned long >(shard, maxdigits)) { return 1; }
   
   return 0;
   
 }
-
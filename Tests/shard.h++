@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * shard.h++
+ *****************************************************************************
+ * Split a long-running test into shards that can run side by side.
+ *****************************************************************************/
+
+// Include guard.
+#if !defined(shard_q8m3kd7x0c2v)
+	#define shard_q8m3kd7x0c2v
+
+// STL includes.
+#include <cstddef>
+#include <cstdlib>
+
+// Namespace.
+namespace DAC {
+	
+	/***************************************************************************
+	 * Shard
+	 ***************************************************************************
+	 * A test is a fixed sequence of units of work, and shard i of n takes
+	 * every nth unit starting with the ith. Run without arguments, a test is
+	 * one shard that does everything.
+	 ***************************************************************************/
+	class Shard {
+	
+		public:
+		
+			// Take the shard from the command line, "test [index count]".
+			Shard (int const argc, char const* const* const argv);
+			
+			// Whether the command line made sense.
+			bool valid () const;
+			
+			// Whether the next unit of work belongs to this shard.
+			bool next ();
+		
+		private:
+		
+			// Which shard this is, of how many, and the next unit of work.
+			size_t _index;
+			size_t _count;
+			size_t _unit ;
+	
+	};
+	
+	/***************************************************************************
+	 * Inline and template definitions.
+	 ***************************************************************************/
+	
+	/*
+	 * Take the shard from the command line.
+	 */
+	inline Shard::Shard (int const argc, char const* const* const argv) : _index(0), _count(1), _unit(0) {
+		if (argc > 2) {
+			_index = std::strtoul(argv[1], 0, 10);
+			_count = std::strtoul(argv[2], 0, 10);
+		} else if (argc > 1) {
+			_count = 0;
+		}
+	}
+	
+	/*
+	 * Whether the command line made sense.
+	 */
+	inline bool Shard::valid () const { return _index < _count; }
+	
+	/*
+	 * Whether the next unit of work belongs to this shard.
+	 */
+	inline bool Shard::next () { return _unit++ % _count == _index; }
+
+}
+
+// End include guard.
+#endif
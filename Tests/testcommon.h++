@@ -57,6 +57,9 @@ namespace DAC {
 	// Push a unique value into a container.
 	template <class T> void push_unique (T& container, typename T::value_type value);
 	
+	// Simple LCG, reproducible from run to run.
+	unsigned int next_random (unsigned int& seed);
+	
 	/***************************************************************************
 	 * Inline and template definitions.
 	 ***************************************************************************/
@@ -131,6 +134,15 @@ namespace DAC {
 		}
 	}
 	
+	/*
+	 * Simple LCG, reproducible from run to run. Returns the better-mixed high
+	 * bits of the new seed.
+	 */
+	inline unsigned int next_random (unsigned int& seed) {
+		seed = seed * 1103515245U + 12345U;
+		return seed >> 8;
+	}
+	
 }
 
 // End include guard.
@@ -17,6 +17,9 @@
   #include <time.h>
 #endif
 
+// STL includes.
+#include <limits>
+
 // Class include.
 #include "Timestamp.h++"
 
@@ -63,10 +66,27 @@ namespace DAC {
     "July",    "August",   "September", "October", "November", "December"
   };
   
+  // Range of the fast representation. Days outside of 32 bits are rare
+  // enough to leave to Arb.
+  long long const Timestamp::_FAST_MINDAY = 0;
+  long long const Timestamp::_FAST_MAXDAY = 2147483646;
+  
+  // Milliseconds per day.
+  int const Timestamp::_MS_PER_DAY = 24 * 60 * 60 * 1000;
+  
+  // Default last julian date.
+  int const Timestamp::_DEFAULT_LASTJULIAN_YEAR  = 1582;
+  int const Timestamp::_DEFAULT_LASTJULIAN_MONTH = 10;
+  int const Timestamp::_DEFAULT_LASTJULIAN_DAY   = 4;
+  int const Timestamp::_DEFAULT_LASTJULIAN_JD    = 2299160;
+  
   // Days of year by month.
   int const Timestamp::_DAYS_OF_YEAR_NY[] = { 366, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
   int const Timestamp::_DAYS_OF_YEAR_LY[] = { 367, 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335 };
   
+  // Use the fast representation.
+  bool Timestamp::fast_path = true;
+  
   // True when class has been initialized.
   bool Timestamp::s_initialized = false;
   
@@ -74,7 +94,11 @@ namespace DAC {
   Timestamp::LSLptr Timestamp::s_defaultleapseconds;
   
   // Default format.
-  Timestamp::Formatptr Timestamp::s_defaultformat;
+  Timestamp::CompiledFormatptr Timestamp::s_defaultformat;
+  
+  // Default last julian date.
+  ReferencePointer<Timestamp::YMD    > Timestamp::s_defaultlastjulianymd;
+  ReferencePointer<Timestamp::TimeVal> Timestamp::s_defaultlastjulianjd ;
   
   /***************************************************************************/
   // Function members.
@@ -131,28 +155,170 @@ namespace DAC {
   /*
    * Accessors.
    */
+  Timestamp& Timestamp::LastJulianDate (YMD const& lastjulian) {
+    Timestamp tmp;
+    tmp = Interval().Year (lastjulian.Year )
+                    .Month(lastjulian.Month)
+                    .Day  (lastjulian.Day  )
+                    .Hour (TimeVal(12)     );
+    TimeVal lastjulianjd(tmp.Julian().floor());
+    
+    // The fast representation needs an integer last julian date, in a
+    // positive year so Gregorian dates are never BCE.
+    long long year  = 0;
+    long long month = 0;
+    long long day   = 0;
+    long long jd    = 0;
+    bool      fast  = s_fastToLong(lastjulian.Year, year) && year > 0 && s_fastToLong(lastjulian.Month, month) && s_fastToLong(lastjulian.Day, day) && s_fastToLong(lastjulianjd, jd);
+    
+    // Fall back to Arb if the fast representation can no longer be used.
+    if (_fast && !fast) {
+      _getJD();
+      _fast = false;
+    }
+    
+    _cache_valid         = false;
+    _fastcache_valid     = false;
+    _lastjulianymd       = lastjulian;
+    _lastjulianjd        = lastjulianjd;
+    _fastlastjulianyear  = year;
+    _fastlastjulianmonth = month;
+    _fastlastjulianday   = day;
+    _fastlastjulianjd    = jd;
+    _fastlastjulian      = fast;
+    return *this;
+  }
   Timestamp& Timestamp::MJD (unsigned int const mjd) {
     if (mjd > 99999) { throw Errors::MJDMax(); }
-    _cache_valid = false;
-    _jd = mjd + TimeVal(2400000) - 0.5 - _offset;
+    if (fast_path && _fastlastjulian) {
+      _fastSetDay(mjd + 2400000LL, -60000LL * _offset);
+    } else {
+      _setJD(mjd + TimeVal(2400000) - 0.5 - _offsetDays());
+    }
+    return *this;
+  }
+  unsigned int Timestamp::MJD () const {
+    if (_fast) {
+      long long day = 0;
+      long long ms  = 0;
+      _fastLocal(day, ms);
+      if (day >= 2400000) {
+        return static_cast<unsigned int>((day - 2400000) % 100000);
+      }
+    }
+    return (_getJD() - 2400000 + 0.5 + _offsetDays()).floor() % 100000;
+  }
+  Timestamp& Timestamp::POSIXDate (TimeVal const& posixdate) {
+    long long ms = 0;
+    if (fast_path && _fastlastjulian && s_fastToMS(posixdate, 1000, ms)) {
+      _fastSetDay(2440588, ms);
+    } else {
+      _setJD(posixdate / 86400 + 2440587.5);
+    }
     return *this;
   }
+  Timestamp::TimeVal Timestamp::POSIXDate () const {
+    if (_fast) {
+      return TimeVal((_fastday - 2440588) * _MS_PER_DAY + _fastms) / 1000;
+    }
+    return (_getJD() - 2440587.5) * 86400;
+  }
   Timestamp& Timestamp::Offset (int const offset) {
     if (offset < -720) { throw Errors::OffsetMin(); }
     if (offset >  720) { throw Errors::OffsetMax(); }
-    _cache_valid = false;
-    _offset = offset / TimeVal(1440);
+    _cache_valid     = false;
+    _fastcache_valid = false;
+    _offset          = offset;
+    return *this;
+  }
+  
+  /*
+   * Set the timestamp with an interval.
+   */
+  Timestamp& Timestamp::set (Interval const& time) {
+    
+    // Set in GMT, then correct for the offset.
+    _set(time);
+    if (_offset) {
+      _addMS(-60000LL * _offset);
+    }
+    
+    // We done.
+    return *this;
+    
+  }
+  
+  /*
+   * Get the interval of the timestamp.
+   */
+  Timestamp::Interval Timestamp::get () const {
+    
+    // Fast representation.
+    if (_fast) {
+      if (!_fastcache_valid) {
+        _fastLoadCache();
+      }
+      return s_fastInterval(_fastcache);
+    }
+    
+    // Arb.
+    return (*this + _offsetDays())._get();
+    
+  }
+  
+  /*
+   * Get the interval of the timestamp, no GMT offset.
+   */
+  Timestamp::Interval Timestamp::getGMT () const {
+    
+    // Fast representation.
+    if (_fast) {
+      _FastFields fields;
+      _fastGet(fields, _fastday, _fastms);
+      return s_fastInterval(fields);
+    }
+    
+    // Arb.
+    return _get();
+    
+  }
+  
+  /*
+   * Add days.
+   */
+  Timestamp& Timestamp::op_add (TimeVal const& tv) {
+    long long ms = 0;
+    if (_fast && s_fastToMS(tv, _MS_PER_DAY, ms)) {
+      _fastSetDay(_fastday, _fastms + ms);
+    } else {
+      _setJD(_getJD() + tv);
+    }
     return *this;
   }
   
+  /*
+   * Subtract another timestamp, result is in days.
+   */
+  Timestamp::TimeVal Timestamp::op_sub (Timestamp const& ts) const {
+    if (_fast && ts._fast) {
+      return TimeVal((_fastday - ts._fastday) * _MS_PER_DAY + (_fastms - ts._fastms) + 60000LL * (_offset - ts._offset)) / _MS_PER_DAY;
+    }
+    return (_getJD() + _offsetDays()) - (ts._getJD() + ts._offsetDays());
+  }
+  
   /*
    * Get the current system time.
    */
   Timestamp& Timestamp::getSystemTime () {
     
     // Work area.
-    Timestamp  newtime(*this);
-    Interval   interval;
+    long long year        = 0;
+    long long month       = 0;
+    long long day         = 0;
+    long long hour        = 0;
+    long long minute      = 0;
+    long long second      = 0;
+    long long millisecond = 0;
 #if defined(TIMESTAMP_SYSTIME_GETSYSTEMTIME)
     _SYSTEMTIME systime;
 #elif defined(TIMESTAMP_SYSTIME_GETTIMEOFDAY_GMTIME_R) || \
@@ -205,40 +371,46 @@ namespace DAC {
     }
 #endif
     
-    // Set the interval.
+    // Get the fields.
 #if defined(TIMESTAMP_SYSTIME_GETSYSTEMTIME)
-    interval.Millisecond(TimeVal(systime.wMilliseconds))
-            .Second     (TimeVal(systime.wSecond      ))
-            .Minute     (TimeVal(systime.wMinute      ))
-            .Hour       (TimeVal(systime.wHour        ))
-            .Day        (TimeVal(systime.wDay         ))
-            .Month      (TimeVal(systime.wMonth       ))
-            .Year       (TimeVal(systime.wYear        ));
+    millisecond = systime.wMilliseconds;
+    second      = systime.wSecond      ;
+    minute      = systime.wMinute      ;
+    hour        = systime.wHour        ;
+    day         = systime.wDay         ;
+    month       = systime.wMonth       ;
+    year        = systime.wYear        ;
 #elif defined(TIMESTAMP_SYSTIME_GETTIMEOFDAY_GMTIME_R) || \
       defined(TIMESTAMP_SYSTIME_GETTIMEOFDAY_GMTIME  )
-    interval.Millisecond((TimeVal(tv.tv_usec     ) / 1000).toInt())
-            .Second     ( TimeVal(systime.tm_sec )                )
-            .Minute     ( TimeVal(systime.tm_min )                )
-            .Hour       ( TimeVal(systime.tm_hour)                )
-            .Day        ( TimeVal(systime.tm_mday)                )
-            .Month      ( TimeVal(systime.tm_mon ) +    1         )
-            .Year       ( TimeVal(systime.tm_year) + 1900         );
+    millisecond = tv.tv_usec / 1000     ;
+    second      = systime.tm_sec        ;
+    minute      = systime.tm_min        ;
+    hour        = systime.tm_hour       ;
+    day         = systime.tm_mday       ;
+    month       = systime.tm_mon  +    1;
+    year        = systime.tm_year + 1900;
 #elif defined(TIMESTAMP_SYSTIME_TIME_GMTIME_R) || \
       defined(TIMESTAMP_SYSTIME_TIME_GMTIME  )
-    interval.Second(TimeVal(systime.tm_sec )       )
-            .Minute(TimeVal(systime.tm_min )       )
-            .Hour  (TimeVal(systime.tm_hour)       )
-            .Day   (TimeVal(systime.tm_mday)       )
-            .Month (TimeVal(systime.tm_mon ) +    1)
-            .Year  (TimeVal(systime.tm_year) + 1900);
+    second      = systime.tm_sec        ;
+    minute      = systime.tm_min        ;
+    hour        = systime.tm_hour       ;
+    day         = systime.tm_mday       ;
+    month       = systime.tm_mon  +    1;
+    year        = systime.tm_year + 1900;
 #endif
     
-    // Set the new time.
-    newtime.setGMT(interval);
+    // Set the new time, through Arb if it cannot be done quickly.
+    if (!_fastSet(year, month, day, hour, minute, second, millisecond)) {
+      setGMT(Interval().Millisecond(TimeVal(millisecond))
+                       .Second     (TimeVal(second     ))
+                       .Minute     (TimeVal(minute     ))
+                       .Hour       (TimeVal(hour       ))
+                       .Day        (TimeVal(day        ))
+                       .Month      (TimeVal(month      ))
+                       .Year       (TimeVal(year       )));
+    }
     
     // We done, return.
-    _cache_valid = false;
-    _jd          = newtime._jd;
     return *this;
     
   }
@@ -248,15 +420,14 @@ namespace DAC {
    */
   Timestamp& Timestamp::clear () {
     
-    // Make a new jd.
-    TimeVal new_jd;
-    new_jd.FixQ(Arb(24 * 60 * 60 * 1000)).Fix(Arb::FIX_DENOM).Fixed(true);
-    
-    // Make a new lastjulian.
-    YMD     new_lastjulianymd(1582, 10, 4);
-    TimeVal new_lastjulianjd(2299160);
-    _lastjulianymd = new_lastjulianymd;
-    _lastjulianjd  = new_lastjulianjd;
+    // Set the default lastjulian.
+    _lastjulianymd       = *s_defaultlastjulianymd;
+    _lastjulianjd        = *s_defaultlastjulianjd;
+    _fastlastjulianyear  = _DEFAULT_LASTJULIAN_YEAR;
+    _fastlastjulianmonth = _DEFAULT_LASTJULIAN_MONTH;
+    _fastlastjulianday   = _DEFAULT_LASTJULIAN_DAY;
+    _fastlastjulianjd    = _DEFAULT_LASTJULIAN_JD;
+    _fastlastjulian      = true;
     
     // Set the GMT offset.
     _offset = 0;
@@ -273,11 +444,15 @@ namespace DAC {
     // Set the calendar type to default.
     _caltype = CT_DEFAULT;
     
-    // Clear the jd.
-    _jd = new_jd;
-    
-    // Invalidate the cache.
-    _cache_valid = false;
+    // Clear the jd, which is noon of day 0. Only the Arb path needs a new
+    // jd built.
+    if (fast_path) {
+      _fastSetDay(0, _MS_PER_DAY / 2);
+    } else {
+      TimeVal new_jd;
+      new_jd.FixQ(Arb(24 * 60 * 60 * 1000)).Fix(Arb::FIX_DENOM).Fixed(true);
+      _setJD(new_jd);
+    }
     
     // We done.
     return *this;
@@ -289,9 +464,17 @@ namespace DAC {
    */
   Timestamp& Timestamp::copy (Timestamp const& ts) {
     
-    // Set the last julian date.
-    _lastjulianymd = ts._lastjulianymd;
-    _lastjulianjd  = ts._lastjulianjd;
+    // Set the last julian date. An integer last julian date is all in the
+    // fast fields, so the Arbs only need copying if those differ.
+    if (!_fastlastjulian || !ts._fastlastjulian || _fastlastjulianjd != ts._fastlastjulianjd || _fastlastjulianyear != ts._fastlastjulianyear || _fastlastjulianmonth != ts._fastlastjulianmonth || _fastlastjulianday != ts._fastlastjulianday) {
+      _lastjulianymd = ts._lastjulianymd;
+      _lastjulianjd  = ts._lastjulianjd;
+    }
+    _fastlastjulianyear  = ts._fastlastjulianyear;
+    _fastlastjulianmonth = ts._fastlastjulianmonth;
+    _fastlastjulianday   = ts._fastlastjulianday;
+    _fastlastjulianjd    = ts._fastlastjulianjd;
+    _fastlastjulian      = ts._fastlastjulian;
     
     // Set the leap second list.
     _leapseconds = ts._leapseconds;
@@ -302,8 +485,14 @@ namespace DAC {
     // Set the calendar type.
     _caltype = ts._caltype;
     
-    // Set the jd.
-    _jd = ts._jd;
+    // Set the jd. It only means anything when valid.
+    if (ts._jdvalid) {
+      _jd = ts._jd;
+    }
+    _jdvalid = ts._jdvalid;
+    _fastday = ts._fastday;
+    _fastms  = ts._fastms;
+    _fast    = ts._fast;
     
     // Set the GMT offset.
     _offset = ts._offset;
@@ -311,15 +500,19 @@ namespace DAC {
     // Set the timezone name.
     _tzname = ts._tzname;
     
-    // Copy the cache.
-    _cache_year        = ts._cache_year;
-    _cache_month       = ts._cache_month;
-    _cache_day         = ts._cache_day;
-    _cache_hour        = ts._cache_hour;
-    _cache_minute      = ts._cache_minute;
-    _cache_second      = ts._cache_second;
-    _cache_millisecond = ts._cache_millisecond;
+    // Copy the cache, if there is one.
+    if (ts._cache_valid) {
+      _cache_year        = ts._cache_year;
+      _cache_month       = ts._cache_month;
+      _cache_day         = ts._cache_day;
+      _cache_hour        = ts._cache_hour;
+      _cache_minute      = ts._cache_minute;
+      _cache_second      = ts._cache_second;
+      _cache_millisecond = ts._cache_millisecond;
+    }
     _cache_valid       = ts._cache_valid;
+    _fastcache         = ts._fastcache;
+    _fastcache_valid   = ts._fastcache_valid;
     
     // We done.
     return *this;
@@ -331,340 +524,73 @@ namespace DAC {
    */
   string& Timestamp::to_string (string& buffer, string const& format) const {
     
+    // Select the format.
+    if (format.empty()) {
+      return to_string(buffer, *_format);
+    }
+    return to_string(buffer, CompiledFormat(format));
+    
+  }
+  string& Timestamp::to_string (string& buffer, CompiledFormat const& format) const {
+    
     // This is the string we will be returning.
     string retval;
     
-    // Different types of field padding.
-    enum PadType { PAD_DEPAD, PAD_NOPAD, PAD_SPPAD, PAD_ZRPAD };
+    // Convert.
+    _toString(retval, format);
+    
+    // We done, return the string.
+    buffer.swap(retval);
+    return buffer;
+    
+  }
+  
+  /*
+   * Convert a list of timestamps to strings.
+   */
+  vector<string>& Timestamp::to_string (vector<string>& buffer, vector<Timestamp> const& timestamps, CompiledFormat const& format) {
+    
+    // Work area.
+    vector<string> retval(timestamps.size());
+    
+    // Convert each timestamp.
+    for (vector<Timestamp>::size_type i = 0; i != timestamps.size(); ++i) {
+      timestamps[i]._toString(retval[i], format);
+    }
+    
+    // We done.
+    buffer.swap(retval);
+    return buffer;
+    
+  }
+  
+  /*
+   * Set this timestamp from a string.
+   */
+  Timestamp& Timestamp::parse (string const& text, string const& format) {
     
     // Select the format.
-    ConstReferencePointer<Format> fmt;
     if (format.empty()) {
-      fmt = _format;
-    } else {
-      fmt = new Format(format);
+      return parse(text, *_format);
     }
+    return parse(text, CompiledFormat(format));
     
-    // Check for control characters.
-    for (Format::const_iterator i = fmt->begin(); i != fmt->end(); ++i) {
-      
-      // Escape character.
-      if (*i == '%') {
-        
-        // No dangling escape character.
-        if (++i == fmt->end()) {
-          throw Errors::BadFormat().Problem("Dangling escape character").Position(i - 1 - fmt->begin());
-        }
-        
-        // Modifiers.
-        PadType mod = PAD_DEPAD;
-        switch (*i) {
-          case '-': mod = PAD_NOPAD; ++i; break;
-          case '_': mod = PAD_SPPAD; ++i; break;
-        }
-        
-        // No dangling modifier.
-        if (i == fmt->end()) {
-          throw Errors::BadFormat().Problem("Dangling modifier").Position(i - 1 - fmt->begin());
-        }
-        
-        // Next character is a format option.
-        string::size_type fieldlen = 0;
-        PadType           fieldpad = PAD_ZRPAD;
-        string            numfield;
-        switch (*i) {
-          
-          // Literal %.
-          case '%': {
-            retval += '%';
-          } break;
-          
-          // Abbreviated weekday name.
-          case 'a': {
-            retval += _SHORT_WEEKDAY_NAME[dow()];
-          } break;
-          
-          // Full weekday name, variable length.
-          case 'A': {
-            retval += _LONG_WEEKDAY_NAME[dow()];
-          } break;
-          
-          // Abbreviated month name.
-          case 'b': {
-            retval += _SHORT_MONTH_NAME[Month()];
-          } break;
-          
-          // Full month name, variable length.
-          case 'B': {
-            retval += _LONG_MONTH_NAME[Month()];
-          } break;
-          
-          // Default date and time format.
-          case 'c': {
-            string tmpstr;
-            retval += to_string(tmpstr, "%a %b %e %T %Y");
-          } break;
-          
-          // Century (00..99).
-          case 'C': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = ((Year() / 100).floor().abs() % 100).to_string(tmpstr);
-          } break;
-          
-          // Day of month (01..31).
-          case 'd': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = Day().to_string(tmpstr);
-          } break;
-          
-          // Date (mm/dd/yy).
-          case 'D': {
-            string tmpstr;
-            retval += to_string(tmpstr, "%m/%d/%y");
-          } break;
-          
-          // Day of month, blank padded.
-          case 'e': {
-            string tmpstr;
-            fieldlen = 2;
-            fieldpad = PAD_SPPAD;
-            numfield = Day().to_string(tmpstr);
-          } break;
-          
-          // Same as %Y-%m-%d, ISO 8601:2000.
-          case 'F': {
-            string tmpstr;
-            retval += to_string(tmpstr, "%Y-%m-%d");
-          } break;
-          
-          // The 2-digit year corresponding to the %V week number.
-          case 'g': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = (getISOYear() % 100).abs().to_string(tmpstr);
-          } break;
-          
-          // The ISO year.
-          case 'G': {
-            string tmpstr;
-            retval += Year().to_string(tmpstr);
-          } break;
-          
-          // Equivalent to %b.
-          case 'h': {
-            string tmpstr;
-            retval += to_string(tmpstr, "%b");
-          } break;
-          
-          // 24-hour clock hour (00..23).
-          case 'H': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = Hour().to_string(tmpstr);
-          } break;
-          
-          // 12-hour clock hour (01..12).
-          case 'I': {
-            string tmpstr;
-            fieldlen = 2;
-            TimeVal hour = Hour();
-            numfield = ((hour > 12) ? hour - 12 : ((hour == 0) ? hour + 12 : hour)).to_string(tmpstr);
-          } break;
-          
-          // Day of year (001..366).
-          case 'j': {
-            string tmpstr;
-            fieldlen = 3;
-            numfield = doy().to_string(tmpstr);
-          } break;
-          
-          // Month (01..12).
-          case 'm': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = Month().to_string(tmpstr);
-          } break;
-          
-          // Minute (00..59).
-          case 'M': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = Minute().to_string(tmpstr);
-          } break;
-          
-          // Newline.
-          case 'n': {
-            retval += "\n";
-          } break;
-          
-          // Capital AM/PM indicator.
-          case 'p': {
-            retval += (Hour() < 12) ? "AM" : "PM";
-          } break;
-          
-          // Lowercase am/pm indicator.
-          case 'P': {
-            retval += (Hour() < 12) ? "am" : "pm";
-          } break;
-          
-          // Time in am/pm notation. In POSIX locale this is equivalent to
-          // "%I:%M:%S %p".
-          case 'r': {
-            string tmpstr;
-            retval += to_string(tmpstr, "%I:%M:%S %p");
-          } break;
-          
-          // Time in 24-hour notation (%H:%M).
-          case 'R': {
-            string tmpstr;
-            retval += to_string(tmpstr, "%H:%M");
-          } break;
-          
-          // Second (00..60).
-          case 'S': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = Second().to_string(tmpstr);
-          } break;
-          
-          // Day of month suffix (st, nd, rd, th).
-          case 's': {
-            if (Day() > 3 && Day() < 21) {
-              retval += "th";
-            } else {
-              switch (static_cast<int>(Day()) % 10) {
-                case 1:  retval += "st"; break;
-                case 2:  retval += "nd"; break;
-                case 3:  retval += "rd"; break;
-                default: retval += "th"; break;
-              }
-            }
-          } break;
-          
-          // Horizontal tab.
-          case 't': {
-            retval += "\t";
-          } break;
-          
-          // Time (%H:%M:%S).
-          case 'T': {
-            string tmpstr;
-            retval += to_string(tmpstr, "%H:%M:%S");
-          } break;
-          
-          // ISO weekday (1=Monday..7=Sunday).
-          case 'u': {
-            string tmpstr;
-            retval += dowISO().to_string(tmpstr);
-          } break;
-          
-          // Week number. First Sunday of January is the first day of week 1.
-          // Days before this are week 0 (00..53).
-          case 'U': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = woy(DOW_SUNDAY).to_string(tmpstr);
-          } break;
-          
-          // Week of year according to ISO-8601 rules, week 1 of a given year
-          // is the week containing the 4th of January, Monday is the first
-          // day of the week. (01..53).
-          case 'V': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = woyISO().to_string(tmpstr);
-          } break;
-          
-          // Weekday number (0=Sunday..6=Saturday).
-          case 'w': {
-            string tmpstr;
-            retval += dow().to_string(tmpstr);
-          } break;
-          
-          // Week number. First Monday of January is the first day of week 1.
-          // Days before this are week 0 (00..53).
-          case 'W': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = woy(DOW_MONDAY).to_string(tmpstr);
-          } break;
-          
-          // Date represtation (%m/%d/%y).
-          case 'x': {
-            string tmpstr;
-            retval += to_string(tmpstr, "%m/%d/%y");
-          } break;
-          
-          // Time representation (%H:%M:%S).
-          case 'X': {
-            string tmpstr;
-            retval += to_string(tmpstr, "%H:%M:%S");
-          } break;
-          
-          // Last two digits of the year.
-          case 'y': {
-            string tmpstr;
-            fieldlen = 2;
-            numfield = (Year() % 100).to_string(tmpstr);
-          } break;
-          
-          // Year.
-          case 'Y': {
-            string tmpstr;
-            retval += Year().to_string(tmpstr);
-          } break;
-          
-          // Offset from UTC in the ISO 8601:2000 standard format
-          // (+hhmm or -hhmm), or by nothing if no timezone is determinable.
-          case 'z': {
-            string tmpstr;
-            string offset   = (_offset.abs() * 1440).to_string(tmpstr);
-            bool   positive = _offset >= 0;
-            offset.insert(0, 4 - offset.length(), '0');
-            offset.insert(0, 1, positive ? '+' : '-');
-            retval += offset;
-          } break;
-          
-          // Timezone name or abbreviation, or nothing if no timezone.
-          case 'Z': {
-            retval += _tzname;
-          } break;
-          
-          // Unknown option.
-          default: {
-            throw Errors::BadFormat().Problem("Invalid character").Position(i - fmt->begin());
-          } break;
-          
-        }
-        
-        // Add numeric field.
-        if (!numfield.empty()) {
-          
-          // Pad if necessary.
-          if (numfield.length() < fieldlen) {
-            switch ((mod == PAD_DEPAD) ? fieldpad : mod) {
-              case PAD_DEPAD:
-              case PAD_ZRPAD: numfield.insert(0, fieldlen - numfield.length(), '0'); break;
-              case PAD_NOPAD: break;
-              case PAD_SPPAD: numfield.insert(0, fieldlen - numfield.length(), ' '); break;
-            }
-          }
-          
-          // Add the field.
-          retval += numfield;
-          
-        }
-        
-      // Regular character.
-      } else {
-        retval += *i;
-      }
-      
+  }
+  
+  /*
+   * Convert a list of strings to timestamps.
+   */
+  vector<Timestamp>& Timestamp::parse (vector<Timestamp>& buffer, vector<string> const& text, CompiledFormat const& format, Timestamp const& prototype) {
+    
+    // Work area.
+    vector<Timestamp> retval(text.size(), prototype);
+    
+    // Convert each string.
+    for (vector<string>::size_type i = 0; i != text.size(); ++i) {
+      retval[i]._fromString(text[i], format);
     }
     
-    // We done, return the string.
+    // We done.
     buffer.swap(retval);
     return buffer;
     
@@ -675,9 +601,14 @@ namespace DAC {
    */
   Timestamp::TimeVal Timestamp::dow () const {
     
-    // Day of week is simply the JD modulo 7 rot 1.
+    // Fast representation.
+    if (_fast) {
+      return TimeVal(s_fastDow(_fastLocalDay()));
+    }
+    
+    // Day of week is simply the local day number modulo 7 rot 1.
     TimeVal daynum;
-    daynum = (_jd + 0.5).floor() % 7 + 1;
+    daynum = _localDay() % 7 + 1;
     return (daynum > static_cast<unsigned int>(DOW_SATURDAY)) ? daynum - 7 : daynum;
     
   }
@@ -701,6 +632,11 @@ namespace DAC {
    */
   Timestamp::TimeVal Timestamp::doy () const {
     
+    // Fast representation.
+    if (_fast) {
+      return TimeVal(_fastDoy());
+    }
+    
     // This is it.
     return (_isLeapYear(Year()) ? _DAYS_OF_YEAR_LY[Month()] : _DAYS_OF_YEAR_NY[Month()]) + Day();
     
@@ -711,6 +647,11 @@ namespace DAC {
    */
   Timestamp::TimeVal Timestamp::woy (DayOfWeek const base) const {
     
+    // Fast representation.
+    if (_fast) {
+      return TimeVal(_fastWoy(base));
+    }
+    
     // Get the first day of this year.
     Timestamp dayone(Interval().Year(Year()).Month(TimeVal(static_cast<unsigned int>(MON_JANUARY))).Day(TimeVal(1)));
     
@@ -722,7 +663,7 @@ namespace DAC {
     
     // Get the difference between today and the first day of the first week of
     // the year.
-    TimeVal woyday = this->jdday() - (dayone.jdday() - 1);
+    TimeVal woyday = _localDay() - (dayone.jdday() - 1);
     
     // Divide by 7, that's the week.
     return ceil(woyday / 7);
@@ -734,6 +675,11 @@ namespace DAC {
    */
   Timestamp::TimeVal Timestamp::woyISO () const {
     
+    // Fast representation.
+    if (_fast) {
+      return TimeVal(_fastWoyISO());
+    }
+    
     // Get the ISO year so we know what year to calculate from.
     TimeVal year = getISOYear();
     
@@ -745,7 +691,7 @@ namespace DAC {
     isodayone -= isodayone.dowISO() - static_cast<unsigned int>(ISO_DOW_MONDAY);
     
     // Get the difference between this date and the 1st ISO day.
-    TimeVal isoday = this->jdday() - (isodayone.jdday() - 1);
+    TimeVal isoday = _localDay() - (isodayone.jdday() - 1);
     
     // Divide by 7, that's the ISO week.
     return ceil(isoday / 7);
@@ -757,6 +703,11 @@ namespace DAC {
    */
   Timestamp::TimeVal Timestamp::getISOYear () const {
     
+    // Fast representation.
+    if (_fast) {
+      return TimeVal(_fastISOYear());
+    }
+    
     // If it is before January 4th and this week did not contain a Thursday,
     // then according to ISO it is last year.
     if ((Month() == 1 && Day() < 4) && dowISO() - Day() >= static_cast<unsigned int>(ISO_DOW_THURSDAY)) {
@@ -794,6 +745,19 @@ namespace DAC {
    */
   Timestamp& Timestamp::_set (Interval const& time) {
     
+    // Integer fields take the fast path.
+    long long fields[7] = { 1, 1, 1, 12, 0, 0, 0 };
+    if ((!time.isSet_Year       () || s_fastToLong(time.Year       (), fields[0])) &&
+        (!time.isSet_Month      () || s_fastToLong(time.Month      (), fields[1])) &&
+        (!time.isSet_Day        () || s_fastToLong(time.Day        (), fields[2])) &&
+        (!time.isSet_Hour       () || s_fastToLong(time.Hour       (), fields[3])) &&
+        (!time.isSet_Minute     () || s_fastToLong(time.Minute     (), fields[4])) &&
+        (!time.isSet_Second     () || s_fastToLong(time.Second     (), fields[5])) &&
+        (!time.isSet_Millisecond() || s_fastToLong(time.Millisecond(), fields[6])) &&
+        _fastSet(fields[0], fields[1], fields[2], fields[3], fields[4], fields[5], fields[6])) {
+      return *this;
+    }
+    
     // Work area.
     Interval settime(time);
     
@@ -821,13 +785,11 @@ namespace DAC {
       throw Errors::InvalidTime();
     }
     
-    // Invalidate the cache.
-    _cache_valid = false;
-    
     // Adjust BCE years.
     TimeVal y = settime.Year() + ((settime.Year() < 0) ? 1 : 0);
     
-    // Set the julian date.
+    // Get the julian date.
+    TimeVal jd;
     TimeVal n;
     TimeVal r;
     if (settime.Month() < 3) {
@@ -837,18 +799,18 @@ namespace DAC {
       n = y;
       r = 1;
     }
-    _jd = 1720995 + floor(n * 365.25) + (30.6001 * (settime.Month() + r)).truncate() + settime.Day();
+    jd = 1720995 + floor(n * 365.25) + (30.6001 * (settime.Month() + r)).truncate() + settime.Day();
     if (caltype == CT_GREGORIAN) {
       TimeVal m = (n / 100).truncate();
       TimeVal q = 2 + 2 * (n / 400).truncate();
-      _jd += q - m - (m / 4).truncate();
+      jd += q - m - (m / 4).truncate();
     }
     
     // Add the time.
-    _jd += ((settime.Hour() - 12) + (settime.Minute() + (settime.Second() + settime.Millisecond() / 1000) / 60) / 60) / 24;
+    jd += ((settime.Hour() - 12) + (settime.Minute() + (settime.Second() + settime.Millisecond() / 1000) / 60) / 60) / 24;
     
-    // We done, return.
-    return *this;
+    // We done, set and return.
+    return _setJD(jd);
     
   }
   
@@ -879,8 +841,8 @@ namespace DAC {
     // from picking up _jd's fixed-pointedness. Also create a time only.
     TimeVal cjd;
     TimeVal time;
-    cjd  = (_jd + 0.5).floor();
-    time = _jd + 0.5 - cjd;
+    cjd  = (_getJD() + 0.5).floor();
+    time = _getJD() + 0.5 - cjd;
     
     // Correct for Julian / Gregorian calendars.
     if (cjd > _lastjulianjd) {
@@ -974,6 +936,22 @@ namespace DAC {
    */
   void Timestamp::_loadCache () const {
     
+    // Fast representation.
+    if (_fast) {
+      if (!_fastcache_valid) {
+        _fastLoadCache();
+      }
+      _cache_year        = _fastcache.Year       ;
+      _cache_month       = _fastcache.Month      ;
+      _cache_day         = _fastcache.Day        ;
+      _cache_hour        = _fastcache.Hour       ;
+      _cache_minute      = _fastcache.Minute     ;
+      _cache_second      = _fastcache.Second     ;
+      _cache_millisecond = _fastcache.Millisecond;
+      _cache_valid       = true;
+      return;
+    }
+    
     // Work area.
     Interval cache;
     
@@ -1069,42 +1047,1100 @@ namespace DAC {
   }
   
   /*
-   * Class initialization.
+   * Load the Julian Date from the fast representation.
    */
-  void Timestamp::s_classInit () {
+  void Timestamp::_loadJD () const {
     
-    // Set the default leap seconds.
-    s_defaultleapseconds = new LeapSecondList;
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1972,  6, 30),  1));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1972, 12, 31),  2));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1973, 12, 31),  3));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1974, 12, 31),  4));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1975, 12, 31),  5));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1976, 12, 31),  6));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1977, 12, 31),  7));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1978, 12, 31),  8));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1979, 12, 31),  9));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1981,  6, 30), 10));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1982,  6, 30), 11));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1983,  6, 30), 12));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1985,  6, 30), 13));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1987, 12, 31), 14));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1989, 12, 31), 15));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1990, 12, 31), 16));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1992,  6, 30), 17));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1993,  6, 30), 18));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1994,  6, 30), 19));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1995, 12, 31), 20));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1997,  6, 30), 21));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1998, 12, 31), 22));
-    s_defaultleapseconds->push_back(LeapSecondDay(YMD(2005, 12, 31), 23));
+    // Midnight of day 0 is JD -0.5.
+    _jd      = TimeVal(_fastday * _MS_PER_DAY + _fastms - _MS_PER_DAY / 2) / _MS_PER_DAY;
+    _jdvalid = true;
     
-    // Set the default format.
-    s_defaultformat = new Format("%c");
+  }
+  
+  /*
+   * Set the Julian Date, and the fast representation if it fits.
+   */
+  Timestamp& Timestamp::_setJD (TimeVal const& jd) {
     
-    // Class has been successfully initialized.
-    s_initialized = true;
+    // Work area.
+    long long ms = 0;
+    
+    // Set the jd.
+    _jd              = jd;
+    _jdvalid         = true;
+    _fast            = false;
+    _cache_valid     = false;
+    _fastcache_valid = false;
+    
+    // Use the fast representation if it is a whole millisecond in range.
+    if (fast_path && _fastlastjulian && s_fastToMS(_jd + 0.5, _MS_PER_DAY, ms)) {
+      long long const day = s_floorDiv(ms, _MS_PER_DAY);
+      if (day >= _FAST_MINDAY && day <= _FAST_MAXDAY) {
+        _fastday = day;
+        _fastms  = s_floorMod(ms, _MS_PER_DAY);
+        _fast    = true;
+      }
+    }
+    
+    // We done.
+    return *this;
+    
+  }
+  
+  /*
+   * Move by a number of milliseconds.
+   */
+  void Timestamp::_addMS (long long const ms) {
+    if (_fast) {
+      _fastSetDay(_fastday, _fastms + ms);
+    } else {
+      _setJD(_getJD() + TimeVal(ms) / _MS_PER_DAY);
+    }
+  }
+  
+  /*
+   * Compare with another timestamp.
+   */
+  int Timestamp::_compare (Timestamp const& ts) const {
+    
+    // Fast representation.
+    if (_fast && ts._fast) {
+      long long const diff = (_fastday - ts._fastday) * _MS_PER_DAY + (_fastms - ts._fastms) + 60000LL * (_offset - ts._offset);
+      return (diff > 0) - (diff < 0);
+    }
+    
+    // Arb.
+    TimeVal const l(_getJD()    + _offsetDays()   );
+    TimeVal const r(ts._getJD() + ts._offsetDays());
+    return (l > r) ? 1 : ((l < r) ? -1 : 0);
+    
+  }
+  
+  /*
+   * Convert to a string with a compiled format, appending to buffer.
+   */
+  void Timestamp::_toString (string& buffer, CompiledFormat const& format) const {
+    
+    // Use integer fields if possible.
+    bool const fast = _fast;
+    if (fast && !_fastcache_valid) {
+      _fastLoadCache();
+    }
+    _FastFields const& f = _fastcache;
     
+    // Convert each field.
+    for (vector<CompiledFormat::Field>::const_iterator i = format._fields.begin(); i != format._fields.end(); ++i) {
+      
+      // Numeric fields set how to pad them, and a value on the fast path.
+      // The Arb path gets its value from _numericField, so that nothing
+      // here constructs an Arb.
+      string::size_type       fieldlen = 0;
+      CompiledFormat::PadType fieldpad = CompiledFormat::PAD_ZRPAD;
+      bool                    numeric  = true;
+      long long               value    = 0;
+      
+      switch (i->Code) {
+        
+        // Literal text.
+        case 0: {
+          buffer += i->Literal;
+          numeric = false;
+        } break;
+        
+        // Abbreviated weekday name.
+        case 'a': {
+          buffer += fast ? _SHORT_WEEKDAY_NAME[s_fastDow(_fastLocalDay())] : _SHORT_WEEKDAY_NAME[dow()];
+          numeric = false;
+        } break;
+        
+        // Full weekday name, variable length.
+        case 'A': {
+          buffer += fast ? _LONG_WEEKDAY_NAME[s_fastDow(_fastLocalDay())] : _LONG_WEEKDAY_NAME[dow()];
+          numeric = false;
+        } break;
+        
+        // Abbreviated month name.
+        case 'b': {
+          buffer += fast ? _SHORT_MONTH_NAME[f.Month] : _SHORT_MONTH_NAME[Month()];
+          numeric = false;
+        } break;
+        
+        // Full month name, variable length.
+        case 'B': {
+          buffer += fast ? _LONG_MONTH_NAME[f.Month] : _LONG_MONTH_NAME[Month()];
+          numeric = false;
+        } break;
+        
+        // Century (00..99).
+        case 'C': {
+          fieldlen = 2;
+          if (fast) {
+            value = s_floorDiv(f.Year, 100);
+            value = ((value < 0) ? -value : value) % 100;
+          }
+        } break;
+        
+        // Day of month (01..31).
+        case 'd': {
+          fieldlen = 2;
+          if (fast) { value = f.Day; }
+        } break;
+        
+        // Day of month, blank padded.
+        case 'e': {
+          fieldlen = 2;
+          fieldpad = CompiledFormat::PAD_SPPAD;
+          if (fast) { value = f.Day; }
+        } break;
+        
+        // The 2-digit year corresponding to the %V week number.
+        case 'g': {
+          fieldlen = 2;
+          if (fast) {
+            value = _fastISOYear() % 100;
+            value = (value < 0) ? -value : value;
+          }
+        } break;
+        
+        // The ISO year.
+        case 'G': {
+          if (fast) { value = _fastISOYear(); }
+        } break;
+        
+        // 24-hour clock hour (00..23).
+        case 'H': {
+          fieldlen = 2;
+          if (fast) { value = f.Hour; }
+        } break;
+        
+        // 12-hour clock hour (01..12).
+        case 'I': {
+          fieldlen = 2;
+          if (fast) {
+            value = (f.Hour > 12) ? f.Hour - 12 : ((f.Hour == 0) ? 12 : f.Hour);
+          }
+        } break;
+        
+        // Day of year (001..366).
+        case 'j': {
+          fieldlen = 3;
+          if (fast) { value = _fastDoy(); }
+        } break;
+        
+        // Month (01..12).
+        case 'm': {
+          fieldlen = 2;
+          if (fast) { value = f.Month; }
+        } break;
+        
+        // Minute (00..59).
+        case 'M': {
+          fieldlen = 2;
+          if (fast) { value = f.Minute; }
+        } break;
+        
+        // Capital AM/PM indicator.
+        case 'p': {
+          buffer += (fast ? f.Hour < 12 : Hour() < 12) ? "AM" : "PM";
+          numeric = false;
+        } break;
+        
+        // Lowercase am/pm indicator.
+        case 'P': {
+          buffer += (fast ? f.Hour < 12 : Hour() < 12) ? "am" : "pm";
+          numeric = false;
+        } break;
+        
+        // Second (00..60).
+        case 'S': {
+          fieldlen = 2;
+          if (fast) { value = f.Second; }
+        } break;
+        
+        // Day of month suffix (st, nd, rd, th).
+        case 's': {
+          int const day = fast ? static_cast<int>(f.Day) : static_cast<int>(Day());
+          if (day > 3 && day < 21) {
+            buffer += "th";
+          } else {
+            switch (day % 10) {
+              case 1:  buffer += "st"; break;
+              case 2:  buffer += "nd"; break;
+              case 3:  buffer += "rd"; break;
+              default: buffer += "th"; break;
+            }
+          }
+          numeric = false;
+        } break;
+        
+        // ISO weekday (1=Monday..7=Sunday).
+        case 'u': {
+          if (fast) {
+            value = s_fastDow(_fastLocalDay());
+            value = (value == 0) ? 7 : value;
+          }
+        } break;
+        
+        // Week number. First Sunday of January is the first day of week 1.
+        // Days before this are week 0 (00..53).
+        case 'U': {
+          fieldlen = 2;
+          if (fast) { value = _fastWoy(DOW_SUNDAY); }
+        } break;
+        
+        // Week of year according to ISO-8601 rules, week 1 of a given year
+        // is the week containing the 4th of January, Monday is the first
+        // day of the week. (01..53).
+        case 'V': {
+          fieldlen = 2;
+          if (fast) { value = _fastWoyISO(); }
+        } break;
+        
+        // Weekday number (0=Sunday..6=Saturday).
+        case 'w': {
+          if (fast) { value = s_fastDow(_fastLocalDay()); }
+        } break;
+        
+        // Week number. First Monday of January is the first day of week 1.
+        // Days before this are week 0 (00..53).
+        case 'W': {
+          fieldlen = 2;
+          if (fast) { value = _fastWoy(DOW_MONDAY); }
+        } break;
+        
+        // Last two digits of the year.
+        case 'y': {
+          fieldlen = 2;
+          if (fast) { value = f.Year % 100; }
+        } break;
+        
+        // Year.
+        case 'Y': {
+          if (fast) { value = f.Year; }
+        } break;
+        
+        // Offset from UTC in the ISO 8601:2000 standard format
+        // (+hhmm or -hhmm), or by nothing if no timezone is determinable.
+        case 'z': {
+          int const minutes = (_offset >= 0) ? _offset : -_offset;
+          buffer += (_offset >= 0) ? '+' : '-';
+          s_appendNumber(buffer, minutes / 60 * 100 + minutes % 60, 4, '0');
+          numeric = false;
+        } break;
+        
+        // Timezone name or abbreviation, or nothing if no timezone.
+        case 'Z': {
+          buffer += _tzname;
+          numeric = false;
+        } break;
+        
+      }
+      
+      // Add numeric field.
+      if (numeric) {
+        
+        // Select the padding.
+        char pad = '0';
+        switch ((i->Pad == CompiledFormat::PAD_DEPAD) ? fieldpad : i->Pad) {
+          case CompiledFormat::PAD_DEPAD:
+          case CompiledFormat::PAD_ZRPAD: pad = '0';  break;
+          case CompiledFormat::PAD_NOPAD: fieldlen = 0; break;
+          case CompiledFormat::PAD_SPPAD: pad = ' ';  break;
+        }
+        
+        // Add the field.
+        if (fast) {
+          s_appendNumber(buffer, value, fieldlen, pad);
+        } else {
+          string numfield;
+          _numericField(i->Code).to_string(numfield);
+          if (numfield.length() < fieldlen) {
+            numfield.insert(0, fieldlen - numfield.length(), pad);
+          }
+          buffer += numfield;
+        }
+        
+      }
+      
+    }
+    
+  }
+  
+  /*
+   * Get a numeric field of a compiled format through Arb.
+   */
+  Timestamp::TimeVal Timestamp::_numericField (char const code) const {
+    switch (code) {
+      case 'C': return (Year() / 100).floor().abs() % 100;
+      case 'd': return Day();
+      case 'e': return Day();
+      case 'g': return (getISOYear() % 100).abs();
+      case 'G': return getISOYear();
+      case 'H': return Hour();
+      case 'I': {
+        TimeVal hour = Hour();
+        return (hour > 12) ? hour - 12 : ((hour == 0) ? hour + 12 : hour);
+      }
+      case 'j': return doy();
+      case 'm': return Month();
+      case 'M': return Minute();
+      case 'S': return Second();
+      case 'u': return dowISO();
+      case 'U': return woy(DOW_SUNDAY);
+      case 'V': return woyISO();
+      case 'w': return dow();
+      case 'W': return woy(DOW_MONDAY);
+      case 'y': return Year() % 100;
+      case 'Y': return Year();
+    }
+    return TimeVal();
+  }
+  
+  /*
+   * Set from a string with a compiled format.
+   */
+  void Timestamp::_fromString (string const& text, CompiledFormat const& format) {
+    
+    // Fields read, defaults are the same as _set.
+    long long year      = 1;
+    long long month     = 1;
+    long long day       = 1;
+    long long hour      = 12;
+    long long minute    = 0;
+    long long second    = 0;
+    long long century   = -1;
+    long long shortyear = -1;
+    long long hour12    = -1;
+    bool      pm        = false;
+    bool      hasyear   = false;
+    bool      hashour   = false;
+    long long offset    = _offset;
+    string    tzname    (_tzname);
+    
+    // Read each field.
+    string::size_type pos = 0;
+    for (vector<CompiledFormat::Field>::const_iterator i = format._fields.begin(); i != format._fields.end(); ++i) {
+      switch (i->Code) {
+        
+        // Literal text must match exactly.
+        case 0: {
+          if (text.compare(pos, i->Literal.length(), i->Literal) != 0) {
+            throw Errors::BadString().Problem("Text does not match format").Position(pos);
+          }
+          pos += i->Literal.length();
+        } break;
+        
+        // Weekday names, not needed for the time.
+        case 'a': s_parseName(text, pos, _SHORT_WEEKDAY_NAME, 0, 7); break;
+        case 'A': s_parseName(text, pos, _LONG_WEEKDAY_NAME , 0, 7); break;
+        
+        // Month names.
+        case 'b': month = s_parseName(text, pos, _SHORT_MONTH_NAME, 1, 13); break;
+        case 'B': month = s_parseName(text, pos, _LONG_MONTH_NAME , 1, 13); break;
+        
+        // Numbers that make up the time.
+        case 'C':                  century   = s_parseNumber(text, pos, 2, false); break;
+        case 'd': case 'e':        day       = s_parseNumber(text, pos, 2, false); break;
+        case 'H': hashour = true;  hour      = s_parseNumber(text, pos, 2, false); break;
+        case 'I':                  hour12    = s_parseNumber(text, pos, 2, false); break;
+        case 'm':                  month     = s_parseNumber(text, pos, 2, false); break;
+        case 'M':                  minute    = s_parseNumber(text, pos, 2, false); break;
+        case 'S':                  second    = s_parseNumber(text, pos, 2, false); break;
+        case 'y':                  shortyear = s_parseNumber(text, pos, 2, false); break;
+        case 'Y': hasyear = true;  year      = s_parseNumber(text, pos, 0, true ); break;
+        
+        // Numbers that follow from the time.
+        case 'g': case 'U': case 'V': case 'W': s_parseNumber(text, pos, 2, false); break;
+        case 'j':                               s_parseNumber(text, pos, 3, false); break;
+        case 'u': case 'w':                     s_parseNumber(text, pos, 1, false); break;
+        case 'G':                               s_parseNumber(text, pos, 0, true ); break;
+        
+        // AM/PM indicator.
+        case 'p':
+        case 'P': {
+          if (pos + 2 <= text.length() && (text[pos + 1] == 'M' || text[pos + 1] == 'm') && (text[pos] == 'A' || text[pos] == 'a' || text[pos] == 'P' || text[pos] == 'p')) {
+            pm = text[pos] == 'P' || text[pos] == 'p';
+            pos += 2;
+          } else {
+            throw Errors::BadString().Problem("Expected AM or PM").Position(pos);
+          }
+        } break;
+        
+        // Day of month suffix.
+        case 's': {
+          if (text.compare(pos, 2, "st") != 0 && text.compare(pos, 2, "nd") != 0 && text.compare(pos, 2, "rd") != 0 && text.compare(pos, 2, "th") != 0) {
+            throw Errors::BadString().Problem("Expected a day suffix").Position(pos);
+          }
+          pos += 2;
+        } break;
+        
+        // Offset from UTC.
+        case 'z': {
+          if (pos == text.length() || (text[pos] != '+' && text[pos] != '-')) {
+            throw Errors::BadString().Problem("Expected an offset").Position(pos);
+          }
+          bool            const negative = text[pos++] == '-';
+          string::size_type const start    = pos;
+          long long         const hhmm     = s_parseNumber(text, pos, 4, false);
+          if (hhmm % 100 >= 60) {
+            throw Errors::BadString().Problem("Offset minutes out of range").Position(start);
+          }
+          offset = hhmm / 100 * 60 + hhmm % 100;
+          if (negative) {
+            offset = -offset;
+          }
+        } break;
+        
+        // Timezone name, up to the next blank.
+        case 'Z': {
+          string::size_type end = text.find_first_of(" \t\n", pos);
+          if (end == string::npos) {
+            end = text.length();
+          }
+          tzname.assign(text, pos, end - pos);
+          pos = end;
+        } break;
+        
+      }
+    }
+    
+    // Nothing may follow.
+    if (pos != text.length()) {
+      throw Errors::BadString().Problem("Extra text after format").Position(pos);
+    }
+    
+    // Two-digit years are 1969 through 2068 unless the century is given.
+    if (!hasyear && shortyear >= 0) {
+      year = (century >= 0) ? century * 100 + shortyear : shortyear + ((shortyear < 69) ? 2000 : 1900);
+    }
+    
+    // 12-hour clock.
+    if (!hashour && hour12 >= 0) {
+      if (hour12 < 1 || hour12 > 12) {
+        throw Errors::InvalidTime();
+      }
+      hour = hour12 % 12 + (pm ? 12 : 0);
+    }
+    
+    // Check the offset before anything is changed.
+    if (offset < -720) { throw Errors::OffsetMin(); }
+    if (offset >  720) { throw Errors::OffsetMax(); }
+    
+    // Set in GMT, through Arb if it cannot be done quickly.
+    if (!_fastSet(year, month, day, hour, minute, second, 0)) {
+      _set(Interval().Year  (TimeVal(year  ))
+                     .Month (TimeVal(month ))
+                     .Day   (TimeVal(day   ))
+                     .Hour  (TimeVal(hour  ))
+                     .Minute(TimeVal(minute))
+                     .Second(TimeVal(second)));
+    }
+    
+    // Correct for the offset.
+    _offset = static_cast<int>(offset);
+    _tzname.swap(tzname);
+    if (_offset) {
+      _addMS(-60000LL * _offset);
+    }
+    
+  }
+  
+  /*
+   * Set from fields in GMT through the fast representation.
+   */
+  bool Timestamp::_fastSet (long long const year, long long const month, long long const day, long long const hour, long long const minute, long long const second, long long const millisecond) {
+    
+    // Keep the arithmetic well inside long long, leave the rest to Arb.
+    if (!fast_path || !_fastlastjulian || year < -10000000 || year > 10000000) {
+      return false;
+    }
+    
+    // Verify that the new time is a valid time, same as _set.
+    if ((year        == 0)                                                                                                                              ||
+        (month       <  1) || (month       > 12                                                                                                       ) ||
+        (day         <  1) || (day         > _fastDaysInMonth(year, month)                                                                            ) ||
+        (hour        <  0) || (hour        > 23                                                                                                       ) ||
+        (minute      <  0) || (minute      > 59                                                                                                       ) ||
+        (second      <  0) || (second      > 59 + ((hour == 23 && minute == 59 && second > 58) ? static_cast<int>(_leapSecond(TimeVal(year), TimeVal(month), TimeVal(day))) : 0)) ||
+        (millisecond <  0) || (millisecond > 999                                                                                                      )
+    ) {
+      throw Errors::InvalidTime();
+    }
+    
+    // Get the day, outside of the fast range leave it to Arb.
+    long long const dayno = s_fastDayNumber(year, month, day, _fastGetCalendarType(year, month, day) == CT_GREGORIAN);
+    if (dayno < _FAST_MINDAY || dayno > _FAST_MAXDAY) {
+      return false;
+    }
+    
+    // Set.
+    _fastSetDay(dayno, ((hour * 60 + minute) * 60 + second) * 1000 + millisecond);
+    return true;
+    
+  }
+  
+  /*
+   * Set the fast representation.
+   */
+  void Timestamp::_fastSetDay (long long day, long long ms) {
+    
+    // Normalize to a millisecond of the day.
+    day += s_floorDiv(ms, _MS_PER_DAY);
+    ms   = s_floorMod(ms, _MS_PER_DAY);
+    
+    // Invalidate the cache.
+    _cache_valid     = false;
+    _fastcache_valid = false;
+    
+    // Set, through Arb if out of range.
+    if (_fastlastjulian && day >= _FAST_MINDAY && day <= _FAST_MAXDAY) {
+      _fastday = day;
+      _fastms  = ms;
+      _fast    = true;
+      _jdvalid = false;
+    } else {
+      _fast    = false;
+      _jd      = TimeVal(day) + TimeVal(ms - _MS_PER_DAY / 2) / _MS_PER_DAY;
+      _jdvalid = true;
+    }
+    
+  }
+  
+  /*
+   * Get the local day and millisecond.
+   */
+  void Timestamp::_fastLocal (long long& day, long long& ms) const {
+    ms  = _fastms + 60000LL * _offset;
+    day = _fastday + s_floorDiv(ms, _MS_PER_DAY);
+    ms  = s_floorMod(ms, _MS_PER_DAY);
+  }
+  
+  /*
+   * Get the local day number.
+   */
+  long long Timestamp::_fastLocalDay () const {
+    return _fastday + s_floorDiv(_fastms + 60000LL * _offset, _MS_PER_DAY);
+  }
+  
+  /*
+   * Break a day and millisecond down into fields.
+   */
+  void Timestamp::_fastGet (_FastFields& fields, long long const day, long long const ms) const {
+    
+    // Date, same calendar rule as _get.
+    s_fastCivil(day, day > _fastlastjulianjd, fields.Year, fields.Month, fields.Day);
+    
+    // Time.
+    fields.Hour        = ms / 3600000;
+    fields.Minute      = ms / 60000 % 60;
+    fields.Second      = ms / 1000 % 60;
+    fields.Millisecond = ms % 1000;
+    
+  }
+  
+  /*
+   * Load the fast cache.
+   */
+  void Timestamp::_fastLoadCache () const {
+    
+    // Work area.
+    long long day = 0;
+    long long ms  = 0;
+    
+    // Local fields.
+    _fastLocal(day, ms);
+    _fastGet(_fastcache, day, ms);
+    
+    // Cache is now valid.
+    _fastcache_valid = true;
+    
+  }
+  
+  /*
+   * Get whether a given year is a leap year, same as _isLeapYear.
+   */
+  bool Timestamp::_fastIsLeapYear (long long const year) const {
+    
+    // The calendar in effect on 3/0, see _isLeapYear.
+    CalendarType caltype = _fastGetCalendarType(year, 3, 0);
+    
+    // The year 0 did not exist.
+    if (year == 0) {
+      throw Errors::NoYearZero();
+    }
+    
+    // Correct for no 0 year.
+    long long const y = year + ((year < 0) ? 1 : 0);
+    
+    // Choose the calendar type.
+    return (caltype == CT_JULIAN) ? y % 4 == 0 : y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+    
+  }
+  
+  /*
+   * Get the number of days in a month.
+   */
+  long long Timestamp::_fastDaysInMonth (long long const year, long long const month) const {
+    switch (month) {
+      case 1: case 3: case 5: case 7: case 8: case 10: case 12: return 31;
+      case 4: case 6: case 9: case 11:                          return 30;
+      case 2:                                                   return _fastIsLeapYear(year) ? 29 : 28;
+    }
+    return 0;
+  }
+  
+  /*
+   * Get the day of the year.
+   */
+  long long Timestamp::_fastDoy () const {
+    if (!_fastcache_valid) {
+      _fastLoadCache();
+    }
+    return (_fastIsLeapYear(_fastcache.Year) ? _DAYS_OF_YEAR_LY[_fastcache.Month] : _DAYS_OF_YEAR_NY[_fastcache.Month]) + _fastcache.Day;
+  }
+  
+  /*
+   * Get the week of the year, same as woy.
+   */
+  long long Timestamp::_fastWoy (DayOfWeek const base) const {
+    
+    // Get the first day of this year, in the default calendar.
+    if (!_fastcache_valid) {
+      _fastLoadCache();
+    }
+    long long const year   = _fastcache.Year;
+    long long       dayone = s_fastDayNumber(year, MON_JANUARY, 1, s_fastIsGregorian(year, MON_JANUARY, 1, _DEFAULT_LASTJULIAN_YEAR, _DEFAULT_LASTJULIAN_MONTH, _DEFAULT_LASTJULIAN_DAY));
+    
+    // Find the next base day.
+    if (s_fastDow(dayone) > base) {
+      dayone += 7 - s_fastDow(dayone);
+    }
+    dayone += base - s_fastDow(dayone);
+    
+    // Divide the days since the first day of the first week by 7, rounding
+    // up.
+    return -s_floorDiv(-(_fastLocalDay() - (dayone - 1)), 7);
+    
+  }
+  
+  /*
+   * Get the ISO week, same as woyISO.
+   */
+  long long Timestamp::_fastWoyISO () const {
+    
+    // Get the ISO year, the Monday of the week containing January 4th is the
+    // first ISO day.
+    long long const year = _fastISOYear();
+    if (year == 0) {
+      throw Errors::InvalidTime();
+    }
+    long long isodayone = s_fastDayNumber(year, MON_JANUARY, 4, s_fastIsGregorian(year, MON_JANUARY, 4, _DEFAULT_LASTJULIAN_YEAR, _DEFAULT_LASTJULIAN_MONTH, _DEFAULT_LASTJULIAN_DAY));
+    isodayone -= s_floorMod(s_fastDow(isodayone) + 6, 7);
+    
+    // Divide the days since the first ISO day by 7, rounding up.
+    return -s_floorDiv(-(_fastLocalDay() - (isodayone - 1)), 7);
+    
+  }
+  
+  /*
+   * Get the ISO year, same as getISOYear.
+   */
+  long long Timestamp::_fastISOYear () const {
+    
+    // Work area.
+    if (!_fastcache_valid) {
+      _fastLoadCache();
+    }
+    long long const dow    = s_fastDow(_fastLocalDay());
+    long long const dowiso = (dow == 0) ? 7 : dow;
+    
+    // Before January 4th and this week did not contain a Thursday.
+    if ((_fastcache.Month == MON_JANUARY && _fastcache.Day < 4) && dowiso - _fastcache.Day >= ISO_DOW_THURSDAY) {
+      return _fastcache.Year - 1;
+    }
+    
+    // After December 28th and this week will not contain a Thursday.
+    if ((_fastcache.Month == MON_DECEMBER && _fastcache.Day > 28) && _fastcache.Day + ISO_DOW_THURSDAY - dowiso > _fastDaysInMonth(_fastcache.Year, MON_DECEMBER)) {
+      return _fastcache.Year + 1;
+    }
+    
+    // Otherwise, it's this year.
+    return _fastcache.Year;
+    
+  }
+  
+  /*
+   * Class initialization.
+   */
+  void Timestamp::s_classInit () {
+    
+    // Set the default leap seconds.
+    s_defaultleapseconds = LSLptr::create();
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1972,  6, 30),  1));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1972, 12, 31),  2));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1973, 12, 31),  3));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1974, 12, 31),  4));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1975, 12, 31),  5));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1976, 12, 31),  6));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1977, 12, 31),  7));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1978, 12, 31),  8));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1979, 12, 31),  9));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1981,  6, 30), 10));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1982,  6, 30), 11));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1983,  6, 30), 12));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1985,  6, 30), 13));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1987, 12, 31), 14));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1989, 12, 31), 15));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1990, 12, 31), 16));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1992,  6, 30), 17));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1993,  6, 30), 18));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1994,  6, 30), 19));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1995, 12, 31), 20));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1997,  6, 30), 21));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(1998, 12, 31), 22));
+    s_defaultleapseconds->push_back(LeapSecondDay(YMD(2005, 12, 31), 23));
+    
+    // Set the default format.
+    s_defaultformat = CompiledFormatptr::create("%c");
+    
+    // Set the default last julian date.
+    s_defaultlastjulianymd = ReferencePointer<YMD    >::create(_DEFAULT_LASTJULIAN_YEAR, _DEFAULT_LASTJULIAN_MONTH, _DEFAULT_LASTJULIAN_DAY);
+    s_defaultlastjulianjd  = ReferencePointer<TimeVal>::create(_DEFAULT_LASTJULIAN_JD);
+    
+    // Class has been successfully initialized.
+    s_initialized = true;
+    
+  }
+  
+  
+  /*
+   * Get the Julian Day Number of a date, for either calendar.
+   */
+  long long Timestamp::s_fastDayNumber (long long const year, long long const month, long long const day, bool const gregorian) {
+    
+    // Count years from March so the leap day is last, correcting for no year
+    // 0.
+    long long const y   = year + ((year < 0) ? 1 : 0) - ((month <= 2) ? 1 : 0);
+    long long const doy = (153 * ((month > 2) ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    
+    // Gregorian years repeat every 400, Julian every 4.
+    if (gregorian) {
+      long long const era = s_floorDiv(y, 400);
+      long long const yoe = y - era * 400;
+      return era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy + 1721120;
+    } else {
+      long long const era = s_floorDiv(y, 4);
+      long long const yoe = y - era * 4;
+      return era * 1461 + yoe * 365 + doy + 1721118;
+    }
+    
+  }
+  
+  /*
+   * Get the date of a Julian Day Number, for either calendar.
+   */
+  void Timestamp::s_fastCivil (long long const dayno, bool const gregorian, long long& year, long long& month, long long& day) {
+    
+    // Work area.
+    long long y   = 0;
+    long long doy = 0;
+    
+    // Year and day of year, counting from March.
+    if (gregorian) {
+      long long const era = s_floorDiv(dayno - 1721120, 146097);
+      long long const doe = dayno - 1721120 - era * 146097;
+      long long const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+      y   = yoe + era * 400;
+      doy = doe - (yoe * 365 + yoe / 4 - yoe / 100);
+    } else {
+      long long const era = s_floorDiv(dayno - 1721118, 1461);
+      long long const doe = dayno - 1721118 - era * 1461;
+      long long const yoe = (doe - doe / 1460) / 365;
+      y   = yoe + era * 4;
+      doy = doe - yoe * 365;
+    }
+    
+    // Month and day.
+    long long const mp = (5 * doy + 2) / 153;
+    day   = doy - (153 * mp + 2) / 5 + 1;
+    month = (mp < 10) ? mp + 3 : mp - 9;
+    if (month <= 2) {
+      ++y;
+    }
+    
+    // There is no year 0.
+    year = (y <= 0) ? y - 1 : y;
+    
+  }
+  
+  /*
+   * Get an integer TimeVal.
+   */
+  bool Timestamp::s_fastToLong (TimeVal const& tv, long long& value) {
+    if (!tv.isInteger()) {
+      return false;
+    }
+    try {
+      value = tv.Value<long>();
+    } catch (Arb::Errors::ScalarOverflow&) {
+      return false;
+    } catch (Arb::Errors::ScalarUnderflow&) {
+      return false;
+    }
+    return true;
+  }
+  
+  /*
+   * Get a TimeVal in milliseconds.
+   */
+  bool Timestamp::s_fastToMS (TimeVal const& tv, long long const unit, long long& ms) {
+    
+    // Work area.
+    long long whole = 0;
+    long long part  = 0;
+    
+    // Whole units, the usual case.
+    if (tv.isInteger()) {
+      if (!s_fastToLong(tv, whole)) {
+        return false;
+      }
+      
+    // Whole units and a whole number of milliseconds.
+    } else {
+      TimeVal tvwhole(tv.floor());
+      if (!s_fastToLong(tvwhole, whole) || !s_fastToLong((tv - tvwhole) * TimeVal(unit), part)) {
+        return false;
+      }
+    }
+    
+    // Leave room to add to it.
+    if (whole > numeric_limits<long long>::max() / 4 / unit || whole < -(numeric_limits<long long>::max() / 4 / unit)) {
+      return false;
+    }
+    
+    // Done.
+    ms = whole * unit + part;
+    return true;
+    
+  }
+  
+  /*
+   * Append a number, padded to a width.
+   */
+  void Timestamp::s_appendNumber (string& buffer, long long const number, string::size_type const width, char const pad) {
+    
+    // Work area, digits are built backwards.
+    char               digits[24];
+    char*              p        = digits + sizeof(digits);
+    unsigned long long absolute = (number < 0) ? 0ULL - static_cast<unsigned long long>(number) : static_cast<unsigned long long>(number);
+    
+    // Get the digits.
+    do {
+      *--p = static_cast<char>('0' + absolute % 10);
+      absolute /= 10;
+    } while (absolute);
+    if (number < 0) {
+      *--p = '-';
+    }
+    
+    // Pad and add.
+    string::size_type const length = digits + sizeof(digits) - p;
+    if (length < width) {
+      buffer.append(width - length, pad);
+    }
+    buffer.append(p, length);
+    
+  }
+  
+  /*
+   * Read a number. Leading blanks are padding, width includes them.
+   */
+  long long Timestamp::s_parseNumber (string const& text, string::size_type& pos, string::size_type const width, bool const sign) {
+    
+    // Work area.
+    string::size_type const begin    = pos;
+    long long               retval   = 0;
+    bool                    negative = false;
+    
+    // Skip padding and the sign.
+    while (pos < text.length() && text[pos] == ' ' && (width == 0 || pos - begin < width)) {
+      ++pos;
+    }
+    if (sign && pos < text.length() && text[pos] == '-') {
+      negative = true;
+      ++pos;
+    }
+    
+    // Read digits.
+    string::size_type const digits = pos;
+    while (pos < text.length() && text[pos] >= '0' && text[pos] <= '9' && (width == 0 || pos - begin < width)) {
+      if (pos - digits == 18) {
+        throw Errors::BadString().Problem("Number is too long").Position(pos);
+      }
+      retval = retval * 10 + (text[pos] - '0');
+      ++pos;
+    }
+    if (pos == digits) {
+      throw Errors::BadString().Problem("Expected a number").Position(pos);
+    }
+    
+    // Done.
+    return negative ? -retval : retval;
+    
+  }
+  
+  /*
+   * Read a name from a list, returning its index.
+   */
+  long long Timestamp::s_parseName (string const& text, string::size_type& pos, char const* const* const names, long long const first, long long const last) {
+    for (long long i = first; i != last; ++i) {
+      string::size_type const length = char_traits<char>::length(names[i]);
+      if (text.compare(pos, length, names[i]) == 0) {
+        pos += length;
+        return i;
+      }
+    }
+    throw Errors::BadString().Problem("Expected a name").Position(pos);
+  }
+  
+  /*
+   * Get an interval from fast fields.
+   */
+  Timestamp::Interval Timestamp::s_fastInterval (_FastFields const& fields) {
+    return Interval().Millisecond(TimeVal(fields.Millisecond))
+                     .Second     (TimeVal(fields.Second     ))
+                     .Minute     (TimeVal(fields.Minute     ))
+                     .Hour       (TimeVal(fields.Hour       ))
+                     .Day        (TimeVal(fields.Day        ))
+                     .Month      (TimeVal(fields.Month      ))
+                     .Year       (TimeVal(fields.Year       ));
+  }
+  
+  /***************************************************************************
+   * Class Timestamp::CompiledFormat.
+   ***************************************************************************/
+  
+  /***************************************************************************/
+  // Function members.
+  
+  /*
+   * Default constructor.
+   */
+  Timestamp::CompiledFormat::CompiledFormat () {}
+  
+  /*
+   * Conversion constructor.
+   */
+  Timestamp::CompiledFormat::CompiledFormat (string const& format) {
+    
+    // Compile the format.
+    set(format);
+    
+  }
+  
+  /*
+   * Compile a new format.
+   */
+  Timestamp::CompiledFormat& Timestamp::CompiledFormat::set (string const& format) {
+    
+    // Compile into a new list so errors leave this unchanged.
+    CompiledFormat newformat;
+    newformat._compile(format, string::npos);
+    
+    // We done.
+    _fields.swap(newformat._fields);
+    return *this;
+    
+  }
+  
+  /*
+   * Compile a format. Nested formats report errors at position.
+   */
+  void Timestamp::CompiledFormat::_compile (string const& format, string::size_type const position) {
+    
+    // Check for control characters.
+    for (string::const_iterator i = format.begin(); i != format.end(); ++i) {
+      
+      // Position of this field.
+      string::size_type const fieldpos = (position == string::npos) ? i - format.begin() : position;
+      
+      // Regular character.
+      if (*i != '%') {
+        _addLiteral(string(1, *i), fieldpos);
+        continue;
+      }
+      
+      // No dangling escape character.
+      if (++i == format.end()) {
+        throw Errors::BadFormat().Problem("Dangling escape character").Position(i - 1 - format.begin());
+      }
+      
+      // Modifiers.
+      PadType mod = PAD_DEPAD;
+      switch (*i) {
+        case '-': mod = PAD_NOPAD; ++i; break;
+        case '_': mod = PAD_SPPAD; ++i; break;
+      }
+      
+      // No dangling modifier.
+      if (i == format.end()) {
+        throw Errors::BadFormat().Problem("Dangling modifier").Position(i - 1 - format.begin());
+      }
+      
+      // Next character is a format option.
+      switch (*i) {
+        
+        // Literal characters.
+        case '%': _addLiteral("%" , fieldpos); break;
+        case 'n': _addLiteral("\n", fieldpos); break;
+        case 't': _addLiteral("\t", fieldpos); break;
+        
+        // Composite formats.
+        case 'c': _compile("%a %b %e %T %Y", fieldpos); break;
+        case 'D': _compile("%m/%d/%y"      , fieldpos); break;
+        case 'F': _compile("%Y-%m-%d"      , fieldpos); break;
+        case 'h': _compile("%b"            , fieldpos); break;
+        case 'r': _compile("%I:%M:%S %p"   , fieldpos); break;
+        case 'R': _compile("%H:%M"         , fieldpos); break;
+        case 'T': _compile("%H:%M:%S"      , fieldpos); break;
+        case 'x': _compile("%m/%d/%y"      , fieldpos); break;
+        case 'X': _compile("%H:%M:%S"      , fieldpos); break;
+        
+        // Fields.
+        case 'a': case 'A': case 'b': case 'B': case 'C': case 'd': case 'e':
+        case 'g': case 'G': case 'H': case 'I': case 'j': case 'm': case 'M':
+        case 'p': case 'P': case 's': case 'S': case 'u': case 'U': case 'V':
+        case 'w': case 'W': case 'y': case 'Y': case 'z': case 'Z': {
+          Field field;
+          field.Code     = *i;
+          field.Pad      = mod;
+          field.Position = fieldpos;
+          _fields.push_back(field);
+        } break;
+        
+        // Unknown option.
+        default: {
+          throw Errors::BadFormat().Problem("Invalid character").Position(i - format.begin());
+        } break;
+        
+      }
+      
+    }
+    
+  }
+  
+  /*
+   * Add literal text, joining it to any literal text before it.
+   */
+  void Timestamp::CompiledFormat::_addLiteral (string const& text, string::size_type const position) {
+    if (_fields.empty() || _fields.back().Code != 0) {
+      Field field;
+      field.Code     = 0;
+      field.Pad      = PAD_DEPAD;
+      field.Position = position;
+      _fields.push_back(field);
+    }
+    _fields.back().Literal += text;
   }
   
 }
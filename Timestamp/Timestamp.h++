@@ -39,6 +39,7 @@ namespace DAC {
       // Forward declarations.
       
       class LeapSecondDay;
+      class CompiledFormat;
       
       /***********************************************************************/
       // Enums.
@@ -102,6 +103,9 @@ namespace DAC {
       // Pointer to a format.
       typedef ReferencePointer<Format> Formatptr;
       
+      // Pointer to a compiled format.
+      typedef ReferencePointer<CompiledFormat> CompiledFormatptr;
+      
       /***********************************************************************/
       // Classes.
       
@@ -109,7 +113,6 @@ namespace DAC {
       class YMD {
         public:
           YMD () {};
-          YMD (YMD const& ymd) : Year(ymd.Year), Month(ymd.Month), Day(ymd.Day) {};
           YMD (TimeVal const& year, TimeVal const& month, TimeVal const& day) : Year(year), Month(month), Day(day) {};
           template <class T, class U, class V> YMD (T const year, U const month, V const day) : Year(year), Month(month), Day(day) {}
           TimeVal  Year;
@@ -193,6 +196,72 @@ namespace DAC {
         
       };
       
+      // A format string parsed once, for formatting or parsing many
+      // timestamps.
+      class CompiledFormat {
+        
+        /*
+         * Public members.
+         */
+        public:
+          
+          /*******************************************************************/
+          // Function members.
+          
+          // Default constructor.
+          CompiledFormat ();
+          
+          // Conversion constructor.
+          explicit CompiledFormat (std::string const& format);
+          
+          // Compile a new format.
+          CompiledFormat& set (std::string const& format);
+          
+        /*
+         * Private members.
+         */
+        private:
+          
+          /*******************************************************************/
+          // Friends.
+          
+          friend class Timestamp;
+          
+          /*******************************************************************/
+          // Enums.
+          
+          // Different types of field padding.
+          enum PadType { PAD_DEPAD, PAD_NOPAD, PAD_SPPAD, PAD_ZRPAD };
+          
+          /*******************************************************************/
+          // Classes.
+          
+          // One field of the format, either a conversion or literal text.
+          class Field {
+            public:
+              char                   Code    ; // Conversion, 0 for literal text.
+              PadType                Pad     ; // Padding modifier.
+              std::string::size_type Position; // Position in the format.
+              std::string            Literal ; // Literal text.
+          };
+          
+          /*******************************************************************/
+          // Data members.
+          
+          // Fields, composite conversions are expanded.
+          std::vector<Field> _fields;
+          
+          /*******************************************************************/
+          // Function members.
+          
+          // Compile a format and add it to the fields.
+          void _compile (std::string const& format, std::string::size_type const position);
+          
+          // Add literal text.
+          void _addLiteral (std::string const& text, std::string::size_type const position);
+        
+      };
+      
       /***********************************************************************/
       // Errors
       class Errors {
@@ -226,6 +295,27 @@ namespace DAC {
           // Bad value.
           class BadValue : public Base { public: virtual char const* what () const throw() { return "Bad value passed."; }; };
           
+          // String does not match the format.
+          class BadString : public BadValue {
+            public:
+              virtual char const* what () const throw() {
+                try {
+                  std::string tmpmsg(_problem + " at position " + DAC::to_string(SafeInt<std::string::size_type>(_position) + 1) + ".");
+                  return Exception::buffer_message(tmpmsg);
+                } catch (...) {
+                  return "String does not match format. Error creating message string.";
+                }
+              };
+              virtual ~BadString () throw() {};
+              BadString& Problem  (char const*            const problem ) { _problem  = problem ; return *this; };
+              BadString& Position (std::string::size_type const position) { _position = position; return *this; };
+              char const*            Problem  () const { return _problem.c_str(); }
+              std::string::size_type Position () const { return _position       ; }
+            private:
+              std::string            _problem ;
+              std::string::size_type _position;
+          };
+          
           // Invalid MJD sent.
           class BadMJD : public BadValue { public: virtual char const* what () const throw() { return "Invalid Modified Julian Date sent." ; }; };
           class MJDMax : public BadMJD   { public: virtual char const* what () const throw() { return "Modified Julian Date exceeds 99999."; }; };
@@ -337,6 +427,13 @@ namespace DAC {
       
       static const bool THREADSAFE;
       
+      /***********************************************************************/
+      // Tuning.
+      
+      // Keep times in a 64-bit day and millisecond when they fit, rather
+      // than an Arb Julian Date. Results are the same either way.
+      static bool fast_path;
+      
       /***********************************************************************/
       // Function members.
       
@@ -422,8 +519,20 @@ namespace DAC {
       
       // Follows the formatting rules at the following URL:
       // http://www.opengroup.org/onlinepubs/009695399/functions/strftime.html
-      std::string      & to_string (std::string& buffer, std::string const& format                ) const;
-      std::string const& to_string (                     std::string const& format = std::string()) const;
+      std::string      & to_string (std::string& buffer, std::string    const& format                ) const;
+      std::string const& to_string (                     std::string    const& format = std::string()) const;
+      std::string      & to_string (std::string& buffer, CompiledFormat const& format                ) const;
+      std::string const& to_string (                     CompiledFormat const& format                ) const;
+      
+      // Set from a string in the same format as to_string. Fields that do
+      // not determine the time are checked but ignored.
+      Timestamp& parse (std::string const& text, std::string    const& format = std::string());
+      Timestamp& parse (std::string const& text, CompiledFormat const& format                );
+      
+      // Format or parse a list of timestamps with one compiled format. Parsed
+      // timestamps start as copies of prototype.
+      static std::vector<std::string>& to_string (std::vector<std::string>& buffer, std::vector<Timestamp>   const& timestamps, CompiledFormat const& format                                     );
+      static std::vector<Timestamp>  & parse     (std::vector<Timestamp>  & buffer, std::vector<std::string> const& text      , CompiledFormat const& format, Timestamp const& prototype = Timestamp());
       
       // Arithmetic operator backends.
       Timestamp& op_add (TimeVal   const& tv)      ;
@@ -494,14 +603,50 @@ namespace DAC {
       // Full month names, January-December, 1 indexed.
       static char const* const _LONG_MONTH_NAME[];
       
+      // Range of days held in the fast representation, as Julian Day Numbers.
+      static long long const _FAST_MINDAY;
+      static long long const _FAST_MAXDAY;
+      
+      // Milliseconds per day.
+      static int const _MS_PER_DAY;
+      
+      // Default last julian date.
+      static int const _DEFAULT_LASTJULIAN_YEAR ;
+      static int const _DEFAULT_LASTJULIAN_MONTH;
+      static int const _DEFAULT_LASTJULIAN_DAY  ;
+      static int const _DEFAULT_LASTJULIAN_JD   ;
+      
+      /***********************************************************************/
+      // Classes.
+      
+      // Date components of the fast representation.
+      class _FastFields {
+        public:
+          long long Year       ;
+          long long Month      ;
+          long long Day        ;
+          long long Hour       ;
+          long long Minute     ;
+          long long Second     ;
+          long long Millisecond;
+      };
+      
       /***********************************************************************/
       // Data members.
       
-      // This is the time, in Julian Date format, GMT.
-      TimeVal _jd;
+      // This is the time, in Julian Date format, GMT. When the fast
+      // representation is in use this is only loaded on demand.
+      mutable TimeVal _jd     ;
+      mutable bool    _jdvalid;
       
-      // Offset, in fraction of a day, from GMT.
-      TimeVal _offset;
+      // Fast representation, the Julian Day Number of the GMT day and the
+      // milliseconds since its midnight.
+      long long _fastday;
+      long long _fastms ;
+      bool      _fast   ;
+      
+      // Offset, in minutes, from GMT.
+      int _offset;
       
       // Timezone name. Only exists for cosmetic purposes at the moment.
       std::string _tzname;
@@ -516,6 +661,10 @@ namespace DAC {
       mutable TimeVal _cache_millisecond;
       mutable bool    _cache_valid;
       
+      // Cache date components of the fast representation.
+      mutable _FastFields _fastcache      ;
+      mutable bool        _fastcache_valid;
+      
       // List of leap seconds, must always be sorted.
       LSLptr _leapseconds;
       
@@ -523,8 +672,16 @@ namespace DAC {
       YMD     _lastjulianymd;
       TimeVal _lastjulianjd ;
       
-      // Format string for conversion to string.
-      Formatptr _format;
+      // Last julian date for the fast representation, only usable if it is
+      // made of integers.
+      long long _fastlastjulianyear ;
+      long long _fastlastjulianmonth;
+      long long _fastlastjulianday  ;
+      long long _fastlastjulianjd   ;
+      bool      _fastlastjulian     ;
+      
+      // Format for conversion to string.
+      CompiledFormatptr _format;
       
       // Calendar type of this timestamp.
       CalendarType _caltype;
@@ -541,8 +698,12 @@ namespace DAC {
       // Default list of leap seconds, must always be sorted.
       static LSLptr s_defaultleapseconds;
       
-      // Default format string.
-      static Formatptr s_defaultformat;
+      // Default format.
+      static CompiledFormatptr s_defaultformat;
+      
+      // Default last julian date, built once so that clear() only copies it.
+      static ReferencePointer<YMD    > s_defaultlastjulianymd;
+      static ReferencePointer<TimeVal> s_defaultlastjulianjd ;
       
       /***********************************************************************/
       // Constants.
@@ -583,12 +744,95 @@ namespace DAC {
       // Return the leap seconds of a given day.
       TimeVal _leapSecond (TimeVal const& year, TimeVal const& month, TimeVal const& day) const;
       
+      // Get and set the Julian Date.
+      TimeVal const& _getJD  (                  ) const;
+      Timestamp&     _setJD  (TimeVal const& jd )      ;
+      void           _loadJD (                  ) const;
+      
+      // Get the offset in fraction of a day.
+      TimeVal _offsetDays () const;
+      
+      // Get the day number in local time, jdday is in GMT.
+      TimeVal _localDay () const;
+      
+      // Move by a number of milliseconds.
+      void _addMS (long long const ms);
+      
+      // Compare with another timestamp, returns -1, 0, or 1.
+      int _compare (Timestamp const& ts) const;
+      
+      // Convert to and from a string with a compiled format.
+      void _toString   (std::string      & buffer, CompiledFormat const& format) const;
+      void _fromString (std::string const& text  , CompiledFormat const& format)      ;
+      
+      // Get a numeric field of a compiled format through Arb.
+      TimeVal _numericField (char const code) const;
+      
+      // Set from fields in GMT through the fast representation. Returns false
+      // if the time cannot be represented.
+      bool _fastSet (long long const year, long long const month, long long const day, long long const hour, long long const minute, long long const second, long long const millisecond);
+      
+      // Set the fast representation, falls back to Arb if out of range.
+      void _fastSetDay (long long day, long long ms);
+      
+      // Get the local day and millisecond.
+      void _fastLocal (long long& day, long long& ms) const;
+      
+      // Get the local day number.
+      long long _fastLocalDay () const;
+      
+      // Break a day and millisecond down into fields.
+      void _fastGet (_FastFields& fields, long long const day, long long const ms) const;
+      
+      // Load the fast cache.
+      void _fastLoadCache () const;
+      
+      // Fast versions of the calendar calculations.
+      bool         _fastIsLeapYear     (long long const year                                              ) const;
+      CalendarType _fastGetCalendarType (long long const year, long long const month, long long const day) const;
+      long long    _fastDaysInMonth    (long long const year, long long const month                      ) const;
+      long long    _fastDoy            (                                                                  ) const;
+      long long    _fastWoy            (DayOfWeek const base                                              ) const;
+      long long    _fastWoyISO         (                                                                  ) const;
+      long long    _fastISOYear        (                                                                  ) const;
+      
       /***********************************************************************/
       // Static function members.
       
       // Class initialization.
       static void s_classInit ();
       
+      // Convert between days and year, month, day.
+      static long long s_fastDayNumber (long long const year, long long const month, long long const day, bool const gregorian);
+      static void      s_fastCivil     (long long const dayno, bool const gregorian, long long& year, long long& month, long long& day);
+      
+      // Return true if the given date is after a last julian date.
+      static bool s_fastIsGregorian (long long const year, long long const month, long long const day, long long const lastyear, long long const lastmonth, long long const lastday);
+      
+      // Get the day of the week of a day.
+      static long long s_fastDow (long long const dayno);
+      
+      // Get an integer TimeVal, false if it is not one or does not fit.
+      static bool s_fastToLong (TimeVal const& tv, long long& value);
+      
+      // Get a TimeVal in milliseconds, given milliseconds per unit. False if
+      // it is not a whole number of milliseconds or does not fit.
+      static bool s_fastToMS (TimeVal const& tv, long long const unit, long long& ms);
+      
+      // Division and remainder rounding toward negative infinity.
+      static long long s_floorDiv (long long const l, long long const r);
+      static long long s_floorMod (long long const l, long long const r);
+      
+      // Append a number, padded to a width.
+      static void s_appendNumber (std::string& buffer, long long const number, std::string::size_type const width, char const pad);
+      
+      // Read a number or a name from a list.
+      static long long s_parseNumber (std::string const& text, std::string::size_type& pos, std::string::size_type const width, bool const sign);
+      static long long s_parseName   (std::string const& text, std::string::size_type& pos, char const* const* const names, long long const first, long long const last);
+      
+      // Get an interval from fast fields.
+      static Interval s_fastInterval (_FastFields const& fields);
+      
   };
   
   /***************************************************************************
@@ -657,26 +901,10 @@ namespace DAC {
   /*
    * Properties.
    */
-  inline Timestamp& Timestamp::LastJulianDate (YMD const& lastjulian) {
-    Timestamp tmp;
-    tmp = Interval().Year (lastjulian.Year )
-                    .Month(lastjulian.Month)
-                    .Day  (lastjulian.Day  )
-                    .Hour (TimeVal(12)     );
-    _cache_valid   = false;
-    _lastjulianymd = lastjulian;
-    _lastjulianjd  = tmp.Julian().floor();
-    return *this;
-  }
   inline Timestamp::YMD Timestamp::LastJulianDate () const { return _lastjulianymd; }
   
-  inline Timestamp&         Timestamp::Julian (TimeVal const& jd)       { _cache_valid = false; _jd = jd; return *this; }
-  inline Timestamp::TimeVal Timestamp::Julian (                 ) const { return _jd;                                      }
-  
-  inline unsigned int Timestamp::MJD () const { return (_jd - 2400000 + 0.5 + _offset).floor() % 100000; }
-  
-  inline Timestamp&         Timestamp::POSIXDate (TimeVal const& posixdate)       { _cache_valid = false; _jd = posixdate / 86400 + 2440587.5; return *this; }
-  inline Timestamp::TimeVal Timestamp::POSIXDate (                        ) const { return (_jd - 2440587.5) * 86400;                                           }
+  inline Timestamp&         Timestamp::Julian (TimeVal const& jd)       { return _setJD(jd); }
+  inline Timestamp::TimeVal Timestamp::Julian (                 ) const { return _getJD();   }
   
   inline Timestamp::TimeVal Timestamp::Year        () const { if (!_cache_valid) { _loadCache(); } return _cache_year       ; }
   inline Timestamp::TimeVal Timestamp::Month       () const { if (!_cache_valid) { _loadCache(); } return _cache_month      ; }
@@ -686,16 +914,11 @@ namespace DAC {
   inline Timestamp::TimeVal Timestamp::Second      () const { if (!_cache_valid) { _loadCache(); } return _cache_second     ; }
   inline Timestamp::TimeVal Timestamp::Millisecond () const { if (!_cache_valid) { _loadCache(); } return _cache_millisecond; }
   
-  inline int Timestamp::Offset () const { return _offset * 1440; }
+  inline int Timestamp::Offset () const { return _offset; }
   
   inline Timestamp&  Timestamp::TZName (char const* const name)       { _tzname = name; return *this; }
   inline char const* Timestamp::TZName ()                       const { return _tzname.c_str();       }
     
-  /*
-   * Set the timestamp with an interval.
-   */
-  inline Timestamp& Timestamp::set (Interval const& time) { Timestamp newtime(*this); newtime._set(time); _cache_valid = false; _jd = newtime._jd - _offset; return *this; }
-  
   /*
    * Set the timestamp with a Julian Date.
    */
@@ -704,46 +927,38 @@ namespace DAC {
   /*
    * Set the timestamp with an interval, no GMT offset.
    */
-  inline Timestamp& Timestamp::setGMT (Interval const& time) { Timestamp newtime(*this); newtime._set(time); _cache_valid = false; _jd = newtime._jd; return *this; }
-  
-  /*
-   * Get the interval of the timestamp.
-   */
-  inline Timestamp::Interval Timestamp::get () const { return (*this + _offset)._get(); }
+  inline Timestamp& Timestamp::setGMT (Interval const& time) { return _set(time); }
   
   /*
-   * Get the interval of the timestamp, no GMT offset.
+   * Convert to string with internal buffer.
    */
-  inline Timestamp::Interval Timestamp::getGMT () const { return _get(); }
+  inline std::string const& Timestamp::to_string (std::string    const& format) const { return to_string(_strbuf, format); }
+  inline std::string const& Timestamp::to_string (CompiledFormat const& format) const { return to_string(_strbuf, format); }
   
   /*
-   * Convert to string with internal buffer.
+   * Set from a string with a compiled format.
    */
-  inline std::string const& Timestamp::to_string (std::string const& format) const {
-    return to_string(_strbuf, format);
-  }
+  inline Timestamp& Timestamp::parse (std::string const& text, CompiledFormat const& format) { _fromString(text, format); return *this; }
   
   /*
    * Arithmetic.
    */
-  inline Timestamp&         Timestamp::op_add (TimeVal   const& tv)       { _cache_valid = false; _jd += tv; return *this;  }
-  inline Timestamp&         Timestamp::op_sub (TimeVal   const& tv)       { return op_add(-tv);                             }
-  inline Timestamp::TimeVal Timestamp::op_sub (Timestamp const& ts) const { return (_jd + _offset) - (ts._jd + ts._offset); }
+  inline Timestamp& Timestamp::op_sub (TimeVal const& tv) { return op_add(-tv); }
   
   /*
    * Comparison operator backends.
    */
-  inline bool Timestamp::op_gt (Timestamp const& ts) const { return (_jd + _offset) >  (ts._jd + ts._offset); }
-  inline bool Timestamp::op_ge (Timestamp const& ts) const { return (_jd + _offset) >= (ts._jd + ts._offset); }
-  inline bool Timestamp::op_lt (Timestamp const& ts) const { return (_jd + _offset) <  (ts._jd + ts._offset); }
-  inline bool Timestamp::op_le (Timestamp const& ts) const { return (_jd + _offset) <= (ts._jd + ts._offset); }
-  inline bool Timestamp::op_eq (Timestamp const& ts) const { return (_jd + _offset) == (ts._jd + ts._offset); }
-  inline bool Timestamp::op_ne (Timestamp const& ts) const { return (_jd + _offset) != (ts._jd + ts._offset); }
+  inline bool Timestamp::op_gt (Timestamp const& ts) const { return _compare(ts) >  0; }
+  inline bool Timestamp::op_ge (Timestamp const& ts) const { return _compare(ts) >= 0; }
+  inline bool Timestamp::op_lt (Timestamp const& ts) const { return _compare(ts) <  0; }
+  inline bool Timestamp::op_le (Timestamp const& ts) const { return _compare(ts) <= 0; }
+  inline bool Timestamp::op_eq (Timestamp const& ts) const { return _compare(ts) == 0; }
+  inline bool Timestamp::op_ne (Timestamp const& ts) const { return _compare(ts) != 0; }
   
   /*
    * Get the day only JD.
    */
-  inline Timestamp::TimeVal Timestamp::jdday () const { TimeVal retval; retval = (_jd + 0.5).floor(); return retval; }
+  inline Timestamp::TimeVal Timestamp::jdday () const { TimeVal retval; retval = _fast ? TimeVal(_fastday) : (_getJD() + 0.5).floor(); return retval; }
   
   /*
    * Get whether or not this is a leap year.
@@ -789,6 +1004,46 @@ namespace DAC {
   inline Timestamp::CalendarType Timestamp::_getCalendarType (TimeVal const& year, TimeVal const& month, TimeVal const& day) const { return (_caltype == CT_DEFAULT) ? (_isGregorian(year, month, day) ? CT_GREGORIAN : CT_JULIAN) : _caltype; }
   inline Timestamp::CalendarType Timestamp::_getCalendarType (TimeVal const& jd                                            ) const { return (_caltype == CT_DEFAULT) ? (_isGregorian(jd)               ? CT_GREGORIAN : CT_JULIAN) : _caltype; }
   
+  /*
+   * Get the Julian Date, loading it from the fast representation if needed.
+   */
+  inline Timestamp::TimeVal const& Timestamp::_getJD () const { if (!_jdvalid) { _loadJD(); } return _jd; }
+  
+  /*
+   * Get the offset in fraction of a day.
+   */
+  inline Timestamp::TimeVal Timestamp::_offsetDays () const { return TimeVal(_offset) / 1440; }
+  
+  /*
+   * Get the day number in local time.
+   */
+  inline Timestamp::TimeVal Timestamp::_localDay () const { return (_getJD() + _offsetDays() + 0.5).floor(); }
+  
+  /*
+   * Fast calendar type, same rules as _getCalendarType.
+   */
+  inline Timestamp::CalendarType Timestamp::_fastGetCalendarType (long long const year, long long const month, long long const day) const {
+    return (_caltype == CT_DEFAULT) ? (s_fastIsGregorian(year, month, day, _fastlastjulianyear, _fastlastjulianmonth, _fastlastjulianday) ? CT_GREGORIAN : CT_JULIAN) : _caltype;
+  }
+  
+  /*
+   * Get the day of the week, 0 = Sunday.
+   */
+  inline long long Timestamp::s_fastDow (long long const dayno) { return s_floorMod(dayno + 1, 7); }
+  
+  /*
+   * Division and remainder rounding toward negative infinity.
+   */
+  inline long long Timestamp::s_floorDiv (long long const l, long long const r) { return (l >= 0) ? l / r : -((r - 1 - l) / r); }
+  inline long long Timestamp::s_floorMod (long long const l, long long const r) { return l - s_floorDiv(l, r) * r;            }
+  
+  /*
+   * Return true if the given date is after a last julian date.
+   */
+  inline bool Timestamp::s_fastIsGregorian (long long const year, long long const month, long long const day, long long const lastyear, long long const lastmonth, long long const lastday) {
+    return year > lastyear || (year == lastyear && (month > lastmonth || (month == lastmonth && day > lastday)));
+  }
+  
   /***************************************************************************
    * Class Timestamp::Interval.
    ***************************************************************************/
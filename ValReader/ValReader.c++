@@ -6,6 +6,7 @@
 
 // Standard includes.
 #include <string>
+#include <cctype>
 
 // System includes.
 #include <CaseConvert.h++>
@@ -24,12 +25,6 @@ namespace DAC {
    * ValReader
    ***************************************************************************/
   
-  /***************************************************************************/
-  // Constants.
-  
-  // Empty string.
-  string const ValReader::_BLANK;
-  
   /***************************************************************************/
   // Function members.
   
@@ -43,22 +38,20 @@ namespace DAC {
       return false;
     }
     
-    // Work area.
-    string work(_value);
-    uppercase(work);
-    
     // Check for negative text.
-    if (work == "F" || work == "N" || work == "FALSE" || work == "NO" || work == "OFF") {
+    if (_is("F") || _is("N") || _is("FALSE") || _is("NO") || _is("OFF")) {
       return false;
     }
     
     // Check for positive text.
-    if (work == "T" || work == "Y" || work == "TRUE" || work == "YES" || work == "ON") {
+    if (_is("T") || _is("Y") || _is("TRUE") || _is("YES") || _is("ON")) {
       return true;
     }
     
     // Check for numeric 0. If text can't be converted to a number, any text
     // is true.
+    string work;
+    uppercase(_value.to_string(work));
     try {
       return Arb(work);
     } catch (Arb::Errors::Base&) {
@@ -67,5 +60,43 @@ namespace DAC {
     
   }
   
+  /*
+   * Read a plain decimal number, one that UArbInt would not take as another
+   * base and that fits in an unsigned long long.
+   */
+  bool ValReader::_decimal (unsigned long long& number) const {
+    
+    // Leading zeros are octal, and 19 digits always fit.
+    if (_value.empty() || _value.size() > 19 || (_value[0] == '0' && _value.size() > 1)) {
+      return false;
+    }
+    
+    // Accumulate the digits.
+    number = 0;
+    for (StringView::const_iterator i = _value.begin(); i != _value.end(); ++i) {
+      if (*i < '0' || *i > '9') {
+        return false;
+      }
+      number = number * 10 + (*i - '0');
+    }
+    
+    // We done.
+    return true;
+    
+  }
+  
+  /*
+   * Compare, ignoring case, with an uppercase word.
+   */
+  bool ValReader::_is (char const* const word) const {
+    StringView::size_type i = 0;
+    for (; i != _value.size() && word[i]; ++i) {
+      if (toupper(static_cast<unsigned char>(_value[i])) != word[i]) {
+        return false;
+      }
+    }
+    return i == _value.size() && !word[i];
+  }
+  
 }
 
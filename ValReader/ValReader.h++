@@ -13,9 +13,11 @@
 
 // System includes.
   #include <demangle.h++>
+  #include <ReferencePointer.h++>
   #include <ArbInt.h++>
   #include <Arb.h++>
   #include <Exception.h++>
+  #include <StringView.h++>
 
 // Namespace wrapper.
 namespace DAC {
@@ -23,7 +25,9 @@ namespace DAC {
   /***************************************************************************
    * ValReader
    ***************************************************************************
-   * This is the class.
+   * A reader either owns a copy of its value or refers to text held by a
+   * reference-counted owner, which it keeps alive. Copies may be read from
+   * different threads, one reader may not.
    ***************************************************************************/
   class ValReader {
     
@@ -69,13 +73,26 @@ namespace DAC {
       /***********************************************************************/
       // Function members.
       
-      // Constructor.
-      ValReader (std::string const& value = _BLANK);
+      // Constructors. Copy the value.
+      ValReader (std::string const& value = std::string());
+      ValReader (char const* const value);
+      explicit ValReader (StringView const& value);
+      
+      // Refers to the value without copying it. The value must be held by
+      // owner, which lives at least as long as the reader.
+      ValReader (StringView const& value, ConstReferencePointer<ReferenceCounted> const& owner);
+      
+      // Copy constructor and assignment operator.
+      ValReader            (ValReader const& reader);
+      ValReader& operator = (ValReader const& reader);
       
       // Get value as a string. Returns unmodified value.
       std::string      & to_string (std::string& buffer) const;
       std::string const& to_string (                   ) const;
       
+      // Get value without copying.
+      StringView const& view () const;
+      
       // Get value as a boolean.
       bool to_boolean () const;
       
@@ -91,16 +108,26 @@ namespace DAC {
     private:
       
       /***********************************************************************/
-      // Constants.
+      // Data members.
+      
+      // Our copy of the value. When it is held elsewhere, a copy only made
+      // if asked for as a string.
+      mutable std::string _string;
       
-      // Blank string, for default constructor.
-      static std::string const _BLANK;
+      // The value we are converting.
+      StringView _value;
+      
+      // What holds the value, null if we hold it.
+      ConstReferencePointer<ReferenceCounted> _owner;
       
       /***********************************************************************/
-      // Data members.
+      // Function members.
+      
+      // Read a plain decimal number without going through a string.
+      bool _decimal (unsigned long long& number) const;
       
-      // Reference to the value we are converting.
-      std::string const& _value;
+      // Compare, ignoring case, with an uppercase word.
+      bool _is (char const* const word) const;
     
   };
   
@@ -116,15 +143,39 @@ namespace DAC {
   // Function members.
   
   /*
-   * Constructor.
+   * Constructors.
    */
-  inline ValReader::ValReader (std::string const& value) : _value(value) {}
+  inline ValReader::ValReader (std::string const& value) : _string(value          ), _value(_string) {}
+  inline ValReader::ValReader (char const* const  value) : _string(value          ), _value(_string) {}
+  inline ValReader::ValReader (StringView  const& value) : _string(value.to_string()), _value(_string) {}
+  inline ValReader::ValReader (StringView const& value, ConstReferencePointer<ReferenceCounted> const& owner) : _value(value), _owner(owner) {}
+  
+  /*
+   * Copy constructor.
+   */
+  inline ValReader::ValReader (ValReader const& reader) : _string(reader._string), _value(reader._owner.isNull() ? StringView(_string) : reader._value), _owner(reader._owner) {}
+  
+  /*
+   * Assignment operator.
+   */
+  inline ValReader& ValReader::operator = (ValReader const& reader) {
+    _string = reader._string;
+    _owner  = reader._owner;
+    _value  = _owner.isNull() ? StringView(_string) : reader._value;
+    return *this;
+  }
   
   /*
    * Get unmodified value.
    */
-  inline std::string      & ValReader::to_string (std::string& buffer) const { buffer = _value; return buffer; }
-  inline std::string const& ValReader::to_string (                   ) const {                  return _value; }
+  inline std::string& ValReader::to_string (std::string& buffer) const { return _value.to_string(buffer); }
+  inline std::string const& ValReader::to_string () const {
+    if (_owner.isNull()) {
+      return _string;
+    }
+    return _value.to_string(_string);
+  }
+  inline StringView  const& ValReader::view      (                   ) const { return _value;                    }
   
   /*
    * Get value as an integer.
@@ -136,9 +187,14 @@ namespace DAC {
     
     // Wrap in try blocks to catch any failure of conversion and throw an
     // an error that hides implementation details. Rely on UArbInt to do the
-    // conversion.
+    // conversion, but skip the string copy for plain decimal numbers.
     try {
-      retval = UArbInt(_value);
+      unsigned long long number = 0;
+      if (_decimal(number)) {
+        retval = UArbInt(number).Value<T>();
+      } else {
+        retval = UArbInt(_value.to_string()).Value<T>();
+      }
     } catch (UArbInt::Errors::Base& e) {
       throw Errors::BadNum().set_ErrText(e.what());
     }
@@ -158,7 +214,7 @@ namespace DAC {
     
     // Blah blah, read the function above.
     try {
-      retval = Arb(_value);
+      retval = Arb(_value.to_string());
     } catch (Arb::Errors::Base& e) {
       throw Errors::BadNum().set_ErrText(e.what());
     }
@@ -1,7 +1,8 @@
 /*****************************************************************************
  * baseConvert.h++
  *****************************************************************************
- * Convert a number to another base.
+ * Convert a number to another base. Converting a based number to another
+ * base goes through UArbInt, so anything using that must link ArbInt.
  *****************************************************************************/
 
 // Include guard.
@@ -16,8 +17,8 @@
 // Internal includes.
 #include "Exception.h++"
 #include "to_string.h++"
-#include "longDiv.h++"
 #include "rppower.h++"
+#include "ArbInt.h++"
 
 // Contain in namespace.
 namespace DAC {
@@ -163,26 +164,24 @@ namespace DAC {
 			throw BaseConvert::Errors::MaxBaseTo();
 		}
 		if (tobase < 2) {
-			throw BaseConvert::Errors::MaxBaseFrom();
+			throw BaseConvert::Errors::MinBaseTo();
 		}
 		
 		// Work area.
-		T retval      ;
-		T work  (from);
+		T retval;
 		
-		// Convert base by storing the remainder of repeated division by the base
-		// that we will be converting to. Least significant digits come out first.
+		// Convert through UArbInt, which splits by cached powers of the base
+		// rather than dividing out one digit at a time. Least significant
+		// digits come first on both sides.
 		try {
-			while (work.size() > 0 && work[0] != 0) {
-				retval.push_back(londiv(work, work, tobase, frombase));
-			}
-		} catch (LongDiv::Errors::DigitOverflow& e) {
-			throw BaseConvert::Errors::DigitOverflow().Digit(e.Digit());
+			UArbInt().setDigits(from, frombase).getDigits(retval, tobase);
+		} catch (UArbInt::Errors::BadFormat& e) {
+			throw BaseConvert::Errors::DigitOverflow().Digit(e.Position());
 		}
 		
 		// Done.
 		to.swap(retval);
-		return retval;
+		return to;
 		
 	}
 	
@@ -0,0 +1,286 @@
+/*****************************************************************************
+ * bench.c++
+ *****************************************************************************
+ * Microbenchmarks for the arbitrary-precision, date and config classes.
+ * Results are written as JSON so they can be tracked from run to run.
+ *****************************************************************************/
+
+// Standard includes.
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+// Internal includes.
+#include "OpCounters.h++"
+#include "ArbInt.h++"
+#include "Arb.h++"
+#include "gcd.h++"
+#include "baseConvert.h++"
+#include "rppower.h++"
+#include "Timestamp.h++"
+#include "INIFile.h++"
+#include "testcommon.h++"
+
+// Bring in namespaces.
+using namespace std;
+using namespace DAC;
+
+/*****************************************************************************/
+// Types.
+
+/*
+ * The result of one benchmark at one size.
+ */
+class Result {
+  public:
+    string             Name      ;
+    size_t             Size      ;
+    unsigned long long Iterations;
+    double             NsPerOp   ;
+    double             PerOp[OpCounters::NUM_COUNTERS];
+};
+
+/*
+ * Runs benchmarks and collects their results.
+ */
+class Bench {
+
+  public:
+
+    // Run each benchmark for at least mintime seconds, and only those whose
+    // name contains filter.
+    Bench (double const mintime, string const& filter);
+
+    // Time a benchmark. func does one operation and returns something
+    // derived from its result, so that the work cannot be optimized away.
+    template <class FuncT> void run (string const& name, size_t const size, FuncT func);
+
+    // Write the results.
+    void write (ostream& out) const;
+
+  private:
+
+    double         _mintime;
+    string         _filter ;
+    vector<Result> _results;
+
+};
+
+/*****************************************************************************/
+// Function declarations.
+
+// A random number with a given count of decimal digits.
+string random_digits (unsigned int& seed, size_t const digits);
+
+// Program entry.
+int main (int argc, char** argv);
+
+/*****************************************************************************/
+// Global variables.
+
+// Results of benchmarked operations end up here.
+volatile size_t g_sink = 0;
+
+/*****************************************************************************
+ * Definitions.
+ *****************************************************************************/
+
+/*
+ * Constructor.
+ */
+Bench::Bench (double const mintime, string const& filter) : _mintime(mintime), _filter(filter) {}
+
+/*
+ * Time a benchmark.
+ */
+template <class FuncT> void Bench::run (string const& name, size_t const size, FuncT func) {
+
+  // Skip anything not asked for.
+  if (name.find(_filter) == string::npos) {
+    return;
+  }
+  cerr << name << " " << size << "... ";
+  cerr.flush();
+
+  // Warm up, filling caches and the scratch arena.
+  g_sink = g_sink + func();
+
+  // Double the iterations until a run takes long enough to time.
+  Result             result    ;
+  unsigned long long iterations = 1;
+  double             elapsed    = 0;
+  for (;;) {
+    OpCounters::reset();
+    chrono::steady_clock::time_point const start = chrono::steady_clock::now();
+    for (unsigned long long i = 0; i != iterations; ++i) {
+      g_sink = g_sink + func();
+    }
+    elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (elapsed >= _mintime) {
+      break;
+    }
+    iterations <<= 1;
+  }
+
+  // Record.
+  result.Name       = name;
+  result.Size       = size;
+  result.Iterations = iterations;
+  result.NsPerOp    = elapsed * 1e9 / iterations;
+  for (int i = 0; i != OpCounters::NUM_COUNTERS; ++i) {
+    result.PerOp[i] = static_cast<double>(OpCounters::get(static_cast<OpCounters::Counter>(i))) / iterations;
+  }
+  _results.push_back(result);
+  cerr << result.NsPerOp << " ns" << endl;
+
+}
+
+/*
+ * Write the results.
+ */
+void Bench::write (ostream& out) const {
+  out << "{\n";
+  out << "  \"build_type\": \"" << BENCH_BUILD_TYPE << "\",\n";
+  out << "  \"counters\": " << (OpCounters::enabled ? "true" : "false") << ",\n";
+  out << "  \"results\": [";
+  for (vector<Result>::const_iterator i = _results.begin(); i != _results.end(); ++i) {
+    out << (i == _results.begin() ? "\n" : ",\n");
+    out << "    {\"name\": \"" << i->Name << "\", \"size\": " << i->Size << ", \"iterations\": " << i->Iterations << ", \"ns_per_op\": " << i->NsPerOp;
+    if (OpCounters::enabled) {
+      for (int j = 0; j != OpCounters::NUM_COUNTERS; ++j) {
+        out << ", \"" << OpCounters::name(static_cast<OpCounters::Counter>(j)) << "\": " << i->PerOp[j];
+      }
+    }
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+/*
+ * A random number with a given count of decimal digits.
+ */
+string random_digits (unsigned int& seed, size_t const digits) {
+  string retval(1, static_cast<char>('1' + next_random(seed) % 9));
+  while (retval.size() < digits) {
+    retval += static_cast<char>('0' + next_random(seed) % 10);
+  }
+  return retval;
+}
+
+/*
+ * Program entry.
+ */
+int main (int argc, char** argv) {
+
+  // Options.
+  bool   quick = false;
+  string filter     ;
+  string outname    ;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--quick")) {
+      quick = true;
+    } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+      outname = argv[++i];
+    } else {
+      cerr << "Usage: " << argv[0] << " [--quick] [--filter name] [--out file.json]" << endl;
+      return 1;
+    }
+  }
+
+  // Quick runs are a smoke test, one pass of each benchmark at small sizes.
+  Bench                bench(quick ? 0 : 0.2, filter);
+  vector<size_t> const sizes(quick ? vector<size_t>{ 10, 100 } : vector<size_t>{ 10, 100, 1000, 10000 });
+  unsigned int         seed = 1;
+
+  // Integers, operands of size decimal digits.
+  for (vector<size_t>::const_iterator size = sizes.begin(); size != sizes.end(); ++size) {
+    UArbInt const a(random_digits(seed, *size));
+    UArbInt const b(random_digits(seed, *size));
+    UArbInt const c(random_digits(seed, *size));
+    UArbInt const wide(a * b + c);
+    UArbInt const ac(a * c);
+    UArbInt const bc(b * c);
+    bench.run("uarbint_mul"      , *size, [&] () { return (a * b).numDigits(); });
+    bench.run("uarbint_div"      , *size, [&] () { return (wide / b).numDigits(); });
+    bench.run("uarbint_to_string", *size, [&] () { return a.to_string().size(); });
+    bench.run("gcd"              , *size, [&] () { return gcd(ac, bc).numDigits(); });
+  }
+
+  // Fractions, numerator and denominator of size decimal digits each.
+  for (vector<size_t>::const_iterator size = sizes.begin(); size != sizes.end(); ++size) {
+    Arb const x(Arb(random_digits(seed, *size)) / Arb(random_digits(seed, *size)));
+    Arb const y(Arb(random_digits(seed, *size)) / Arb(random_digits(seed, *size)));
+    bench.run("arb_add", *size, [&] () { return (x + y).isInteger() ? 1 : 0; });
+    bench.run("arb_mul", *size, [&] () { return (x * y).isInteger() ? 1 : 0; });
+  }
+
+  // Powers and roots grow quickly, so these are capped lower.
+  for (vector<size_t>::const_iterator size = sizes.begin(); size != sizes.end() && *size <= 1000; ++size) {
+    Arb const x(Arb(random_digits(seed, *size)) / Arb(random_digits(seed, *size)));
+    Arb const n(random_digits(seed, *size));
+    bench.run("arb_pow" , *size, [&] () { return x.pow(5).isInteger() ? 1 : 0; });
+    bench.run("arb_root", *size, [&] () { return n.root(3).isInteger() ? 1 : 0; });
+  }
+
+  // Base conversion of size decimal digits to hexadecimal.
+  for (vector<size_t>::const_iterator size = sizes.begin(); size != sizes.end(); ++size) {
+    vector<unsigned int> from;
+    for (size_t i = 0; i != *size; ++i) {
+      from.push_back(next_random(seed) % 10);
+    }
+    bench.run("baseConvert", *size, [&] () { vector<unsigned int> to; return baseConvert(from, 10U, to, 16U).size(); });
+  }
+
+  // Native powers, size is the exponent.
+  for (unsigned int exponent = 5; exponent <= 40; exponent <<= 1) {
+    bench.run("rppower", exponent, [&] () { return static_cast<size_t>(rppower(3ULL, exponent)); });
+  }
+
+  // Dates, setting from calendar fields and formatting batches of size.
+  Timestamp::Interval const fields(Timestamp::Interval().Year(Timestamp::TimeVal(2024)).Month(Timestamp::TimeVal(2)).Day(Timestamp::TimeVal(29)).Hour(Timestamp::TimeVal(13)).Minute(Timestamp::TimeVal(37)));
+  bench.run("timestamp_set", 1, [&] () { Timestamp ts; ts.set(fields); return static_cast<size_t>(ts.Millisecond()); });
+  for (vector<size_t>::const_iterator size = sizes.begin(); size != sizes.end() && *size <= 1000; ++size) {
+    vector<Timestamp> timestamps;
+    for (size_t i = 0; i != *size; ++i) {
+      Timestamp ts;
+      ts.POSIXDate(Timestamp::TimeVal(static_cast<int>(next_random(seed) % 2000000000)));
+      timestamps.push_back(ts);
+    }
+    Timestamp::CompiledFormat const format("%F %T %z");
+    bench.run("timestamp_format", *size, [&] () { vector<string> strings; return Timestamp::to_string(strings, timestamps, format).size(); });
+  }
+
+  // Config files of size sections of 20 keys each.
+  string const ininame("bench.ini");
+  for (vector<size_t>::const_iterator size = sizes.begin(); size != sizes.end() && *size <= 1000; ++size) {
+    {
+      ofstream file(ininame.c_str(), ios::binary);
+      for (size_t section = 0; section != *size; ++section) {
+        file << "[section" << section << "]\n";
+        for (int key = 0; key != 20; ++key) {
+          file << "key" << key << " = " << next_random(seed) << "\n";
+        }
+      }
+    }
+    bench.run("inifile_parse", *size, [&] () { INIFile ini(ininame); ini.read(); return ini.get_sections()->size(); });
+  }
+  remove(ininame.c_str());
+
+  // Write results.
+  if (outname.empty()) {
+    bench.write(cout);
+  } else {
+    ofstream out(outname.c_str());
+    bench.write(out);
+  }
+
+  return 0;
+
+}
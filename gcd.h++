@@ -13,12 +13,19 @@
 // Contain in namespace.
 namespace DAC {
 	
+	/***************************************************************************/
+	// Forward declarations.
+	class UArbInt;
+	
 	/***************************************************************************/
 	// Functions.
 	
 	// Find the greatest common divisor of two numbers.
 	template <class T> T gcd (T const& n1, T const& n2);
 	
+	// Lehmer's algorithm for arbitrary integers, defined with UArbInt.
+	template <> UArbInt gcd<UArbInt> (UArbInt const& n1, UArbInt const& n2);
+	
 	/***************************************************************************
 	 * Inline and template definitions.
 	 ***************************************************************************/
@@ -8,6 +8,9 @@
 #include <string>
 #include <vector>
 
+// System includes.
+#include <StringView.h++>
+
 // Function include.
 #include "tokenize.h++"
 
@@ -51,5 +54,24 @@ namespace DAC {
     
   }
   
+  /*
+  * Tokenize without copying.
+  */
+  void tokenize (StringView const& strtotok, vector<StringView>& retval, StringView const& delim) {
+    
+    // Reuse the caller's storage, this is called on hot paths.
+    retval.clear();
+    
+    // Same as above, only the tokens are views.
+    StringView::size_type spos = 0;
+    StringView::size_type epos = 0;
+    for (; epos != StringView::npos; ) {
+      epos = strtotok.find_first_of(delim, spos);
+      retval.push_back(strtotok.substr(spos, epos - spos));
+      spos = epos + 1;
+    }
+    
+  }
+  
 }
 
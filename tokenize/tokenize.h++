@@ -12,6 +12,9 @@
   #include <string>
   #include <vector>
 
+// System includes.
+  #include <StringView.h++>
+  
 // Namespace wrapper.
 namespace DAC {
   
@@ -21,6 +24,9 @@ namespace DAC {
   // Tokenize a string.
   void tokenize (std::string const& strtotok, std::vector<std::string>& retval, std::string const& delim = " \t\n");
   
+  // Tokenize without copying, tokens are views into strtotok.
+  void tokenize (StringView const& strtotok, std::vector<StringView>& retval, StringView const& delim = " \t\n");
+  
 }
 
 // End include guard.
@@ -7,6 +7,9 @@
 // Standard includes.
 #include <string>
 
+// System includes.
+#include <StringView.h++>
+
 // Module includes.
 #include "trim.h++"
 
@@ -80,5 +83,29 @@ namespace DAC {
     
   }
   
+  /*
+   * Trim whitespace from the beginning of a view.
+   */
+  StringView& ltrim (StringView& text, StringView const& whitespace) {
+    
+    // Find first non-whitespace character, none means an empty view.
+    StringView::size_type const nowsbegin(text.find_first_not_of(whitespace));
+    text = (nowsbegin == StringView::npos) ? text.substr(text.size()) : text.substr(nowsbegin);
+    return text;
+    
+  }
+  
+  /*
+   * Trim whitespace from the end of a view.
+   */
+  StringView& rtrim (StringView& text, StringView const& whitespace) {
+
+    // Find last non-whitespace character, none means an empty view.
+    StringView::size_type const nowsend(text.find_last_not_of(whitespace));
+    text = text.substr(0, (nowsend == StringView::npos) ? 0 : nowsend + 1);
+    return text;
+    
+  }
+  
 }
 
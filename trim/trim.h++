@@ -11,6 +11,9 @@
 // Standard includes.
   #include <string>
 
+// System includes.
+  #include <StringView.h++>
+  
 // Namespace wrapper.
 namespace DAC {
   
@@ -22,6 +25,11 @@ namespace DAC {
   std::string& rtrim (std::string& text, std::string const& whitespace = " \t\n");
   std::string& trim  (std::string& text, std::string const& whitespace = " \t\n");
   
+  // Trim whitespace from a view, without copying.
+  StringView& ltrim (StringView& text, StringView const& whitespace = " \t\n");
+  StringView& rtrim (StringView& text, StringView const& whitespace = " \t\n");
+  StringView& trim  (StringView& text, StringView const& whitespace = " \t\n");
+  
   /***************************************************************************
    * Inline and template definitions.
    ***************************************************************************/
@@ -37,6 +45,11 @@ namespace DAC {
     ltrim(text, whitespace);
     return text;
   }
+  inline StringView& trim (StringView& text, StringView const& whitespace) {
+    rtrim(text, whitespace);
+    ltrim(text, whitespace);
+    return text;
+  }
   
 }
 